@@ -52,6 +52,7 @@ BlockFix_BlockFixAPI::BlockFix_BlockFixAPI()
 {
   myTolerance = Precision::Confusion();
   myOptimumNbFaces = 6;
+  myRunParallel = Standard_False;
 }
 
 //=======================================================================
@@ -95,6 +96,7 @@ void BlockFix_BlockFixAPI::Perform()
   BlockFix_UnionFaces aFaceUnifier;
   aFaceUnifier.GetTolerance() = myTolerance;
   aFaceUnifier.GetOptimumNbFaces() = myOptimumNbFaces;
+  aFaceUnifier.GetRunParallel() = myRunParallel;
   aResult = aFaceUnifier.Perform(aResult);
 #else
   if (myOptimumNbFaces > 1) {
@@ -102,6 +104,7 @@ void BlockFix_BlockFixAPI::Perform()
     BlockFix_UnionFaces aFaceUnifier;
     aFaceUnifier.GetTolerance() = myTolerance;
     aFaceUnifier.GetOptimumNbFaces() = myOptimumNbFaces;
+    aFaceUnifier.GetRunParallel() = myRunParallel;
     aResult = aFaceUnifier.Perform(aResult);
   }
   else if (myOptimumNbFaces != -1) {
@@ -44,6 +44,7 @@ public:
   Handle(ShapeBuild_ReShape)& Context();
   Standard_Real& Tolerance();
   Standard_Integer& OptimumNbFaces();
+  Standard_Boolean& RunParallel();
   Standard_EXPORT void Perform();
 
   DEFINE_STANDARD_RTTIEXT(BlockFix_BlockFixAPI, Standard_Transient)
@@ -53,6 +54,7 @@ private:
   TopoDS_Shape myShape;
   Standard_Real myTolerance;
   Standard_Integer myOptimumNbFaces;
+  Standard_Boolean myRunParallel;
 };
 
 //=======================================================================
@@ -100,4 +102,13 @@ inline Standard_Integer& BlockFix_BlockFixAPI::OptimumNbFaces()
   return myOptimumNbFaces;
 }
 
+//=======================================================================
+//function : RunParallel
+//purpose  :
+//=======================================================================
+inline Standard_Boolean& BlockFix_BlockFixAPI::RunParallel()
+{
+  return myRunParallel;
+}
+
 #endif
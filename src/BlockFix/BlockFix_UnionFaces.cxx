@@ -60,6 +60,11 @@
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 #include <TopTools_MapOfShape.hxx>
 #include <TopTools_MapIteratorOfMapOfShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <TColStd_DataMapOfIntegerInteger.hxx>
+#include <NCollection_Vector.hxx>
+#include <OSD_Parallel.hxx>
 
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
@@ -116,7 +121,8 @@
 //=======================================================================
 BlockFix_UnionFaces::BlockFix_UnionFaces()
   : myTolerance(Precision::Confusion()),
-    myOptimumNbFaces(6)
+    myOptimumNbFaces(6),
+    myRunParallel(Standard_False)
 {
 }
 
@@ -138,6 +144,15 @@ Standard_Integer& BlockFix_UnionFaces::GetOptimumNbFaces()
   return myOptimumNbFaces;
 }
 
+//=======================================================================
+//function : GetRunParallel
+//purpose  :
+//=======================================================================
+Standard_Boolean& BlockFix_UnionFaces::GetRunParallel()
+{
+  return myRunParallel;
+}
+
 //=======================================================================
 //function : AddOrdinaryEdges
 //purpose  : auxiliary
@@ -434,6 +449,112 @@ static Standard_Boolean IsEdgeValidToMerge(const TopoDS_Edge& theEdge,
   return isValid;
 }
 
+//=======================================================================
+//class    : BlockFix_SameDomainCache
+//purpose  : results of IsSameDomain() for the pairs of faces,
+//           computed in parallel before the faces are merged
+//=======================================================================
+class BlockFix_SameDomainCache
+{
+public:
+  struct FacePair
+  {
+    TopoDS_Face Face1;
+    TopoDS_Face Face2;
+    Standard_Boolean IsSame;
+  };
+
+  //! Registers the pair (theFace1, theFace2), the order matters
+  void Add(const TopoDS_Face& theFace1, const TopoDS_Face& theFace2)
+  {
+    const Standard_Integer i1 = myFaces.Add(theFace1);
+    const Standard_Integer i2 = myFaces.Add(theFace2);
+    while (myPairIndices.Length() < myFaces.Extent()) {
+      myPairIndices.Appended();
+    }
+    TColStd_DataMapOfIntegerInteger& aMap = myPairIndices.ChangeValue(i1 - 1);
+    if (!aMap.IsBound(i2)) {
+      aMap.Bind(i2, myPairs.Length());
+      FacePair& aPair = myPairs.Appended();
+      aPair.Face1 = theFace1;
+      aPair.Face2 = theFace2;
+      aPair.IsSame = Standard_False;
+    }
+  }
+
+  //! Computes IsSameDomain() for all registered pairs
+  void Perform(const BlockFix_UnionFaces& theUnifier,
+               const Standard_Boolean theRunParallel)
+  {
+    Functor aFunctor(theUnifier, myPairs);
+    OSD_Parallel::For(0, myPairs.Length(), aFunctor, !theRunParallel);
+  }
+
+  //! Returns false if the pair has not been registered
+  Standard_Boolean Find(const TopoDS_Face& theFace1,
+                        const TopoDS_Face& theFace2,
+                        Standard_Boolean& theIsSame) const
+  {
+    const Standard_Integer i1 = myFaces.FindIndex(theFace1);
+    const Standard_Integer i2 = myFaces.FindIndex(theFace2);
+    if (!i1 || !i2) {
+      return Standard_False;
+    }
+    const TColStd_DataMapOfIntegerInteger& aMap = myPairIndices(i1 - 1);
+    if (!aMap.IsBound(i2)) {
+      return Standard_False;
+    }
+    theIsSame = myPairs(aMap.Find(i2)).IsSame;
+    return Standard_True;
+  }
+
+private:
+  class Functor
+  {
+  public:
+    Functor(const BlockFix_UnionFaces& theUnifier,
+            NCollection_Vector<FacePair>& thePairs)
+    : myUnifier(theUnifier),
+      myPairs(thePairs)
+    {
+    }
+
+    void operator()(const Standard_Integer theIndex) const
+    {
+      FacePair& aPair = myPairs.ChangeValue(theIndex);
+      aPair.IsSame = myUnifier.IsSameDomain(aPair.Face1, aPair.Face2);
+    }
+
+  private:
+    const BlockFix_UnionFaces& myUnifier;
+    NCollection_Vector<FacePair>& myPairs;
+  };
+
+  TopTools_IndexedMapOfShape myFaces;
+  NCollection_Vector<TColStd_DataMapOfIntegerInteger> myPairIndices;
+  NCollection_Vector<FacePair> myPairs;
+};
+
+//=======================================================================
+//function : IsToUnion
+//purpose  : decides if the faces of the solid or shell should be merged
+//=======================================================================
+static Standard_Boolean IsToUnion(const TopoDS_Shape& theSoOrSh,
+                                  const Standard_Integer theOptimumNbFaces)
+{
+  // count faces
+  int nbf = 0;
+  TopExp_Explorer exp;
+  TopTools_MapOfShape mapF;
+  for (exp.Init(theSoOrSh, TopAbs_FACE); exp.More(); exp.Next()) {
+    if (mapF.Add(exp.Current()))
+      nbf++;
+  }
+
+  return ((theOptimumNbFaces == 0) ||
+          ((theOptimumNbFaces > 0) && (nbf > theOptimumNbFaces)));
+}
+
 //=======================================================================
 //function : Perform
 //purpose  :
@@ -452,10 +573,44 @@ TopoDS_Shape BlockFix_UnionFaces::Perform(const TopoDS_Shape& Shape)
   TopExp::MapShapesAndAncestors
     (Shape, TopAbs_FACE, aType, aMapFaceSoOrSh);
 
+  // The faces are merged sequentially, as the merging updates the
+  // edges shared by the solids. In parallel mode the same domain
+  // tests of the faces adjacent through a manifold edge are done
+  // before, for all solids at once.
+  BlockFix_SameDomainCache aSameDomainCache;
+  TopExp_Explorer exps;
+  if (myRunParallel) {
+    for (exps.Init(Shape, aType); exps.More(); exps.Next()) {
+      const TopoDS_Shape& aSoOrSh = exps.Current();
+      if (!IsToUnion(aSoOrSh, myOptimumNbFaces))
+        continue;
+
+      TopTools_IndexedDataMapOfShapeListOfShape aMapEdgeFaces;
+      TopExp::MapShapesAndAncestors(aSoOrSh, TopAbs_EDGE, TopAbs_FACE, aMapEdgeFaces);
+
+      Standard_Integer i, aNbE = aMapEdgeFaces.Extent();
+      for (i = 1; i <= aNbE; i++) {
+        const TopTools_ListOfShape& aList = aMapEdgeFaces(i);
+        if (aList.Extent() != 2 ||
+            BRep_Tool::Degenerated(TopoDS::Edge(aMapEdgeFaces.FindKey(i))))
+          continue;
+
+        TopoDS_Face aFace1 = TopoDS::Face(aList.First().Oriented(TopAbs_FORWARD));
+        TopoDS_Face aFace2 = TopoDS::Face(aList.Last().Oriented(TopAbs_FORWARD));
+        if (aFace1.IsSame(aFace2) ||
+            !IsFacesOfSameSolids(aFace1, aFace2, aMapFaceSoOrSh))
+          continue;
+
+        aSameDomainCache.Add(aFace1, aFace2);
+        aSameDomainCache.Add(aFace2, aFace1);
+      }
+    }
+    aSameDomainCache.Perform(*this, myRunParallel);
+  }
+
   // processing each solid
   Handle(ShapeBuild_ReShape) aContext = new ShapeBuild_ReShape;
   TopTools_MapOfShape aProcessed;
-  TopExp_Explorer exps;
   for (exps.Init(Shape, aType); exps.More(); exps.Next()) {
     TopoDS_Shape aSoOrSh = exps.Current();
 
@@ -467,20 +622,10 @@ TopoDS_Shape BlockFix_UnionFaces::Perform(const TopoDS_Shape& Shape)
     Standard_Boolean hasFailed = Standard_False;
     Standard_Real tol = Min(Max(Precision::Confusion(), myTolerance/10.), 0.1);
 
-    // count faces
-    int nbf = 0;
     TopExp_Explorer exp;
-    TopTools_MapOfShape mapF;
-    for (exp.Init(aSoOrSh, TopAbs_FACE); exp.More(); exp.Next()) {
-      if (mapF.Add(exp.Current()))
-        nbf++;
-    }
-
-    bool doUnion = ((myOptimumNbFaces == 0) ||
-                    ((myOptimumNbFaces > 0) && (nbf > myOptimumNbFaces)));
+    bool doUnion = IsToUnion(aSoOrSh, myOptimumNbFaces);
 
     // processing each face
-    mapF.Clear();
     for (exp.Init(aSoOrSh, TopAbs_FACE); exp.More() && doUnion; exp.Next()) {
       TopoDS_Face aFace = TopoDS::Face(exp.Current().Oriented(TopAbs_FORWARD));
 
@@ -533,7 +678,11 @@ TopoDS_Shape BlockFix_UnionFaces::Perform(const TopoDS_Shape& Shape)
             continue;
           }
 
-          if (IsSameDomain(aFace,anCheckedFace)) {
+          Standard_Boolean isSameDomain;
+          if (!aSameDomainCache.Find(aFace, anCheckedFace, isSameDomain))
+            isSameDomain = IsSameDomain(aFace, anCheckedFace);
+
+          if (isSameDomain) {
 
             if (aList.Extent() != 2) {
               // non mainfold case is not processed
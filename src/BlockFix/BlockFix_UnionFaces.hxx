@@ -50,6 +50,17 @@ public:
    */
   Standard_EXPORT Standard_Integer& GetOptimumNbFaces();
 
+  /* \brief To get/set the RunParallel parameter
+   *
+   * If set, the same domain tests of the adjacent faces of all
+   *    solids are computed in parallel before the faces are merged,
+   *    so IsSameDomain() must be thread-safe in this mode.
+   * The faces are merged sequentially, the result does not depend
+   *    on this parameter. By default it is not set.
+   *
+   */
+  Standard_EXPORT Standard_Boolean& GetRunParallel();
+
   Standard_EXPORT TopoDS_Shape Perform(const TopoDS_Shape& Shape);
 
   Standard_EXPORT virtual Standard_Boolean IsSameDomain(const TopoDS_Face& aFace,
@@ -61,6 +72,7 @@ public:
 private:
   Standard_Real myTolerance;
   Standard_Integer myOptimumNbFaces;
+  Standard_Boolean myRunParallel;
 };
 
 #endif
@@ -35,7 +35,8 @@ GEOMAlgo_Algo::GEOMAlgo_Algo()
 :
   myErrorStatus(1),
   myWarningStatus(0),
-  myComputeInternalShapes(Standard_True)
+  myComputeInternalShapes(Standard_True),
+  myRunParallel(Standard_False)
 {}
 //=======================================================================
 // function: ~
@@ -88,3 +89,43 @@ void GEOMAlgo_Algo::ComputeInternalShapes(const Standard_Boolean theFlag)
 {
   myComputeInternalShapes = theFlag;
 }
+//=======================================================================
+//function : SetRunParallel
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::SetRunParallel(const Standard_Boolean theFlag)
+{
+  myRunParallel = theFlag;
+}
+//=======================================================================
+//function : RunParallel
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Algo::RunParallel() const
+{
+  return myRunParallel;
+}
+//=======================================================================
+//function : SetProfiling
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::SetProfiling(const Standard_Boolean theFlag)
+{
+  myProfile.SetEnabled(theFlag);
+}
+//=======================================================================
+//function : Profiling
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Algo::Profiling() const
+{
+  return myProfile.IsEnabled();
+}
+//=======================================================================
+//function : Profile
+//purpose  :
+//=======================================================================
+const GEOMAlgo_Profile& GEOMAlgo_Algo::Profile() const
+{
+  return myProfile;
+}
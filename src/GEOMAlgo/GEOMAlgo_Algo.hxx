@@ -33,6 +33,8 @@
 #include <Standard_Integer.hxx>
 #include <Standard_Boolean.hxx>
 
+#include <GEOMAlgo_Profile.hxx>
+
 //=======================================================================
 //class    : GEOMAlgo_Algo
 //purpose  :
@@ -54,6 +56,29 @@ class GEOMAlgo_Algo
   Standard_EXPORT
     void ComputeInternalShapes(const Standard_Boolean theFlag) ;
 
+  //! Sets the flag of parallel processing. <br>
+  //!          The default is sequential processing. <br>
+  Standard_EXPORT
+    void SetRunParallel(const Standard_Boolean theFlag) ;
+
+  //! Returns the flag of parallel processing. <br>
+  Standard_EXPORT
+    Standard_Boolean RunParallel() const;
+
+  //! Sets the flag to collect the wall times of the stages and
+  //!          the counters of the algorithm (see Profile()). <br>
+  //!          The default is no profiling. <br>
+  Standard_EXPORT
+    void SetProfiling(const Standard_Boolean theFlag) ;
+
+  //! Returns the flag to collect the profile. <br>
+  Standard_EXPORT
+    Standard_Boolean Profiling() const;
+
+  //! Returns the profile of the last run of the algorithm. <br>
+  Standard_EXPORT
+    const GEOMAlgo_Profile& Profile() const;
+
 protected:
   Standard_EXPORT
     GEOMAlgo_Algo();
@@ -71,5 +96,7 @@ protected:
   Standard_Integer myErrorStatus;
   Standard_Integer myWarningStatus;
   Standard_Boolean myComputeInternalShapes;
+  Standard_Boolean myRunParallel;
+  GEOMAlgo_Profile myProfile;
 };
 #endif
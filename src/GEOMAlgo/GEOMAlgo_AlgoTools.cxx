@@ -32,6 +32,7 @@
 #include <gp_Dir2d.hxx>
 #include <gp_Ax2.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
 
 #include <BRepAdaptor_Curve2d.hxx>
 #include <BRepTopAdaptor_FClass2d.hxx>
@@ -109,9 +110,18 @@
 
 #include <Prs3d.hxx>
 
+#include <BOPTools_Parallel.hxx>
+
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
+
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+
 #include <GEOMAlgo_PassKeyShape.hxx>
+#include <GEOMAlgo_BoxBndTree.hxx>
 
 #include <algorithm>
+#include <vector>
 
 static
   void GetCount(const TopoDS_Shape& aS,
@@ -133,6 +143,26 @@ static void CorrectShell (const TopoDS_Shape& theShell,
 static gp_Pnt GetMidPnt2d(const TopoDS_Face&     theFace,
                           const Standard_Boolean theIsNaturalRestrictions);
 
+static
+  Standard_Boolean CanBeIndexed(const TopTools_ListOfShape& aLE);
+
+static
+  Standard_Integer FindSDShapesIndexed
+    (const TopTools_ListOfShape& aLE,
+     const Standard_Real aTol,
+     TopTools_IndexedDataMapOfShapeListOfShape& aMEE,
+     const Handle(IntTools_Context)& aCtx,
+     const Standard_Boolean bUseOBB,
+     Standard_Size& aNbCandidates,
+     Standard_Size& aNbTested);
+
+//! Min number of shapes in a list for which FindSDShapes()
+//! uses the spatial index instead of the pairwise tests.
+//! With the oriented boxes the index is used for all lists,
+//! otherwise the short lists (e.g. the pairs of edges with the
+//! same vertices) would not be pruned by them
+static const Standard_Integer THE_NB_SD_INDEXED=8;
+
 static void ModifyFacesForGlobalResult(const TopoDS_Face&     theInputFace,
                                        const Standard_Real    theAverageArea,
                                        const Standard_Boolean theIsToAddFaces,
@@ -719,9 +749,13 @@ Standard_Integer GEOMAlgo_AlgoTools::FindSDShapes
   (const TopTools_ListOfShape& aLE,
    const Standard_Real aTol,
    TopTools_IndexedDataMapOfShapeListOfShape& aMEE,
-   const Handle(IntTools_Context)& aCtx)
+   const Handle(IntTools_Context)& aCtx,
+   const Standard_Boolean theUseOBB,
+   Standard_Size* theNbCandidates,
+   Standard_Size* theNbTested)
 {
   Standard_Integer aNbE, aNbEProcessed, aNbESD, iErr;
+  Standard_Size aNbCandidates, aNbTested;
   TopTools_ListOfShape aLESD;
   TopTools_ListIteratorOfListOfShape aIt, aIt1;
   TopTools_IndexedMapOfShape aMProcessed;
@@ -735,6 +769,20 @@ Standard_Integer GEOMAlgo_AlgoTools::FindSDShapes
     return 0; // Nothing to do
   }
   //
+  aNbCandidates=0;
+  aNbTested=0;
+  if ((aNbE>=THE_NB_SD_INDEXED || theUseOBB) && CanBeIndexed(aLE)) {
+    iErr=FindSDShapesIndexed(aLE, aTol, aMEE, aCtx, theUseOBB,
+                             aNbCandidates, aNbTested);
+    if (theNbCandidates) {
+      *theNbCandidates+=aNbCandidates;
+    }
+    if (theNbTested) {
+      *theNbTested+=aNbTested;
+    }
+    return iErr;
+  }
+  //
   for(;;) {
     aNbEProcessed=aMProcessed.Extent();
     if (aNbEProcessed==aNbE) {
@@ -763,6 +811,13 @@ Standard_Integer GEOMAlgo_AlgoTools::FindSDShapes
       if (iErr) {
         return 2; // Err
       }
+      // each other shape of the list is tested
+      if (theNbCandidates) {
+        *theNbCandidates+=(Standard_Size)(aNbE-1);
+      }
+      if (theNbTested) {
+        *theNbTested+=(Standard_Size)(aNbE-1);
+      }
       //
       aNbESD=aLESD.Extent();
       if (!aNbESD) {
@@ -781,29 +836,281 @@ Standard_Integer GEOMAlgo_AlgoTools::FindSDShapes
   return 0;
 }
 //=======================================================================
+//function : CanBeIndexed
+//purpose  : Checks that each shape of the list is a face or an edge
+//           with 3D curve, i.e. that the projection of a point on it
+//           lies inside its bounding box
+//=======================================================================
+Standard_Boolean CanBeIndexed(const TopTools_ListOfShape& aLE)
+{
+  Standard_Real aT1, aT2;
+  TopAbs_ShapeEnum aType;
+  TopTools_ListIteratorOfListOfShape aIt;
+  //
+  aIt.Initialize(aLE);
+  for (; aIt.More(); aIt.Next()) {
+    const TopoDS_Shape& aS=aIt.Value();
+    aType=aS.ShapeType();
+    if (aType==TopAbs_EDGE) {
+      const TopoDS_Edge& aE=TopoDS::Edge(aS);
+      if (BRep_Tool::Degenerated(aE) ||
+          BRep_Tool::Curve(aE, aT1, aT2).IsNull()) {
+        return Standard_False;
+      }
+    }
+    else if (aType!=TopAbs_FACE) {
+      return Standard_False;
+    }
+  }
+  return Standard_True;
+}
+//=======================================================================
+//function : FindSDShapesIndexed
+//purpose  : The same as FindSDShapes(aLE, ...), but the shapes are
+//           tested only if the point of the shape is inside their
+//           bounding boxes enlarged by the tolerance.
+//           The candidates are tested in the order of the list,
+//           so that the result is the same.
+//           If bUseOBB is set, the candidates are also skipped if the
+//           point is outside their oriented bounding boxes, which are
+//           much tighter than the axis-aligned ones for the rotated
+//           thin shapes.
+//           aNbCandidates and aNbTested are the numbers of the pairs
+//           left by the axis-aligned and by the oriented boxes.
+//=======================================================================
+Standard_Integer FindSDShapesIndexed
+  (const TopTools_ListOfShape& aLE,
+   const Standard_Real aTol,
+   TopTools_IndexedDataMapOfShapeListOfShape& aMEE,
+   const Handle(IntTools_Context)& aCtx,
+   const Standard_Boolean bUseOBB,
+   Standard_Size& aNbCandidates,
+   Standard_Size& aNbTested)
+{
+  Standard_Boolean bIsDone;
+  Standard_Integer i, j, aNbE;
+  Standard_Real aTol2, aD2;
+  gp_Pnt aP1, aP2;
+  TopTools_ListOfShape aLESD;
+  TopTools_ListIteratorOfListOfShape aIt;
+  TopTools_IndexedMapOfShape aMProcessed;
+  TColStd_ListIteratorOfListOfInteger aItLI;
+  GEOMAlgo_BoxBndTree aBBTree;
+  GEOMAlgo_BoxBndTreeSelector aSelector;
+  std::vector<Standard_Integer> aIds;
+  //
+  aTol2=aTol*aTol;
+  aNbE=aLE.Extent();
+  NCollection_Array1<TopoDS_Shape> aShapes(1, aNbE);
+  NCollection_Array1<Bnd_OBB> aOBBs(1, bUseOBB ? aNbE : 1);
+  //
+  aIt.Initialize(aLE);
+  for (i=1; aIt.More(); aIt.Next(), ++i) {
+    Bnd_Box aBox;
+    //
+    const TopoDS_Shape& aS=aIt.Value();
+    aShapes(i)=aS;
+    BRepBndLib::Add(aS, aBox, Standard_False);
+    aBox.Enlarge(aTol);
+    aBBTree.Add(i, aBox);
+    //
+    if (bUseOBB) {
+      Bnd_OBB& aOBB=aOBBs(i);
+      // not optimal, but enclosing the shape with its tolerance
+      BRepBndLib::AddOBB(aS, aOBB, Standard_False, Standard_False, Standard_True);
+      aOBB.Enlarge(aTol);
+    }
+  }
+  aBBTree.Build();
+  //
+  for (i=1; i<=aNbE; ++i) {
+    const TopoDS_Shape& aS=aShapes(i);
+    if (aMProcessed.Contains(aS)) {
+      continue;
+    }
+    //
+    Bnd_Box aBoxP;
+    //
+    GEOMAlgo_AlgoTools::PointOnShape(aS, aP1);
+    aBoxP.Add(aP1);
+    aSelector.Clear();
+    aSelector.SetBox(aBoxP);
+    aBBTree.Select(aSelector);
+    //
+    aIds.clear();
+    aItLI.Initialize(aSelector.Indices());
+    for (; aItLI.More(); aItLI.Next()) {
+      aIds.push_back(aItLI.Value());
+    }
+    std::sort(aIds.begin(), aIds.end());
+    //
+    aLESD.Clear();
+    for (j=0; j<(Standard_Integer)aIds.size(); ++j) {
+      const TopoDS_Shape& aS2=aShapes(aIds[j]);
+      if (aS2.IsSame(aS)) {
+        aLESD.Append(aS2);
+        continue;
+      }
+      //
+      ++aNbCandidates;
+      if (bUseOBB && aOBBs(aIds[j]).IsOut(aP1)) {
+        continue;
+      }
+      //
+      ++aNbTested;
+      bIsDone=GEOMAlgo_AlgoTools::ProjectPointOnShape(aP1, aS2, aP2, aCtx);
+      if (!bIsDone) {
+        continue;
+      }
+      aD2=aP1.SquareDistance(aP2);
+      if (aD2<aTol2) {
+        aLESD.Append(aS2);
+      }
+    }
+    //
+    if (aLESD.IsEmpty()) {
+      return 1; // Err
+    }
+    //
+    aMEE.Add(aS, aLESD);
+    //
+    aIt.Initialize(aLESD);
+    for (; aIt.More(); aIt.Next()) {
+      aMProcessed.Add(aIt.Value());
+    }
+  }
+  return 0;
+}
+//=======================================================================
+//class    : GEOMAlgo_FindSDShapes
+//purpose  : Finds the SD shapes of one list (see RefineSDShapes)
+//=======================================================================
+class GEOMAlgo_FindSDShapes
+{
+ public:
+  GEOMAlgo_FindSDShapes()
+  :
+    myLS(NULL),
+    myTol(0.),
+    myUseOBB(Standard_False),
+    myErr(0),
+    myNbCandidates(0),
+    myNbTested(0)
+  {}
+  //
+  void SetList(const TopTools_ListOfShape& theLS)
+  {
+    myLS=&theLS;
+  }
+  //
+  void SetTolerance(const Standard_Real theTol)
+  {
+    myTol=theTol;
+  }
+  //
+  void SetUseOBB(const Standard_Boolean theFlag)
+  {
+    myUseOBB=theFlag;
+  }
+  //
+  void SetContext(const Handle(IntTools_Context)& theContext)
+  {
+    myContext=theContext;
+  }
+  //
+  const Handle(IntTools_Context)& Context() const
+  {
+    return myContext;
+  }
+  //
+  Standard_Integer ErrorStatus() const
+  {
+    return myErr;
+  }
+  //
+  TopTools_IndexedDataMapOfShapeListOfShape& ChangeSDShapes()
+  {
+    return myMEE;
+  }
+  //
+  Standard_Size NbCandidates() const
+  {
+    return myNbCandidates;
+  }
+  //
+  Standard_Size NbTested() const
+  {
+    return myNbTested;
+  }
+  //
+  void Perform()
+  {
+    myErr=GEOMAlgo_AlgoTools::FindSDShapes(*myLS, myTol, myMEE, myContext,
+                                           myUseOBB, &myNbCandidates,
+                                           &myNbTested);
+  }
+  //
+ protected:
+  const TopTools_ListOfShape* myLS;
+  Standard_Real myTol;
+  Standard_Boolean myUseOBB;
+  Standard_Integer myErr;
+  Standard_Size myNbCandidates;
+  Standard_Size myNbTested;
+  TopTools_IndexedDataMapOfShapeListOfShape myMEE;
+  Handle(IntTools_Context) myContext;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_FindSDShapes> GEOMAlgo_VectorOfFindSDShapes;
+//
+//=======================================================================
 //function : RefineSDShapes
 //purpose  :
 //=======================================================================
 Standard_Integer GEOMAlgo_AlgoTools::RefineSDShapes
   (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMPKLE,
    const Standard_Real aTol,
-   const Handle(IntTools_Context)& aCtx)
+   const Handle(IntTools_Context)& aCtx,
+   const Standard_Boolean theRunParallel,
+   const Standard_Boolean theUseOBB,
+   Standard_Size* theNbCandidates,
+   Standard_Size* theNbTested)
 {
   Standard_Integer i, aNbE, iErr, j, aNbEE, aNbToAdd;
-  TopTools_IndexedDataMapOfShapeListOfShape aMEE, aMSDE, aMEToAdd;
+  TopTools_IndexedDataMapOfShapeListOfShape aMSDE, aMEToAdd;
+  GEOMAlgo_VectorOfFindSDShapes aVFSD;
+  Handle(IntTools_Context) aContext=aCtx;
   //
   iErr=1;
   //
+  // the lists are independent of each other
   aNbE=aMPKLE.Extent();
+  for (i=1; i<=aNbE; ++i) {
+    GEOMAlgo_FindSDShapes& aFSD=aVFSD.Appended();
+    aFSD.SetList(aMPKLE(i));
+    aFSD.SetTolerance(aTol);
+    aFSD.SetUseOBB(theUseOBB);
+  }
+  //
+  BOPTools_Parallel::Perform(theRunParallel, aVFSD, aContext);
+  //
   for (i=1; i<=aNbE; ++i) {
     TopTools_ListOfShape& aLSDE=aMPKLE.ChangeFromIndex(i);
+    GEOMAlgo_FindSDShapes& aFSD=aVFSD(i-1);
     //
-    aMEE.Clear();
-    iErr=GEOMAlgo_AlgoTools::FindSDShapes(aLSDE, aTol, aMEE, aCtx);
+    iErr=aFSD.ErrorStatus();
     if (iErr) {
       return iErr;
     }
     //
+    if (theNbCandidates) {
+      *theNbCandidates+=aFSD.NbCandidates();
+    }
+    if (theNbTested) {
+      *theNbTested+=aFSD.NbTested();
+    }
+    //
+    TopTools_IndexedDataMapOfShapeListOfShape& aMEE=aFSD.ChangeSDShapes();
     aNbEE=aMEE.Extent();
     if (aNbEE==1) {
       continue;  // nothing to do
@@ -86,17 +86,38 @@ namespace GEOMAlgo_AlgoTools
      Standard_Boolean IsCompositeShape(const TopoDS_Shape& aS) ;
 
 
+  //! Splits each list of <aMSD> into the lists of geometrically
+  //!          coincident shapes. <br>
+  //!          The lists are independent of each other and are
+  //!          processed in parallel if <theRunParallel> is set. <br>
+  //!          The candidates are pruned by oriented bounding boxes
+  //!          if <theUseOBB> is set. <br>
+  //!          If <theNbCandidates> and <theNbTested> are given, the
+  //!          numbers of the candidate pairs left by the axis-aligned
+  //!          boxes and of the pairs tested by the projection (i.e.
+  //!          left by the oriented boxes) are added to them. <br>
   Standard_EXPORT
      Standard_Integer RefineSDShapes
       (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMSD,
        const Standard_Real aTol,
-       const Handle(IntTools_Context)& aCtx) ;
+       const Handle(IntTools_Context)& aCtx,
+       const Standard_Boolean theRunParallel = Standard_False,
+       const Standard_Boolean theUseOBB = Standard_False,
+       Standard_Size* theNbCandidates = NULL,
+       Standard_Size* theNbTested = NULL) ;
 
+  //! Splits the list <aLE> into the lists of geometrically
+  //!          coincident shapes <aMEE>. <br>
+  //!          See RefineSDShapes() for <theUseOBB>,
+  //!          <theNbCandidates> and <theNbTested>. <br>
   Standard_EXPORT
      Standard_Integer FindSDShapes(const TopTools_ListOfShape& aLE,
                                    const Standard_Real aTol,
                                    TopTools_IndexedDataMapOfShapeListOfShape& aMEE,
-                                   const Handle(IntTools_Context)& aCtx) ;
+                                   const Handle(IntTools_Context)& aCtx,
+                                   const Standard_Boolean theUseOBB = Standard_False,
+                                   Standard_Size* theNbCandidates = NULL,
+                                   Standard_Size* theNbTested = NULL) ;
   Standard_EXPORT
      Standard_Integer FindSDShapes(const TopoDS_Shape& aE1,
                                    const TopTools_ListOfShape& aLE,
@@ -23,6 +23,163 @@
 //		<pkv@irinox>
 //
 #include <GEOMAlgo_BndSphereTree.hxx>
+
+#include <OSD_Parallel.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_BndSphereTreeVisitor
+//purpose  : Makes the exact test of the candidates of the tree
+//=======================================================================
+class GEOMAlgo_BndSphereTreeVisitor
+{
+ public:
+  GEOMAlgo_BndSphereTreeVisitor(const NCollection_Vector<GEOMAlgo_BndSphere>& theItems,
+      const NCollection_Vector<Standard_Integer>& theIndices,
+      GEOMAlgo_BndSphereTreeSelector& theSelector)
+  :
+    myItems(theItems),
+    myIndices(theIndices),
+    mySelector(theSelector),
+    myNbAccepted(0)
+  {}
+  //
+  void operator()(const Standard_Integer theId)
+  {
+    if (!mySelector.Reject(myItems(theId))) {
+      if (mySelector.Accept(myIndices(theId))) {
+        ++myNbAccepted;
+      }
+    }
+  }
+  //
+  Standard_Integer NbAccepted() const
+  {
+    return myNbAccepted;
+  }
+  //
+ protected:
+  const NCollection_Vector<GEOMAlgo_BndSphere>& myItems;
+  const NCollection_Vector<Standard_Integer>& myIndices;
+  GEOMAlgo_BndSphereTreeSelector& mySelector;
+  Standard_Integer myNbAccepted;
+};
+//=======================================================================
+//class    : GEOMAlgo_BndSphereTreeFunctor
+//purpose  : Batch selection
+//=======================================================================
+class GEOMAlgo_BndSphereTreeFunctor
+{
+ public:
+  GEOMAlgo_BndSphereTreeFunctor(const GEOMAlgo_BndSphereTree& theTree,
+      const NCollection_Array1<GEOMAlgo_BndSphere>& theItems,
+      NCollection_Array1<TColStd_ListOfInteger>& theIndices)
+  :
+    myTree(theTree),
+    myItems(theItems),
+    myIndices(theIndices)
+  {}
+  //
+  void operator()(const Standard_Integer i) const
+  {
+    GEOMAlgo_BndSphereTreeSelector aSelector;
+    //
+    aSelector.SetBox(myItems(i));
+    myTree.Select(aSelector);
+    myIndices(i)=aSelector.Indices();
+  }
+  //
+ protected:
+  const GEOMAlgo_BndSphereTree& myTree;
+  const NCollection_Array1<GEOMAlgo_BndSphere>& myItems;
+  NCollection_Array1<TColStd_ListOfInteger>& myIndices;
+};
+//=======================================================================
+//function : Bounds
+//purpose  :
+//=======================================================================
+static
+  Standard_Boolean Bounds(const GEOMAlgo_BndSphere& theItem,
+                          Standard_Real theMin[3],
+                          Standard_Real theMax[3])
+{
+  Standard_Integer k;
+  Standard_Real aR;
+  //
+  const gp_Pnt& aC=theItem.Center();
+  aR=theItem.Radius()+theItem.Gap();
+  for (k=0; k<3; ++k) {
+    theMin[k]=aC.Coord(k+1)-aR;
+    theMax[k]=aC.Coord(k+1)+aR;
+  }
+  return Standard_True;
+}
+//=======================================================================
+//function : 
+//purpose  : 
+//=======================================================================
+  GEOMAlgo_BndSphereTree::GEOMAlgo_BndSphereTree()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BndSphereTree::Clear()
+{
+  myBVH.Clear();
+  mySpheres.Clear();
+  myIndices.Clear();
+}
+//=======================================================================
+//function : Add
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BndSphereTree::Add(const Standard_Integer theIndex,
+                     const GEOMAlgo_BndSphere& theItem)
+{
+  Standard_Real aMin[3], aMax[3];
+  //
+  if (!Bounds(theItem, aMin, aMax)) {
+    return; // it can not be selected
+  }
+  myBVH.Add(mySpheres.Length(), aMin, aMax);
+  mySpheres.Append(theItem);
+  myIndices.Append(theIndex);
+}
+//=======================================================================
+//function : Build
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BndSphereTree::Build()
+{
+  myBVH.Build();
+}
+//=======================================================================
+//function : Select
+//purpose  : 
+//=======================================================================
+  Standard_Integer GEOMAlgo_BndSphereTree::Select(GEOMAlgo_BndSphereTreeSelector& theSelector) const
+{
+  Standard_Real aMin[3], aMax[3];
+  GEOMAlgo_BndSphereTreeVisitor aVisitor(mySpheres, myIndices, theSelector);
+  //
+  if (Bounds(theSelector.Box(), aMin, aMax)) {
+    myBVH.Select(aMin, aMax, aVisitor);
+  }
+  return aVisitor.NbAccepted();
+}
+//=======================================================================
+//function : Select
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BndSphereTree::Select(const NCollection_Array1<GEOMAlgo_BndSphere>& theItems,
+                        NCollection_Array1<TColStd_ListOfInteger>& theIndices,
+                        const Standard_Boolean theRunParallel) const
+{
+  GEOMAlgo_BndSphereTreeFunctor aFunctor(*this, theItems, theIndices);
+  //
+  OSD_Parallel::For(theItems.Lower(), theItems.Upper()+1, aFunctor, !theRunParallel);
+}
 //=======================================================================
 //function : 
 //purpose  : 
@@ -54,13 +211,8 @@
 //=======================================================================
   Standard_Boolean GEOMAlgo_BndSphereTreeSelector::Accept (const Standard_Integer& aIndex)
 {
-  Standard_Boolean bRet=Standard_False;
-  //
-  if (myFence.Add(aIndex)) {
-    myIndices.Append(aIndex);
-    bRet=!bRet;
-  }
-  return bRet;
+  myIndices.Append(aIndex);
+  return Standard_True;
 }
 //=======================================================================
 //function : SetBox
@@ -71,12 +223,19 @@
   myBox=aBox;
 }
 //=======================================================================
+//function : Box
+//purpose  : 
+//=======================================================================
+  const GEOMAlgo_BndSphere& GEOMAlgo_BndSphereTreeSelector::Box() const
+{
+  return myBox;
+}
+//=======================================================================
 //function : Clear
 //purpose  : 
 //=======================================================================
   void GEOMAlgo_BndSphereTreeSelector::Clear()
 {
-  myFence.Clear();
   myIndices.Clear();
 }
 //=======================================================================
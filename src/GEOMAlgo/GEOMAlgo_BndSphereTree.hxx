@@ -25,14 +25,48 @@
 #ifndef GEOMAlgo_BndSphereTree_HeaderFile
 #define GEOMAlgo_BndSphereTree_HeaderFile
 
-#include <NCollection_UBTree.hxx>
 #include <GEOMAlgo_BndSphere.hxx>
-#include <TColStd_MapOfInteger.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
 #include <TColStd_ListOfInteger.hxx>
 
-typedef NCollection_UBTree <Standard_Integer , GEOMAlgo_BndSphere> GEOMAlgo_BndSphereTree;
+#include <GEOMAlgo_LinearBVH.hxx>
 
-  class GEOMAlgo_BndSphereTreeSelector : public GEOMAlgo_BndSphereTree::Selector {
+class GEOMAlgo_BndSphereTreeSelector;
+
+//=======================================================================
+//class    : GEOMAlgo_BndSphereTree
+//purpose  : Tree of indexed spheres (see GEOMAlgo_LinearBVH).
+//           Usage: Add() the spheres, Build() and Select().
+//=======================================================================
+class GEOMAlgo_BndSphereTree {
+  public:
+    Standard_EXPORT GEOMAlgo_BndSphereTree();
+    Standard_EXPORT void Clear();
+    Standard_EXPORT void Add(const Standard_Integer theIndex, const GEOMAlgo_BndSphere& theSphere);
+    Standard_EXPORT void Build();
+
+    //! Selects the indices of the spheres accepted by the selector.
+    //! Returns the number of the accepted spheres.
+    Standard_EXPORT Standard_Integer Select(GEOMAlgo_BndSphereTreeSelector& theSelector) const;
+
+    //! Selects the indices of the spheres interfering with each sphere
+    //! of <theSpheres> into the item of <theIndices> of the same index.
+    Standard_EXPORT void Select(const NCollection_Array1<GEOMAlgo_BndSphere>& theSpheres,
+                                NCollection_Array1<TColStd_ListOfInteger>& theIndices,
+                                const Standard_Boolean theRunParallel=Standard_False) const;
+
+  protected:
+    GEOMAlgo_LinearBVH myBVH;
+    NCollection_Vector<GEOMAlgo_BndSphere> mySpheres;
+    NCollection_Vector<Standard_Integer> myIndices;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_BndSphereTreeSelector
+//purpose  :
+//=======================================================================
+  class GEOMAlgo_BndSphereTreeSelector {
     public:
       Standard_EXPORT GEOMAlgo_BndSphereTreeSelector();
       Standard_EXPORT virtual Standard_Boolean Reject(const GEOMAlgo_BndSphere&) const;
@@ -41,11 +75,11 @@ typedef NCollection_UBTree <Standard_Integer , GEOMAlgo_BndSphere> GEOMAlgo_BndS
       
       Standard_EXPORT void Clear();
       Standard_EXPORT void SetBox(const GEOMAlgo_BndSphere&);
+      Standard_EXPORT const GEOMAlgo_BndSphere& Box() const;
       Standard_EXPORT const TColStd_ListOfInteger& Indices() const;
 
     protected:
       GEOMAlgo_BndSphere  myBox;
-      TColStd_MapOfInteger  myFence;
       TColStd_ListOfInteger myIndices;
       
   };
@@ -26,6 +26,158 @@
 //              <pkv@irinox>
 //
 #include <GEOMAlgo_BoxBndTree.hxx>
+
+#include <OSD_Parallel.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_BoxBndTreeVisitor
+//purpose  : Makes the exact test of the candidates of the tree
+//=======================================================================
+class GEOMAlgo_BoxBndTreeVisitor
+{
+ public:
+  GEOMAlgo_BoxBndTreeVisitor(const NCollection_Vector<Bnd_Box>& theItems,
+      const NCollection_Vector<Standard_Integer>& theIndices,
+      GEOMAlgo_BoxBndTreeSelector& theSelector)
+  :
+    myItems(theItems),
+    myIndices(theIndices),
+    mySelector(theSelector),
+    myNbAccepted(0)
+  {}
+  //
+  void operator()(const Standard_Integer theId)
+  {
+    if (!mySelector.Reject(myItems(theId))) {
+      if (mySelector.Accept(myIndices(theId))) {
+        ++myNbAccepted;
+      }
+    }
+  }
+  //
+  Standard_Integer NbAccepted() const
+  {
+    return myNbAccepted;
+  }
+  //
+ protected:
+  const NCollection_Vector<Bnd_Box>& myItems;
+  const NCollection_Vector<Standard_Integer>& myIndices;
+  GEOMAlgo_BoxBndTreeSelector& mySelector;
+  Standard_Integer myNbAccepted;
+};
+//=======================================================================
+//class    : GEOMAlgo_BoxBndTreeFunctor
+//purpose  : Batch selection
+//=======================================================================
+class GEOMAlgo_BoxBndTreeFunctor
+{
+ public:
+  GEOMAlgo_BoxBndTreeFunctor(const GEOMAlgo_BoxBndTree& theTree,
+      const NCollection_Array1<Bnd_Box>& theItems,
+      NCollection_Array1<TColStd_ListOfInteger>& theIndices)
+  :
+    myTree(theTree),
+    myItems(theItems),
+    myIndices(theIndices)
+  {}
+  //
+  void operator()(const Standard_Integer i) const
+  {
+    GEOMAlgo_BoxBndTreeSelector aSelector;
+    //
+    aSelector.SetBox(myItems(i));
+    myTree.Select(aSelector);
+    myIndices(i)=aSelector.Indices();
+  }
+  //
+ protected:
+  const GEOMAlgo_BoxBndTree& myTree;
+  const NCollection_Array1<Bnd_Box>& myItems;
+  NCollection_Array1<TColStd_ListOfInteger>& myIndices;
+};
+//=======================================================================
+//function : Bounds
+//purpose  :
+//=======================================================================
+static
+  Standard_Boolean Bounds(const Bnd_Box& theItem,
+                          Standard_Real theMin[3],
+                          Standard_Real theMax[3])
+{
+  if (theItem.IsVoid()) {
+    return Standard_False;
+  }
+  theItem.Get(theMin[0], theMin[1], theMin[2], theMax[0], theMax[1], theMax[2]);
+  return Standard_True;
+}
+//=======================================================================
+//function : 
+//purpose  : 
+//=======================================================================
+  GEOMAlgo_BoxBndTree::GEOMAlgo_BoxBndTree()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BoxBndTree::Clear()
+{
+  myBVH.Clear();
+  myBoxes.Clear();
+  myIndices.Clear();
+}
+//=======================================================================
+//function : Add
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BoxBndTree::Add(const Standard_Integer theIndex,
+                     const Bnd_Box& theItem)
+{
+  Standard_Real aMin[3], aMax[3];
+  //
+  if (!Bounds(theItem, aMin, aMax)) {
+    return; // it can not be selected
+  }
+  myBVH.Add(myBoxes.Length(), aMin, aMax);
+  myBoxes.Append(theItem);
+  myIndices.Append(theIndex);
+}
+//=======================================================================
+//function : Build
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BoxBndTree::Build()
+{
+  myBVH.Build();
+}
+//=======================================================================
+//function : Select
+//purpose  : 
+//=======================================================================
+  Standard_Integer GEOMAlgo_BoxBndTree::Select(GEOMAlgo_BoxBndTreeSelector& theSelector) const
+{
+  Standard_Real aMin[3], aMax[3];
+  GEOMAlgo_BoxBndTreeVisitor aVisitor(myBoxes, myIndices, theSelector);
+  //
+  if (Bounds(theSelector.Box(), aMin, aMax)) {
+    myBVH.Select(aMin, aMax, aVisitor);
+  }
+  return aVisitor.NbAccepted();
+}
+//=======================================================================
+//function : Select
+//purpose  : 
+//=======================================================================
+  void GEOMAlgo_BoxBndTree::Select(const NCollection_Array1<Bnd_Box>& theItems,
+                        NCollection_Array1<TColStd_ListOfInteger>& theIndices,
+                        const Standard_Boolean theRunParallel) const
+{
+  GEOMAlgo_BoxBndTreeFunctor aFunctor(*this, theItems, theIndices);
+  //
+  OSD_Parallel::For(theItems.Lower(), theItems.Upper()+1, aFunctor, !theRunParallel);
+}
 //=======================================================================
 //function : 
 //purpose  : 
@@ -57,13 +209,8 @@
 //=======================================================================
   Standard_Boolean GEOMAlgo_BoxBndTreeSelector::Accept (const Standard_Integer& aIndex)
 {
-  Standard_Boolean bRet=Standard_False;
-  //
-  if (myFence.Add(aIndex)) {
-    myIndices.Append(aIndex);
-    bRet=!bRet;
-  }
-  return bRet;
+  myIndices.Append(aIndex);
+  return Standard_True;
 }
 //=======================================================================
 //function : SetBox
@@ -74,12 +221,19 @@
   myBox=aBox;
 }
 //=======================================================================
+//function : Box
+//purpose  : 
+//=======================================================================
+  const Bnd_Box& GEOMAlgo_BoxBndTreeSelector::Box() const
+{
+  return myBox;
+}
+//=======================================================================
 //function : Clear
 //purpose  : 
 //=======================================================================
   void GEOMAlgo_BoxBndTreeSelector::Clear()
 {
-  myFence.Clear();
   myIndices.Clear();
 }
 //=======================================================================
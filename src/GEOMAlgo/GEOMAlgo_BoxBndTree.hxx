@@ -28,14 +28,48 @@
 #ifndef GEOMAlgo_BoxBndTree_HeaderFile
 #define GEOMAlgo_BoxBndTree_HeaderFile
 
-#include <NCollection_UBTree.hxx>
 #include <Bnd_Box.hxx>
-#include <TColStd_MapOfInteger.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
 #include <TColStd_ListOfInteger.hxx>
 
-typedef NCollection_UBTree <Standard_Integer , Bnd_Box> GEOMAlgo_BoxBndTree;
+#include <GEOMAlgo_LinearBVH.hxx>
 
-  class GEOMAlgo_BoxBndTreeSelector : public GEOMAlgo_BoxBndTree::Selector {
+class GEOMAlgo_BoxBndTreeSelector;
+
+//=======================================================================
+//class    : GEOMAlgo_BoxBndTree
+//purpose  : Tree of indexed boxes (see GEOMAlgo_LinearBVH).
+//           Usage: Add() the boxes, Build() and Select().
+//=======================================================================
+class GEOMAlgo_BoxBndTree {
+  public:
+    Standard_EXPORT GEOMAlgo_BoxBndTree();
+    Standard_EXPORT void Clear();
+    Standard_EXPORT void Add(const Standard_Integer theIndex, const Bnd_Box& theBox);
+    Standard_EXPORT void Build();
+
+    //! Selects the indices of the boxes accepted by the selector.
+    //! Returns the number of the accepted boxes.
+    Standard_EXPORT Standard_Integer Select(GEOMAlgo_BoxBndTreeSelector& theSelector) const;
+
+    //! Selects the indices of the boxes interfering with each box
+    //! of <theBoxes> into the item of <theIndices> of the same index.
+    Standard_EXPORT void Select(const NCollection_Array1<Bnd_Box>& theBoxes,
+                                NCollection_Array1<TColStd_ListOfInteger>& theIndices,
+                                const Standard_Boolean theRunParallel=Standard_False) const;
+
+  protected:
+    GEOMAlgo_LinearBVH myBVH;
+    NCollection_Vector<Bnd_Box> myBoxes;
+    NCollection_Vector<Standard_Integer> myIndices;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_BoxBndTreeSelector
+//purpose  :
+//=======================================================================
+  class GEOMAlgo_BoxBndTreeSelector {
     public:
       Standard_EXPORT GEOMAlgo_BoxBndTreeSelector();
       Standard_EXPORT virtual Standard_Boolean Reject(const Bnd_Box&) const;
@@ -44,11 +78,11 @@ typedef NCollection_UBTree <Standard_Integer , Bnd_Box> GEOMAlgo_BoxBndTree;
       
       Standard_EXPORT void Clear();
       Standard_EXPORT void SetBox(const Bnd_Box&);
+      Standard_EXPORT const Bnd_Box& Box() const;
       Standard_EXPORT const TColStd_ListOfInteger& Indices() const;
 
     protected:
       Bnd_Box  myBox;
-      TColStd_MapOfInteger  myFence;
       TColStd_ListOfInteger myIndices;
       
   };
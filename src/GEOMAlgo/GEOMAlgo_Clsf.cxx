@@ -104,3 +104,32 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_Clsf, GEOMAlgo_HAlgo)
 {
   return Standard_True;
 }
+//=======================================================================
+//function : Classify
+//purpose  :
+//=======================================================================
+  Standard_Integer GEOMAlgo_Clsf::Classify(const TColgp_Array1OfPnt& thePnts,
+                                           GEOMAlgo_Array1OfState& theStates)
+{
+  Standard_Integer i, aNb;
+  //
+  aNb=0;
+  for (i=thePnts.Lower(); i<=thePnts.Upper(); ++i) {
+    SetPnt(thePnts(i));
+    Perform();
+    if (myErrorStatus) {
+      break;
+    }
+    theStates(i)=myState;
+    ++aNb;
+  }
+  return aNb;
+}
+//=======================================================================
+//function : IsThreadSafe
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_Clsf::IsThreadSafe() const
+{
+  return Standard_False;
+}
@@ -38,6 +38,8 @@
 #include <Standard_Boolean.hxx>
 #include <Geom_Curve.hxx>
 #include <Geom_Surface.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <GEOMAlgo_Array1OfState.hxx>
 
 DEFINE_STANDARD_HANDLE(GEOMAlgo_Clsf, GEOMAlgo_HAlgo)
 
@@ -69,6 +71,20 @@ class GEOMAlgo_Clsf : public GEOMAlgo_HAlgo
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Surface)& aST) const;
 
+  //! Classifies the points thePnts(i) into theStates(i);
+  //! theStates must have the bounds of thePnts.
+  //! Returns the number of points classified: the classification
+  //! stops at the first point that can not be classified.
+  //! The default implementation calls Perform() for each point.
+  Standard_EXPORT
+    virtual  Standard_Integer Classify(const TColgp_Array1OfPnt& thePnts,
+                                       GEOMAlgo_Array1OfState& theStates);
+
+  //! Returns true if Classify() leaves the classifier untouched,
+  //! so that it can be called from several threads at once.
+  Standard_EXPORT
+    virtual  Standard_Boolean IsThreadSafe() const;
+
   DEFINE_STANDARD_RTTIEXT(GEOMAlgo_Clsf,GEOMAlgo_HAlgo)
 
  protected:
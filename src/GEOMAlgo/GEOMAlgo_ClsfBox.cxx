@@ -44,6 +44,7 @@
 
 #include <TopExp.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TColStd_Array1OfInteger.hxx>
 
 #include <GEOMAlgo_SurfaceTools.hxx>
 
@@ -205,6 +206,76 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
   }
 }
 //=======================================================================
+//function : Classify
+//purpose  : the same as Perform() for each point, but the points
+//           are classified against one plane at a time
+//=======================================================================
+  Standard_Integer GEOMAlgo_ClsfBox::Classify(const TColgp_Array1OfPnt& thePnts,
+                                              GEOMAlgo_Array1OfState& theStates)
+{
+  const Standard_Integer aNbS=6;
+  Standard_Integer i, j, aLower, aUpper;
+  //
+  aLower=thePnts.Lower();
+  aUpper=thePnts.Upper();
+  //
+  GEOMAlgo_Array1OfState aStP(aLower, aUpper);
+  TColStd_Array1OfInteger aNbON(aLower, aUpper), aNbIN(aLower, aUpper);
+  // aNbIN(j)<0 - the state of the point j is already defined
+  aNbON.Init(0);
+  aNbIN.Init(0);
+  //
+  for(i=0; i<aNbS; i++) {
+    GEOMAlgo_SurfaceTools::GetState(thePnts, myGAS[i], myTolerance, aStP);
+    //
+    for (j=aLower; j<=aUpper; ++j) {
+      if (aNbIN(j)<0) {
+        continue;
+      }
+      //
+      switch (aStP(j)) {
+        case TopAbs_OUT:
+          theStates(j)=TopAbs_OUT;
+          aNbIN(j)=-1;
+          break;
+        case TopAbs_ON:
+          ++aNbON(j);
+          break;
+        case TopAbs_IN:
+          ++aNbIN(j);
+          break;
+        default:
+          theStates(j)=TopAbs_UNKNOWN;
+          aNbIN(j)=-1;
+          break;
+      }
+    }
+  }
+  //
+  for (j=aLower; j<=aUpper; ++j) {
+    if (aNbIN(j)<0) {
+      continue;
+    }
+    //
+    theStates(j)=TopAbs_UNKNOWN;
+    if (aNbON(j) && aNbIN(j)) {
+      theStates(j)=TopAbs_ON;
+    }
+    else if (aNbIN(j)==aNbS){
+      theStates(j)=TopAbs_IN;
+    }
+  }
+  return thePnts.Length();
+}
+//=======================================================================
+//function : IsThreadSafe
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfBox::IsThreadSafe() const
+{
+  return Standard_True;
+}
+//=======================================================================
 //function : CanBeON
 //purpose  :
 //=======================================================================
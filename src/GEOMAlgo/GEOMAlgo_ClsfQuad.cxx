@@ -31,6 +31,8 @@
 
 #include <Geom_Plane.hxx>
 
+#include <TColStd_Array1OfReal.hxx>
+
 IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfQuad, GEOMAlgo_Clsf)
 
 //=======================================================================
@@ -194,6 +196,78 @@ void GEOMAlgo_ClsfQuad::Perform()
   }
 }
 //=======================================================================
+//function : Classify
+//purpose  : the same as Perform() for each point, but the points
+//           are classified against one side plane at a time
+//=======================================================================
+Standard_Integer GEOMAlgo_ClsfQuad::Classify(const TColgp_Array1OfPnt& thePnts,
+                                             GEOMAlgo_Array1OfState& theStates)
+{
+  Standard_Integer j, aLower, aUpper;
+  //
+  aLower=thePnts.Lower();
+  aUpper=thePnts.Upper();
+  //
+  GEOMAlgo_Array1OfState aStP(aLower, aUpper);
+  // nbIn(j)<0 - the point j is ON, see Perform()
+  TColStd_Array1OfReal nbIn(aLower, aUpper);
+  nbIn.Init(0.);
+
+  for (size_t i = 0; i < myPlanes.size(); ++i) {
+    GEOMAlgo_SurfaceTools::GetState(thePnts, myPlanes[i], myTolerance, aStP);
+
+    const double aDIn = myConcaveSide[i] ? 0.5 : 1.0;
+    Handle(Geom_Plane) aSidePlane =
+      Handle(Geom_Plane)::DownCast(myPlanes[i].Surface());
+    gp_Vec aSideNorm = aSidePlane->Axis().Direction();
+    gp_Vec aSideVec = myQuadNormal ^ aSideNorm;
+
+    for (j = aLower; j <= aUpper; ++j) {
+      if (nbIn(j) < 0.) {
+        continue;
+      }
+
+      if (aStP(j) == TopAbs_IN) {
+        nbIn(j) += aDIn;
+      } else if (aStP(j) == TopAbs_ON) {
+        // check that aP is between quadrangle corners
+        const gp_Pnt& aP = thePnts(j);
+        gp_Vec c1p (myPoints[i], aP);
+        gp_Vec pc2 (aP, myPoints[i+1]);
+
+        if (aSideVec * c1p >= 0. && aSideVec * pc2 >= 0.) {
+          nbIn(j) = -1.;
+        }
+      }
+    }
+  }
+
+  Standard_Real inThreshold = myPlanes.size(); // usually 4.0
+
+  if (myConcaveQuad) {
+    inThreshold = 2.5; // 1.0 + 1.0 + 0.5
+  }
+
+  for (j = aLower; j <= aUpper; ++j) {
+    if (nbIn(j) < 0.) {
+      theStates(j) = TopAbs_ON;
+    } else if (nbIn(j) >= inThreshold) {
+      theStates(j) = TopAbs_IN;
+    } else {
+      theStates(j) = TopAbs_OUT;
+    }
+  }
+  return thePnts.Length();
+}
+//=======================================================================
+//function : IsThreadSafe
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ClsfQuad::IsThreadSafe() const
+{
+  return Standard_True;
+}
+//=======================================================================
 //function : CanBeON
 //purpose  :
 //=======================================================================
@@ -78,6 +78,13 @@ public:
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Surface)& aST) const;
 
+  Standard_EXPORT
+    virtual  Standard_Integer Classify(const TColgp_Array1OfPnt& thePnts,
+                                       GEOMAlgo_Array1OfState& theStates);
+
+  Standard_EXPORT
+    virtual  Standard_Boolean IsThreadSafe() const;
+
   DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ClsfQuad,GEOMAlgo_Clsf)
 
 protected:
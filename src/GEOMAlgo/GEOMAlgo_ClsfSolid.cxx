@@ -42,7 +42,6 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 :
   GEOMAlgo_Clsf()
 {
-  myPClsf=NULL;
 }
 //=======================================================================
 //function : ~
@@ -50,12 +49,7 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 //=======================================================================
   GEOMAlgo_ClsfSolid::~GEOMAlgo_ClsfSolid()
 {
-  if (myPClsf) {
-    BRepClass3d_SolidClassifier* pSC;
-    //
-    pSC=(BRepClass3d_SolidClassifier*)myPClsf;
-    delete pSC;
-  }
+  ClearClassifiers();
 }
 //=======================================================================
 //function : SetShape
@@ -81,10 +75,11 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 {
   myErrorStatus=0;
   //
-  BRepClass3d_SolidClassifier* pSC;
   TopAbs_ShapeEnum aType;
   BRep_Builder aBB;
-  TopoDS_Solid aS;
+  //
+  ClearClassifiers();
+  mySolid.Nullify();
   //
   if (myShape.IsNull()) {
     myErrorStatus=10; // mySolid=NULL
@@ -99,20 +94,14 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
   //
   //===
   if (aType==TopAbs_SOLID) {
-    aS=TopoDS::Solid(myShape);
+    mySolid=TopoDS::Solid(myShape);
   }
   else {
-    aBB.MakeSolid(aS);
-    aBB.Add(aS, myShape);
-  }
-  //
-  if (myPClsf) {
-    pSC=(BRepClass3d_SolidClassifier*)myPClsf;
-    delete pSC;
+    aBB.MakeSolid(mySolid);
+    aBB.Add(mySolid, myShape);
   }
   //
-  pSC=new BRepClass3d_SolidClassifier(aS);
-  myPClsf=pSC;
+  myClsfs.Append(new BRepClass3d_SolidClassifier(mySolid));
 }
 //=======================================================================
 //function : Perform
@@ -122,21 +111,96 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 {
   myErrorStatus=0;
   //
-  if (!myPClsf) {
+  if (mySolid.IsNull()) {
     myErrorStatus=11;
     return;
   }
   //
   BRepClass3d_SolidClassifier* pSC;
   //
-  pSC=(BRepClass3d_SolidClassifier*)myPClsf;
+  pSC=AcquireClassifier();
   pSC->Perform(myPnt, myTolerance);
   myState=pSC->State();
+  ReleaseClassifier(pSC);
+}
+//=======================================================================
+//function : Classify
+//purpose  :
+//=======================================================================
+  Standard_Integer GEOMAlgo_ClsfSolid::Classify
+  (const TColgp_Array1OfPnt& thePnts,
+   GEOMAlgo_Array1OfState& theStates)
+{
+  Standard_Integer i;
+  BRepClass3d_SolidClassifier* pSC;
+  //
+  if (mySolid.IsNull()) {
+    return 0;
+  }
+  //
+  pSC=AcquireClassifier();
+  for (i=thePnts.Lower(); i<=thePnts.Upper(); ++i) {
+    pSC->Perform(thePnts(i), myTolerance);
+    theStates(i)=pSC->State();
+  }
+  ReleaseClassifier(pSC);
+  //
+  return thePnts.Length();
+}
+//=======================================================================
+//function : IsThreadSafe
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfSolid::IsThreadSafe() const
+{
+  return Standard_True;
+}
+//=======================================================================
+//function : AcquireClassifier
+//purpose  : takes a free classifier from the pool or builds a new one
+//=======================================================================
+  BRepClass3d_SolidClassifier* GEOMAlgo_ClsfSolid::AcquireClassifier()
+{
+  BRepClass3d_SolidClassifier* pSC;
+  //
+  {
+    Standard_Mutex::Sentry aSentry(myMutex);
+    if (!myClsfs.IsEmpty()) {
+      pSC=myClsfs.First();
+      myClsfs.RemoveFirst();
+      return pSC;
+    }
+  }
+  //
+  pSC=new BRepClass3d_SolidClassifier(mySolid);
+  return pSC;
+}
+//=======================================================================
+//function : ReleaseClassifier
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfSolid::ReleaseClassifier
+  (BRepClass3d_SolidClassifier* theClsf)
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  myClsfs.Append(theClsf);
+}
+//=======================================================================
+//function : ClearClassifiers
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfSolid::ClearClassifiers()
+{
+  NCollection_List<BRepClass3d_SolidClassifier*>::Iterator aIt(myClsfs);
+  for (; aIt.More(); aIt.Next()) {
+    delete aIt.Value();
+  }
+  myClsfs.Clear();
 }
 //
 // myErrorStatus :
 //
 // 10 - mySolid=NULL
-// 11 - myPClsf=NULL
+// 11 - the solid is not prepared
 // 12 - unallowed type of myShape
 
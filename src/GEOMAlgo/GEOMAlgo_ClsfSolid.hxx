@@ -25,23 +25,24 @@
 #ifndef _GEOMAlgo_ClsfSolid_HeaderFile
 #define _GEOMAlgo_ClsfSolid_HeaderFile
 
-#include <Basics_OCCTVersion.hxx>
-
 #include <Standard.hxx>
 #include <Standard_DefineHandle.hxx>
+#include <Standard_Mutex.hxx>
 #include <TopoDS_Shape.hxx>
-#if OCC_VERSION_LARGE < 0x07080000
-#include <Standard_Address.hxx>
-#else
-#include <Standard_TypeDef.hxx>
-#endif
+#include <TopoDS_Solid.hxx>
+#include <NCollection_List.hxx>
 #include <GEOMAlgo_Clsf.hxx>
 
+class BRepClass3d_SolidClassifier;
+
 DEFINE_STANDARD_HANDLE(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 
 //=======================================================================
 //class : GEOMAlgo_ClsfSolid
-//purpose  :
+//purpose  : The solid is prepared once in CheckData() and is not
+//           changed after that. Each thread classifying the points
+//           takes a classifier from the pool and puts it back when
+//           it is done, so the classifiers are built once per thread.
 //=======================================================================
 class GEOMAlgo_ClsfSolid : public GEOMAlgo_Clsf
 {
@@ -64,11 +65,29 @@ class GEOMAlgo_ClsfSolid : public GEOMAlgo_Clsf
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    virtual  Standard_Integer Classify(const TColgp_Array1OfPnt& thePnts,
+                                       GEOMAlgo_Array1OfState& theStates);
+
+  Standard_EXPORT
+    virtual  Standard_Boolean IsThreadSafe() const;
+
   DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid,GEOMAlgo_Clsf)
 
   protected:
-    TopoDS_Shape myShape;
-  Standard_Address myPClsf;
+  Standard_EXPORT
+    BRepClass3d_SolidClassifier* AcquireClassifier() ;
+
+  Standard_EXPORT
+    void ReleaseClassifier(BRepClass3d_SolidClassifier* theClsf) ;
+
+  Standard_EXPORT
+    void ClearClassifiers() ;
+
+  TopoDS_Shape myShape;
+  TopoDS_Solid mySolid;
+  NCollection_List<BRepClass3d_SolidClassifier*> myClsfs;
+  Standard_Mutex myMutex;
 
 };
 #endif
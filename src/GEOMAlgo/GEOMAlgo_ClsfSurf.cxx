@@ -105,6 +105,24 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSurf, GEOMAlgo_Clsf)
   GEOMAlgo_SurfaceTools::GetState(myPnt, myGAS, myTolerance, myState);
 }
 //=======================================================================
+//function : Classify
+//purpose  :
+//=======================================================================
+  Standard_Integer GEOMAlgo_ClsfSurf::Classify(const TColgp_Array1OfPnt& thePnts,
+                                               GEOMAlgo_Array1OfState& theStates)
+{
+  GEOMAlgo_SurfaceTools::GetState(thePnts, myGAS, myTolerance, theStates);
+  return thePnts.Length();
+}
+//=======================================================================
+//function : IsThreadSafe
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfSurf::IsThreadSafe() const
+{
+  return Standard_True;
+}
+//=======================================================================
 //function : CanBeON
 //purpose  :
 //=======================================================================
@@ -33,7 +33,10 @@
 #include <BRepClass3d.hxx>
 #include <BRepTools.hxx>
 #include <BRepTools_WireExplorer.hxx>
+#include <NCollection_Array1.hxx>
 #include <NCollection_Sequence.hxx>
+#include <NCollection_Vector.hxx>
+#include <OSD_Parallel.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TColStd_MapOfInteger.hxx>
@@ -47,6 +50,44 @@
 #include <TopTools_MapOfShape.hxx>
 
 
+//=======================================================================
+//class    : GEOMAlgo_ExtractorFunctor
+//purpose  : Computes the modified shapes of one type. The shapes
+//           created for each shape are kept in its own list to be
+//           merged in the order of the shapes.
+//=======================================================================
+class GEOMAlgo_ExtractorFunctor
+{
+public:
+
+  GEOMAlgo_ExtractorFunctor
+          (GEOMAlgo_Extractor                             &theExtractor,
+           const TopAbs_ShapeEnum                          theType,
+           const NCollection_Vector<TopoDS_Shape>         &theShapes,
+                 NCollection_Array1<TopTools_ListOfShape> &theNewShapes)
+    : myExtractor (theExtractor),
+      myType      (theType),
+      myShapes    (theShapes),
+      myNewShapes (theNewShapes)
+  {
+  }
+
+  void operator()(const Standard_Integer theIndex) const
+  {
+    myExtractor.processShape(myShapes(theIndex), myType,
+                             &myNewShapes.ChangeValue(theIndex));
+  }
+
+private:
+
+  GEOMAlgo_Extractor                       &myExtractor;
+  TopAbs_ShapeEnum                          myType;
+  const NCollection_Vector<TopoDS_Shape>   &myShapes;
+  NCollection_Array1<TopTools_ListOfShape> &myNewShapes;
+
+};
+
+
 //=======================================================================
 //function : GEOMAlgo_Extractor
 //purpose  :
@@ -386,8 +427,9 @@ void GEOMAlgo_Extractor::markAncestorsModified(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_Extractor::processShapes(const TopAbs_ShapeEnum &theType)
 {
-  TopExp_Explorer     anExp(myShape, theType);
-  TopTools_MapOfShape aMapFence;
+  TopExp_Explorer                  anExp(myShape, theType);
+  TopTools_MapOfShape              aMapFence;
+  NCollection_Vector<TopoDS_Shape> aShapes;
 
   for (; anExp.More(); anExp.Next()) {
     TopoDS_Shape aShape = anExp.Current(); // Copy
@@ -400,28 +442,27 @@ void GEOMAlgo_Extractor::processShapes(const TopAbs_ShapeEnum &theType)
       }
 
       aShape.Orientation(TopAbs_FORWARD);
+      aShapes.Append(aShape);
+    }
+  }
 
-      switch(theType) {
-        case TopAbs_EDGE:
-          processEdge(aShape);
-          break;
-        case TopAbs_WIRE:
-          processWire(aShape);
-          break;
-        case TopAbs_FACE:
-        case TopAbs_SOLID:
-          processFOrSo(aShape);
-          break;
-        case TopAbs_SHELL:
-        case TopAbs_COMPSOLID:
-          processShOrCS(aShape);
-          break;
-        case TopAbs_COMPOUND:
-          processCompound(aShape);
-          break;
-        default:
-          break;
-      }
+  const Standard_Integer aNbShapes = aShapes.Length();
+  Standard_Integer       i;
+
+  if (myRunParallel && theType != TopAbs_COMPOUND && aNbShapes > 1) {
+    // The shapes of this type are independent. Create the new shapes
+    // concurrently, then merge them in the order of the shapes.
+    NCollection_Array1<TopTools_ListOfShape> aNewShapes(0, aNbShapes - 1);
+    GEOMAlgo_ExtractorFunctor aFunctor(*this, theType, aShapes, aNewShapes);
+
+    OSD_Parallel::For(0, aNbShapes, aFunctor, !myRunParallel);
+
+    for (i = 0; i < aNbShapes; ++i) {
+      mergeNewShapes(aShapes(i), aNewShapes(i));
+    }
+  } else {
+    for (i = 0; i < aNbShapes; ++i) {
+      processShape(aShapes(i), theType, NULL);
     }
   }
 
@@ -431,11 +472,43 @@ void GEOMAlgo_Extractor::processShapes(const TopAbs_ShapeEnum &theType)
   }
 }
 
+//=======================================================================
+//function : processShape
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::processShape(const TopoDS_Shape         &theShape,
+                                      const TopAbs_ShapeEnum      theType,
+                                            TopTools_ListOfShape *theNewShapes)
+{
+  switch(theType) {
+    case TopAbs_EDGE:
+      processEdge(theShape, theNewShapes);
+      break;
+    case TopAbs_WIRE:
+      processWire(theShape, theNewShapes);
+      break;
+    case TopAbs_FACE:
+    case TopAbs_SOLID:
+      processFOrSo(theShape, theNewShapes);
+      break;
+    case TopAbs_SHELL:
+    case TopAbs_COMPSOLID:
+      processShOrCS(theShape, theNewShapes);
+      break;
+    case TopAbs_COMPOUND:
+      processCompound(theShape);
+      break;
+    default:
+      break;
+  }
+}
+
 //=======================================================================
 //function : processEdge
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
+void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape         &theEdge,
+                                           TopTools_ListOfShape *theNewShapes)
 {
   TopoDS_Iterator      anIter(theEdge);
   TopTools_MapOfShape  aMapFence;
@@ -460,7 +533,7 @@ void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
     }
   }
 
-  TopoDS_Shape aNewEdge = makeShape(theEdge, aVtxList);
+  TopoDS_Shape aNewEdge = makeShape(theEdge, aVtxList, theNewShapes);
 
   myMapModified.ChangeFind(theEdge).Append(aNewEdge);
 }
@@ -469,7 +542,8 @@ void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
 //function : processWire
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
+void GEOMAlgo_Extractor::processWire(const TopoDS_Shape         &theWire,
+                                           TopTools_ListOfShape *theNewShapes)
 {
   // Get parent face for the wire.
   TopoDS_Face aFace;
@@ -531,7 +605,7 @@ void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
   if (!aListListEdges.IsEmpty()) {
     TopTools_ListOfShape aListWires;
 
-    makeWires(theWire, aListListEdges, aListWires);
+    makeWires(theWire, aListListEdges, aListWires, theNewShapes);
     myMapModified.ChangeFind(theWire) = aListWires;
   }
 }
@@ -540,7 +614,8 @@ void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
 //function : processFOrSo
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
+void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape         &theFOrSo,
+                                            TopTools_ListOfShape *theNewShapes)
 {
   Standard_Boolean     isToCreate = Standard_True;
   TopTools_ListOfShape aClosedSubShapes;
@@ -653,7 +728,8 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
 
   if (isToCreate) {
     // Create a new shape.
-    TopoDS_Shape aNewShape = makeShape(theFOrSo, aClosedSubShapes);
+    TopoDS_Shape aNewShape =
+      makeShape(theFOrSo, aClosedSubShapes, theNewShapes);
 
     aNewShapes.Prepend(aNewShape);
   }
@@ -668,7 +744,8 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
 //function : processShOrCS
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
+void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape         &theShOrCS,
+                                             TopTools_ListOfShape *theNewShapes)
 {
   // Treat sub-shapes.
   TopoDS_Iterator      anIter(theShOrCS);
@@ -718,7 +795,7 @@ void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
   // Group sub-shapes via bounds
   TopTools_ListOfShape aNewShapes;
 
-  groupViaBounds(theShOrCS, aNewSubShapes, aNewShapes);
+  groupViaBounds(theShOrCS, aNewSubShapes, aNewShapes, theNewShapes);
   aNewOtherShapes.Prepend(aNewShapes);
 
   if (!aNewOtherShapes.IsEmpty()) {
@@ -891,9 +968,14 @@ TopoDS_Shape GEOMAlgo_Extractor::oriented(const TopoDS_Shape &theShape,
 //=======================================================================
 TopoDS_Shape GEOMAlgo_Extractor::makeShape
                         (const TopoDS_Shape         &theShape,
-                         const TopTools_ListOfShape &theSubShapes)
+                         const TopTools_ListOfShape &theSubShapes,
+                               TopTools_ListOfShape *theNewShapes)
 {
-  TopoDS_Shape aResult = getShapeFromSubShapes(theShape, theSubShapes);
+  TopoDS_Shape aResult;
+
+  if (theNewShapes == NULL) {
+    aResult = getShapeFromSubShapes(theShape, theSubShapes);
+  }
 
   if (aResult.IsNull()) {
     // Create a new shape.
@@ -910,6 +992,11 @@ TopoDS_Shape GEOMAlgo_Extractor::makeShape
       if (aMapFence.Add(aSubShape)) {
         aBuilder.Add(aResult, aSubShape);
 
+        if (theNewShapes != NULL) {
+          // The map is filled by mergeNewShapes.
+          continue;
+        }
+
         // Fill the map of new shape - ancestors.
         if (!myMapNewShapeAnc.IsBound(aSubShape)) {
           myMapNewShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
@@ -918,11 +1005,72 @@ TopoDS_Shape GEOMAlgo_Extractor::makeShape
         myMapNewShapeAnc.ChangeFind(aSubShape).Append(aResult);
       }
     }
+
+    if (theNewShapes != NULL) {
+      theNewShapes->Append(aResult);
+    }
   }
 
   return aResult;
 }
 
+//=======================================================================
+//function : mergeNewShapes
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::mergeNewShapes
+                        (const TopoDS_Shape         &theShape,
+                         const TopTools_ListOfShape &theNewShapes)
+{
+  TopTools_ListIteratorOfListOfShape anIter(theNewShapes);
+
+  for (; anIter.More(); anIter.Next()) {
+    const TopoDS_Shape   &aNewShape = anIter.Value();
+    TopoDS_Iterator       aSubShIt(aNewShape);
+    TopTools_ListOfShape  aSubShapes;
+
+    // The sub-shapes of the new shape are the ones passed to makeShape
+    // without duplicates, the first one is the same.
+    for (; aSubShIt.More(); aSubShIt.Next()) {
+      aSubShapes.Append(aSubShIt.Value());
+    }
+
+    if (aSubShapes.IsEmpty()) {
+      continue;
+    }
+
+    const TopoDS_Shape aSameShape =
+      getShapeFromSubShapes(aNewShape, aSubShapes);
+
+    if (aSameShape.IsNull()) {
+      // Fill the map of new shape - ancestors.
+      TopTools_ListIteratorOfListOfShape aSubIt(aSubShapes);
+
+      for (; aSubIt.More(); aSubIt.Next()) {
+        const TopoDS_Shape &aSubShape = aSubIt.Value();
+
+        if (!myMapNewShapeAnc.IsBound(aSubShape)) {
+          myMapNewShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
+        }
+
+        myMapNewShapeAnc.ChangeFind(aSubShape).Append(aNewShape);
+      }
+    } else {
+      // The same shape is created before. Use it instead of the new one.
+      TopTools_ListIteratorOfListOfShape
+                          aModifIt(myMapModified.ChangeFind(theShape));
+
+      for (; aModifIt.More(); aModifIt.Next()) {
+        TopoDS_Shape &aModifShape = aModifIt.ChangeValue();
+
+        if (aModifShape.IsSame(aNewShape)) {
+          aModifShape = oriented(aSameShape, aModifShape);
+        }
+      }
+    }
+  }
+}
+
 //=======================================================================
 //function : getShapeFromSubShapes
 //purpose  :
@@ -1218,7 +1366,8 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonFaces
 void GEOMAlgo_Extractor::makeWires
             (const TopoDS_Shape                           &theWire,
                    NCollection_List<TopTools_ListOfShape> &theListListEdges,
-                   TopTools_ListOfShape                   &theWires)
+                   TopTools_ListOfShape                   &theWires,
+                   TopTools_ListOfShape                   *theNewShapes)
 {
   if (theListListEdges.Size() > 1) {
     // Check if it is possible to merge first and last lists of edges.
@@ -1246,7 +1395,8 @@ void GEOMAlgo_Extractor::makeWires
 
   for (;anIter.More(); anIter.Next()) {
     const TopTools_ListOfShape &anEdges       = anIter.Value();
-    TopoDS_Shape                aNewWireShape = makeShape(theWire, anEdges);
+    TopoDS_Shape                aNewWireShape =
+      makeShape(theWire, anEdges, theNewShapes);
     TopoDS_Wire                 aNewWire      = TopoDS::Wire(aNewWireShape);
     TopoDS_Vertex               aV[2];
 
@@ -1267,7 +1417,8 @@ void GEOMAlgo_Extractor::makeWires
 void GEOMAlgo_Extractor::groupViaBounds
                        (const TopoDS_Shape         &theShape,
                         const TopTools_ListOfShape &theSubShapes,
-                              TopTools_ListOfShape &theNewShapes)
+                              TopTools_ListOfShape &theNewShapes,
+                              TopTools_ListOfShape *theCreated)
 {
   const Standard_Boolean isShell = theShape.ShapeType() == TopAbs_SHELL;
   TopAbs_ShapeEnum       aBoundType;
@@ -1374,7 +1525,8 @@ void GEOMAlgo_Extractor::groupViaBounds
       // Avoid creation of comp-solid with a single solid.
       aNewSubShapes.Append(aListSubShapes.First());
     } else {
-      TopoDS_Shape aNewShape = makeShape(theShape, aListSubShapes);
+      TopoDS_Shape aNewShape =
+        makeShape(theShape, aListSubShapes, theCreated);
 
       if (aBounds.Value(i).IsEmpty()) {
         // This is a closed shape.
@@ -169,39 +169,62 @@ private:
 
   /**
    * \brief This method performs computation of modified shapes of
-   *  the provided type.
+   *  the provided type. The shapes of one type (except compounds that
+   *  can contain compounds) are independent, so in parallel mode they
+   *  are computed in parallel and the new shapes are merged in order.
    *
    * \param theType the processed shape type.
    */
   void processShapes(const TopAbs_ShapeEnum &theType);
 
+  /**
+   * \brief This method performs computation of a modified shape of
+   * the provided type.
+   *
+   * \param theShape the modified shape (should be forward).
+   * \param theType the shape type.
+   * \param theNewShapes the list of created shapes to be merged by
+   *        mergeNewShapes() or NULL. Output parameter.
+   */
+  void processShape(const TopoDS_Shape         &theShape,
+                    const TopAbs_ShapeEnum      theType,
+                          TopTools_ListOfShape *theNewShapes);
+
   /**
    * \brief This method performs computation of a modified edge. 
    *
    * \param theEdge the modified edge (should be forward).
+   * \param theNewShapes the list of created shapes or NULL (see makeShape).
    */
-  void processEdge(const TopoDS_Shape &theEdge);
+  void processEdge(const TopoDS_Shape         &theEdge,
+                         TopTools_ListOfShape *theNewShapes);
 
   /**
    * \brief This method performs computation of a modified wire.
    *
    * \param theWire the modified wire (should be forward).
+   * \param theNewShapes the list of created shapes or NULL (see makeShape).
    */
-  void processWire(const TopoDS_Shape &theWire);
+  void processWire(const TopoDS_Shape         &theWire,
+                         TopTools_ListOfShape *theNewShapes);
 
   /**
    * \brief This method performs computation of a modified face or solid.
    *
    * \param theFOrSo the modified face or solid (should be forward).
+   * \param theNewShapes the list of created shapes or NULL (see makeShape).
    */
-  void processFOrSo(const TopoDS_Shape &theFOrSo);
+  void processFOrSo(const TopoDS_Shape         &theFOrSo,
+                          TopTools_ListOfShape *theNewShapes);
 
   /**
    * \brief This method performs computation of a modified shell or comp-solid.
    *
    * \param theShOrCS the modified shell or comp-solid (should be forward).
+   * \param theNewShapes the list of created shapes or NULL (see makeShape).
    */
-  void processShOrCS(const TopoDS_Shape &theShOrCS);
+  void processShOrCS(const TopoDS_Shape         &theShOrCS,
+                           TopTools_ListOfShape *theNewShapes);
 
   /**
    * \brief This method performs computation of a modified compound.
@@ -234,10 +257,27 @@ private:
    *
    * \param theShape the shape to be copied (should be forward).
    * \param theSubShapes the sub-shapes (should be oriented correctly).
+   * \param theNewShapes if it is not NULL, the shape is always created
+   *        and appended to theNewShapes; the search of the same shape
+   *        and the filling of myMapNewShapeAnc are left to
+   *        mergeNewShapes(). It allows to make shapes concurrently.
    * \return the modified shape.
    */
   TopoDS_Shape makeShape(const TopoDS_Shape         &theShape,
-                         const TopTools_ListOfShape &theSubShapes);
+                         const TopTools_ListOfShape &theSubShapes,
+                               TopTools_ListOfShape *theNewShapes = NULL);
+
+  /**
+   * \brief This method merges the shapes created for theShape by
+   * makeShape() with theNewShapes: a created shape is replaced in
+   * myMapModified by the same shape created before (if any), otherwise
+   * it is added to myMapNewShapeAnc.
+   *
+   * \param theShape the modified shape.
+   * \param theNewShapes the shapes created for theShape.
+   */
+  void mergeNewShapes(const TopoDS_Shape         &theShape,
+                      const TopTools_ListOfShape &theNewShapes);
 
   /**
    * \brief This method returns the shape from the list of sub-shapes
@@ -309,10 +349,12 @@ private:
    * \param theListListEdges the list of list of edges. Can be modified
    *        on output.
    * \param theWires the list of created wires. Output parameter.
+   * \param theNewShapes the list of created shapes or NULL (see makeShape).
    */
   void makeWires(const TopoDS_Shape                           &theWire,
                        NCollection_List<TopTools_ListOfShape> &theListListEdges,
-                       TopTools_ListOfShape                   &theWires);
+                       TopTools_ListOfShape                   &theWires,
+                       TopTools_ListOfShape                   *theNewShapes = NULL);
 
   /**
    * \brief This method collects the shapes in theShapes via common bounds.
@@ -324,10 +366,12 @@ private:
    * \param theShape the original shape.
    * \param theSubShapes the list of shapes to be connected.
    * \param theNewShapes the list of newly created shapes. Output parameter.
+   * \param theCreated the list of created shapes or NULL (see makeShape).
    */
   void groupViaBounds(const TopoDS_Shape         &theShape,
                       const TopTools_ListOfShape &theSubShapes,
-                            TopTools_ListOfShape &theNewShapes);
+                            TopTools_ListOfShape &theNewShapes,
+                            TopTools_ListOfShape *theCreated = NULL);
 
   /**
    * \brief This method returns the list of modified shapes obtained
@@ -357,6 +401,8 @@ protected:
   TopTools_DataMapOfShapeListOfShape myMapModified;
   TopTools_DataMapOfShapeListOfShape myMapNewShapeAnc;
 
+  friend class GEOMAlgo_ExtractorFunctor;
+
 };
 
 #endif
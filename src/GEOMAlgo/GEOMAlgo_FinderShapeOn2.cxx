@@ -70,6 +70,150 @@
 #include <TopoDS_Vertex.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <IntTools_Context.hxx>
+#include <BOPTools_Parallel.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_PointsClassifier
+//purpose  : classifies the inner points of a sub-shape and collects
+//           their states; the points are classified in blocks of
+//           growing size, so that few points are classified in vain
+//           when the collector asks to break
+//=======================================================================
+class GEOMAlgo_PointsClassifier
+{
+ public:
+  GEOMAlgo_PointsClassifier()
+  :
+    myNbPntsMax(0),
+    myIsFixed(Standard_False),
+    myFixedState(TopAbs_UNKNOWN),
+    myErrorStatus(0),
+    myNbCalls(0),
+    myNbClassified(0)
+  {}
+  //
+  void SetShape(const TopoDS_Shape& theS)
+  {
+    myShape=theS;
+  }
+  //
+  const TopoDS_Shape& Shape() const
+  {
+    return myShape;
+  }
+  //
+  void SetClsf(const Handle(GEOMAlgo_Clsf)& theClsf)
+  {
+    myClsf=theClsf;
+  }
+  //
+  void SetNbPntsMax(const Standard_Integer theNb)
+  {
+    myNbPntsMax=theNb;
+  }
+  //
+  void SetStateCollector(const GEOMAlgo_StateCollector& theSC)
+  {
+    mySC=theSC;
+  }
+  //
+  GEOMAlgo_ListOfPnt& ChangePoints()
+  {
+    return myLP;
+  }
+  //
+  // The state of the shape is known, nothing to classify
+  void SetFixedState(const TopAbs_State theSt)
+  {
+    myIsFixed=Standard_True;
+    myFixedState=theSt;
+  }
+  //
+  Standard_Boolean IsFixed() const
+  {
+    return myIsFixed;
+  }
+  //
+  TopAbs_State State() const
+  {
+    return myIsFixed ? myFixedState : mySC.State();
+  }
+  //
+  Standard_Integer ErrorStatus() const
+  {
+    return myErrorStatus;
+  }
+  //
+  // The number of calls of the classifier
+  Standard_Integer NbCalls() const
+  {
+    return myNbCalls;
+  }
+  //
+  // The number of the points classified
+  Standard_Integer NbClassified() const
+  {
+    return myNbClassified;
+  }
+  //
+  void Perform()
+  {
+    Standard_Integer i, aNb, aNbBlock, aNbDone;
+    GEOMAlgo_ListIteratorOfListOfPnt aIt;
+    //
+    myErrorStatus=0;
+    myNbCalls=0;
+    myNbClassified=0;
+    if (myIsFixed) {
+      return;
+    }
+    //
+    aNb=myLP.Extent();
+    if (myNbPntsMax && aNb>myNbPntsMax+1) {
+      aNb=myNbPntsMax+1;
+    }
+    //
+    aIt.Initialize(myLP);
+    for (aNbBlock=8; aNb>0; aNbBlock*=2) {
+      if (aNbBlock>aNb) {
+        aNbBlock=aNb;
+      }
+      aNb-=aNbBlock;
+      //
+      TColgp_Array1OfPnt aPnts(1, aNbBlock);
+      GEOMAlgo_Array1OfState aStates(1, aNbBlock);
+      //
+      for (i=1; i<=aNbBlock; ++i, aIt.Next()) {
+        aPnts(i)=aIt.Value();
+      }
+      //
+      aNbDone=myClsf->Classify(aPnts, aStates);
+      ++myNbCalls;
+      myNbClassified+=aNbBlock;
+      for (i=1; i<=aNbBlock; ++i) {
+        if (i>aNbDone) {
+          myErrorStatus=40; // point can not be classified
+          return;
+        }
+        if (mySC.AppendState(aStates(i))) {
+          return;
+        }
+      }
+    }
+  }
+  //
+ protected:
+  TopoDS_Shape myShape;
+  Handle(GEOMAlgo_Clsf) myClsf;
+  Standard_Integer myNbPntsMax;
+  Standard_Boolean myIsFixed;
+  TopAbs_State myFixedState;
+  Standard_Integer myErrorStatus;
+  Standard_Integer myNbCalls;
+  Standard_Integer myNbClassified;
+  GEOMAlgo_ListOfPnt myLP;
+  GEOMAlgo_StateCollector mySC;
+};
 
 //=======================================================================
 //function : 
@@ -211,6 +355,7 @@ void GEOMAlgo_FinderShapeOn2::Perform()
   myWarningStatus=0;
   myLS.Clear();
   myMSS.Clear();
+  myProfile.Clear();
   //
   CheckData();
   if(myErrorStatus) {
@@ -300,6 +445,7 @@ void GEOMAlgo_FinderShapeOn2::CheckData()
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::ProcessVertices()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "ProcessVertices");
   myErrorStatus=0;
   //
   Standard_Boolean bIsConformState;
@@ -310,6 +456,9 @@ void GEOMAlgo_FinderShapeOn2::ProcessVertices()
   //
   TopExp::MapShapes(myShape, TopAbs_VERTEX, aM);
   aNb=aM.Extent();
+  // one call per vertex, the last one may fail
+  myProfile.AddCount("ClassifierCalls", aNb);
+  myProfile.AddCount("ClassifiedPoints", aNb);
   for (i=1; i<=aNb; ++i) {
     const TopoDS_Vertex& aV=TopoDS::Vertex(aM(i));
     aP=BRep_Tool::Pnt(aV);
@@ -341,14 +490,15 @@ void GEOMAlgo_FinderShapeOn2::ProcessVertices()
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::ProcessEdges()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "ProcessEdges");
   myErrorStatus=0;
   //
-  Standard_Boolean bIsConformState, bIsToBreak;
-  Standard_Integer i, aNb, iCnt, iErr;
+  Standard_Boolean bIsConformState;
+  Standard_Integer i, aNb;
   TopAbs_State aSt = TopAbs_UNKNOWN; // todo: aSt must be explicitly initilized to avoid warning (see below)
   TopTools_IndexedMapOfShape aM;
   TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
+  GEOMAlgo_VectorOfPointsClassifier aVPC;
   //
   TopExp::MapShapes(myShape, TopAbs_EDGE, aM);
   aNb=aM.Extent();
@@ -379,7 +529,9 @@ void GEOMAlgo_FinderShapeOn2::ProcessEdges()
     }
     //
     if (BRep_Tool::Degenerated(aE)) {
-      myMSS.Add(aE, aSt); // todo: aSt must be explicitly initilized to avoid warning (see above)
+      GEOMAlgo_PointsClassifier& aPC=aVPC.Appended();
+      aPC.SetShape(aE);
+      aPC.SetFixedState(aSt); // todo: aSt must be explicitly initilized to avoid warning (see above)
       continue;
     }
     //
@@ -397,48 +549,16 @@ void GEOMAlgo_FinderShapeOn2::ProcessEdges()
     //
     InnerPoints(aE, aLP);
     if (myErrorStatus) {
-      return;
+      break;
     }
     //
-    bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
-      if (myNbPntsMax) {
-        if (iCnt > myNbPntsMax) {
-          break;
-        }
-      }
-      //
-      const gp_Pnt& aP=aIt.Value();
-      //
-      myClsf->SetPnt(aP);
-      myClsf->Perform();
-      iErr=myClsf->ErrorStatus();
-      if (iErr) {
-        myErrorStatus=40; // point can not be classified
-        return;
-      }
-      //
-      aSt=myClsf->State();
-      //
-      bIsToBreak=aSC.AppendState(aSt);
-      if (bIsToBreak) {
-        break;
-      }
-    }
-    //
-    aSt=aSC.State();
-    //
-    bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
-    if (myShapeType==TopAbs_EDGE) {
-      if (bIsConformState) {
-        myMSS.Add(aE, aSt);
-      }
-    }
-    else if (bIsConformState || aSt==TopAbs_ON) {
-      myMSS.Add(aE, aSt);
-    }
+    GEOMAlgo_PointsClassifier& aPC=aVPC.Appended();
+    aPC.SetShape(aE);
+    aPC.SetStateCollector(aSC);
+    aPC.ChangePoints().Append(aLP);
   } //  for (i=1; i<=aNb; ++i) next edge
+  //
+  ClassifyPoints(aVPC, TopAbs_EDGE);
 }
 //=======================================================================
 //function : ProcessFaces
@@ -446,15 +566,19 @@ void GEOMAlgo_FinderShapeOn2::ProcessEdges()
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::ProcessFaces()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "ProcessFaces");
   myErrorStatus=0;
   //
-  Standard_Boolean bIsConformState, bIsToBreak, bCanBeON;
-  Standard_Integer i, aNbF, iCnt, iErr;
+  Standard_Boolean bIsConformState, bCanBeON;
+  Standard_Integer i, aNbF;
   TopAbs_State aSt;
   TopTools_IndexedMapOfShape aM;
   TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
+  GEOMAlgo_VectorOfPointsClassifier aVPC;
   //
+  // The inner points are computed sequentially, as the meshing
+  // changes the triangulations shared by adjacent faces;
+  // the points are classified in parallel then.
   TopExp::MapShapes(myShape, TopAbs_FACE, aM);
   aNbF=aM.Extent();
   for (i=1; i<=aNbF; ++i) {
@@ -495,48 +619,74 @@ void GEOMAlgo_FinderShapeOn2::ProcessFaces()
     //
     InnerPoints(aF, aLP);
     if (myErrorStatus) {
-      return;
+      break;
     }
     //
-    bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
-      if (myNbPntsMax) {
-        if (iCnt > myNbPntsMax) {
-          break;
-        }
-      }
-      //
-      const gp_Pnt& aP=aIt.Value();
-      //
-      myClsf->SetPnt(aP);
-      myClsf->Perform();
-      iErr=myClsf->ErrorStatus();
-      if (iErr) {
-        myErrorStatus=40; // point can not be classified
-        return;
-      }
-      //
-      aSt=myClsf->State();
-      //
-      bIsToBreak=aSC.AppendState(aSt);
-      if (bIsToBreak) {
-        break;
-      }
+    GEOMAlgo_PointsClassifier& aPC=aVPC.Appended();
+    aPC.SetShape(aF);
+    aPC.SetStateCollector(aSC);
+    aPC.ChangePoints().Append(aLP);
+  }//  for (i=1; i<=aNb; ++i) next face
+  //
+  ClassifyPoints(aVPC, TopAbs_FACE);
+}
+//=======================================================================
+//function : ClassifyPoints
+//purpose  : classifies the points of the sub-shapes in one batch
+//           and fills myMSS in the order of the sub-shapes
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::ClassifyPoints
+  (GEOMAlgo_VectorOfPointsClassifier& theVPC,
+   const TopAbs_ShapeEnum theType)
+{
+  Standard_Boolean bIsConformState, bRunParallel;
+  Standard_Integer i, aNb, iErr;
+  TopAbs_State aSt;
+  //
+  // the error of the sub-shape following the collected ones
+  iErr=myErrorStatus;
+  myErrorStatus=0;
+  //
+  aNb=theVPC.Length();
+  for (i=0; i<aNb; ++i) {
+    GEOMAlgo_PointsClassifier& aPC=theVPC(i);
+    aPC.SetClsf(myClsf);
+    aPC.SetNbPntsMax(myNbPntsMax);
+  }
+  //
+  bRunParallel=myRunParallel && myClsf->IsThreadSafe();
+  BOPTools_Parallel::Perform(bRunParallel, theVPC);
+  //
+  for (i=0; i<aNb; ++i) {
+    const GEOMAlgo_PointsClassifier& aPC=theVPC(i);
+    const TopoDS_Shape& aS=aPC.Shape();
+    //
+    myProfile.AddCount("ClassifierCalls", aPC.NbCalls());
+    myProfile.AddCount("ClassifiedPoints", aPC.NbClassified());
+    //
+    if (aPC.ErrorStatus()) {
+      myErrorStatus=aPC.ErrorStatus();
+      return;
     }
     //
-    aSt=aSC.State();
+    aSt=aPC.State();
+    if (aPC.IsFixed()) {
+      myMSS.Add(aS, aSt);
+      continue;
+    }
     //
     bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
-    if (myShapeType==TopAbs_FACE) {
+    if (myShapeType==theType) {
       if (bIsConformState) {
-        myMSS.Add(aF, aSt);
+        myMSS.Add(aS, aSt);
       }
     }
     else if (bIsConformState || aSt==TopAbs_ON) {
-      myMSS.Add(aF, aSt);
+      myMSS.Add(aS, aSt);
     }
-  }//  for (i=1; i<=aNb; ++i) next face
+  }
+  //
+  myErrorStatus=iErr;
 }
 //=======================================================================
 //function : ProcessSolids
@@ -544,6 +694,7 @@ void GEOMAlgo_FinderShapeOn2::ProcessFaces()
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::ProcessSolids()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "ProcessSolids");
   myErrorStatus=0;
   //
   Standard_Boolean bIsConformState;
@@ -45,6 +45,12 @@
 #include <GEOMAlgo_Clsf.hxx>
 #include <GEOMAlgo_ShapeAlgo.hxx>
 
+#include <NCollection_Vector.hxx>
+
+class GEOMAlgo_PointsClassifier;
+typedef NCollection_Vector<GEOMAlgo_PointsClassifier>
+  GEOMAlgo_VectorOfPointsClassifier;
+
 //=======================================================================
 //function : GEOMAlgo_FinderShapeOn2
 //purpose  :
@@ -113,6 +119,10 @@ protected:
   Standard_EXPORT
     void ProcessSolids() ;
 
+  Standard_EXPORT
+    void ClassifyPoints(GEOMAlgo_VectorOfPointsClassifier& theVPC,
+                        const TopAbs_ShapeEnum theType) ;
+
   Standard_EXPORT
     void InnerPoints(const TopoDS_Face& aF,
                      GEOMAlgo_ListOfPnt& aLP) ;
@@ -0,0 +1,144 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_GPropsCache.cxx
+
+#include <GEOMAlgo_GPropsCache.hxx>
+
+#include <BRepGProp.hxx>
+#include <Standard_OutOfRange.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_GPropsCache, Standard_Transient)
+
+//=======================================================================
+//function : GEOMAlgo_GPropsCache
+//purpose  :
+//=======================================================================
+GEOMAlgo_GPropsCache::GEOMAlgo_GPropsCache()
+:
+  myNbHits(0),
+  myNbMisses(0)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_GPropsCache::~GEOMAlgo_GPropsCache()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::Clear()
+{
+  Standard_Integer i;
+  //
+  for (i=0; i<3; ++i) {
+    myMaps[i].Clear();
+  }
+  myNbHits=0;
+  myNbMisses=0;
+}
+//=======================================================================
+//function : NbHits
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GPropsCache::NbHits() const
+{
+  return myNbHits;
+}
+//=======================================================================
+//function : NbMisses
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GPropsCache::NbMisses() const
+{
+  return myNbMisses;
+}
+//=======================================================================
+//function : HitRate
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_GPropsCache::HitRate() const
+{
+  Standard_Integer aNb;
+  //
+  aNb=myNbHits+myNbMisses;
+  return aNb ? (Standard_Real)myNbHits/aNb : 0.;
+}
+//=======================================================================
+//function : Properties
+//purpose  :
+//=======================================================================
+const GProp_GProps& GEOMAlgo_GPropsCache::Properties
+  (const TopoDS_Shape& theS,
+   const Standard_Integer theDim)
+{
+  Standard_Boolean bOnlyClosed;
+  //
+  Standard_OutOfRange_Raise_if(theDim<1 || theDim>3,
+                               "GEOMAlgo_GPropsCache::Properties");
+  //
+  GEOMAlgo_DataMapOfShapeGProps& aMap=myMaps[theDim-1];
+  const GProp_GProps* pProps=aMap.Seek(theS);
+  if (pProps) {
+    ++myNbHits;
+    return *pProps;
+  }
+  //
+  ++myNbMisses;
+  GProp_GProps aProps;
+  //
+  if (theDim==1) {
+    BRepGProp::LinearProperties(theS, aProps);
+  }
+  else if (theDim==2) {
+    BRepGProp::SurfaceProperties(theS, aProps);
+  }
+  else {
+    bOnlyClosed=Standard_False;
+    BRepGProp::VolumeProperties(theS, aProps, bOnlyClosed);
+  }
+  //
+  return *aMap.Bound(theS, aProps);
+}
+//=======================================================================
+//function : AddProperties
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::AddProperties(const TopTools_ListOfShape& theLS,
+                                         const Standard_Integer theDim,
+                                         GProp_GProps& theProps)
+{
+  Standard_Real aDensity;
+  TopTools_ListIteratorOfListOfShape aIt;
+  //
+  aDensity=1.;
+  aIt.Initialize(theLS);
+  for (; aIt.More(); aIt.Next()) {
+    const TopoDS_Shape& aS=aIt.Value();
+    theProps.Add(Properties(aS, theDim), aDensity);
+  }
+}
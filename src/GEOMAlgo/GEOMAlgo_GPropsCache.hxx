@@ -0,0 +1,101 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_GPropsCache.hxx
+
+#ifndef _GEOMAlgo_GPropsCache_HeaderFile
+#define _GEOMAlgo_GPropsCache_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+
+#include <GProp_GProps.hxx>
+#include <NCollection_DataMap.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopTools_OrientedShapeMapHasher.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_GPropsCache, Standard_Transient)
+
+typedef NCollection_DataMap<TopoDS_Shape,
+                            GProp_GProps,
+                            TopTools_OrientedShapeMapHasher>
+  GEOMAlgo_DataMapOfShapeGProps;
+
+//=======================================================================
+//class    : GEOMAlgo_GPropsCache
+//purpose  : Cache of the linear, surface and volume properties
+//           of the shapes (see BRepGProp).
+//           The properties are kept per shape, i.e. per TShape,
+//           location and orientation, so that the properties of
+//           a list of shapes are summed up from the cached ones.
+//=======================================================================
+class GEOMAlgo_GPropsCache : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_GPropsCache();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_GPropsCache();
+
+  //! Returns the properties of the shape <theS> of the
+  //! dimension <theDim>: 1 - linear, 2 - surface, 3 - volume.
+  Standard_EXPORT
+    const GProp_GProps& Properties(const TopoDS_Shape& theS,
+                                   const Standard_Integer theDim);
+
+  //! Adds the properties of each shape of <theLS> of the
+  //! dimension <theDim> to <theProps>.
+  Standard_EXPORT
+    void AddProperties(const TopTools_ListOfShape& theLS,
+                       const Standard_Integer theDim,
+                       GProp_GProps& theProps);
+
+  //! Clears the cache and the counters
+  Standard_EXPORT
+    void Clear();
+
+  //! Returns the number of the requests served from the cache
+  Standard_EXPORT
+    Standard_Integer NbHits() const;
+
+  //! Returns the number of the computed properties
+  Standard_EXPORT
+    Standard_Integer NbMisses() const;
+
+  //! Returns the ratio of the requests served from the cache
+  Standard_EXPORT
+    Standard_Real HitRate() const;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_GPropsCache, Standard_Transient)
+
+ protected:
+  GEOMAlgo_DataMapOfShapeGProps myMaps[3];
+  Standard_Integer myNbHits;
+  Standard_Integer myNbMisses;
+};
+
+#endif
@@ -26,9 +26,9 @@
 #include <GEOMAlgo_GetInPlace.hxx>
 
 
-#include <NCollection_UBTreeFiller.hxx>
 
 #include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
 #include <gp_Pnt.hxx>
 
 #include <TColStd_ListOfInteger.hxx>
@@ -60,14 +60,169 @@
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 #include <TopTools_MapOfShape.hxx>
 #include <TopTools_MapIteratorOfMapOfShape.hxx>
+#include <TColStd_MapOfInteger.hxx>
+
+#include <BOPTools_Parallel.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_List.hxx>
+#include <NCollection_Vector.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Mutex.hxx>
 
 #include <GEOMAlgo_BoxBndTree.hxx>
 #include <GEOMAlgo_CoupleOfShapes.hxx>
 
+#include <algorithm>
+#include <vector>
+
+
+//=======================================================================
+//class    : GEOMAlgo_GPropsCachePool
+//purpose  : The caches of mass properties of PerformList: a cache is
+//           taken by one search at a time, so the searches running in
+//           parallel use their own caches (GEOMAlgo_GPropsCache is not
+//           thread-safe) and the searches running one after another
+//           share one cache
+//=======================================================================
+class GEOMAlgo_GPropsCachePool
+{
+ public:
+  GEOMAlgo_GPropsCachePool(const Handle(GEOMAlgo_GPropsCache)& theCache)
+  {
+    myCaches.Append(theCache);
+  }
+  //
+  // takes a free cache from the pool or makes a new one
+  Handle(GEOMAlgo_GPropsCache) Acquire()
+  {
+    Handle(GEOMAlgo_GPropsCache) aCache;
+    //
+    {
+      Standard_Mutex::Sentry aSentry(myMutex);
+      if (!myCaches.IsEmpty()) {
+        aCache=myCaches.First();
+        myCaches.RemoveFirst();
+        return aCache;
+      }
+    }
+    //
+    aCache=new GEOMAlgo_GPropsCache;
+    return aCache;
+  }
+  //
+  void Release(const Handle(GEOMAlgo_GPropsCache)& theCache)
+  {
+    Standard_Mutex::Sentry aSentry(myMutex);
+    myCaches.Append(theCache);
+  }
+  //
+ protected:
+  NCollection_List<Handle(GEOMAlgo_GPropsCache)> myCaches;
+  Standard_Mutex myMutex;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_GetInPlaceSolver
+//purpose  : Searches one argument in the prepared shape Where
+//           (see PerformList)
+//=======================================================================
+class GEOMAlgo_GetInPlaceSolver
+{
+ public:
+  GEOMAlgo_GetInPlaceSolver()
+  :
+    myGIP(NULL),
+    myPool(NULL),
+    myNbCandidates(0),
+    myNbPairs(0)
+  {}
+  //
+  void SetAlgo(const GEOMAlgo_GetInPlace& theGIP)
+  {
+    myGIP=&theGIP;
+  }
+  //
+  void SetShapeWhat(const TopoDS_Shape& theShape)
+  {
+    myShapeWhat=theShape;
+  }
+  //
+  void SetGPropsCachePool(GEOMAlgo_GPropsCachePool& thePool)
+  {
+    myPool=&thePool;
+  }
+  //
+  const TopoDS_Shape& Result() const
+  {
+    return myResult;
+  }
+  //
+  Standard_Size NbCandidates() const
+  {
+    return myNbCandidates;
+  }
+  //
+  Standard_Size NbPairs() const
+  {
+    return myNbPairs;
+  }
+  //
+  const GEOMAlgo_Profile& Profile() const
+  {
+    return myProfile;
+  }
+  //
+  void SetContext(const Handle(IntTools_Context)& theContext)
+  {
+    myContext=theContext;
+  }
+  //
+  const Handle(IntTools_Context)& Context() const
+  {
+    return myContext;
+  }
+  //
+  void Perform()
+  {
+    GEOMAlgo_GetInPlace aGIP;
+    Handle(GEOMAlgo_GPropsCache) aCache=myPool->Acquire();
+    //
+    aGIP.SetTolerance(myGIP->Tolerance());
+    aGIP.SetTolMass(myGIP->TolMass());
+    aGIP.SetTolCG(myGIP->TolCG());
+    aGIP.SetIndex(myGIP->Index());
+    aGIP.SetUseOBB(myGIP->UseOBB());
+    aGIP.SetArgument(myShapeWhat);
+    aGIP.SetContext(myContext);
+    aGIP.SetProfiling(myGIP->Profiling());
+    aGIP.SetGPropsCache(aCache);
+    //
+    aGIP.Perform();
+    myPool->Release(aCache);
+    if (!aGIP.ErrorStatus() && aGIP.IsFound()) {
+      myResult=aGIP.Result();
+    }
+    myNbCandidates=aGIP.NbCandidates();
+    myNbPairs=aGIP.NbPairs();
+    if (myGIP->Profiling()) {
+      myProfile=aGIP.Profile();
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_GetInPlace* myGIP;
+  GEOMAlgo_GPropsCachePool* myPool;
+  TopoDS_Shape myShapeWhat;
+  TopoDS_Shape myResult;
+  Standard_Size myNbCandidates;
+  Standard_Size myNbPairs;
+  GEOMAlgo_Profile myProfile;
+  Handle(IntTools_Context) myContext;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_GetInPlaceSolver>
+  GEOMAlgo_VectorOfGetInPlaceSolver;
 
-static
-  void MapBRepShapes(const TopoDS_Shape& aS,
-                     TopTools_IndexedMapOfShape& aM);
 
 
 //=======================================================================
@@ -84,6 +239,11 @@ GEOMAlgo_GetInPlace::GEOMAlgo_GetInPlace()
   myTolCG=0.0001;
   myFound=Standard_False;
   myCheckGeometry=Standard_True;
+  for (Standard_Integer i=0; i<IS_NbStages; ++i) {
+    myIntersectTimes[i]=0.;
+  }
+  myNbCandidates=0;
+  myNbPairs=0;
 }
 
 //=======================================================================
@@ -101,6 +261,11 @@ GEOMAlgo_GetInPlace::GEOMAlgo_GetInPlace(const TopoDS_Shape &theWhere,
   myTolCG=0.0001;
   myFound=Standard_False;
   myCheckGeometry=Standard_True;
+  for (Standard_Integer j=0; j<IS_NbStages; ++j) {
+    myIntersectTimes[j]=0.;
+  }
+  myNbCandidates=0;
+  myNbPairs=0;
 
   if (theWhere.IsNull() || theWhat.IsNull()) {
     return;
@@ -187,6 +352,23 @@ Standard_Real GEOMAlgo_GetInPlace::TolCG()const
   return myTolCG;
 }
 //=======================================================================
+//function : SetGPropsCache
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::SetGPropsCache
+  (const Handle(GEOMAlgo_GPropsCache)& theCache)
+{
+  mySharedGProps=theCache;
+}
+//=======================================================================
+//function : GPropsCache
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_GPropsCache)& GEOMAlgo_GetInPlace::GPropsCache()const
+{
+  return myGPropsCache;
+}
+//=======================================================================
 //function : IsFound
 //purpose  :
 //=======================================================================
@@ -211,6 +393,26 @@ const TopoDS_Shape& GEOMAlgo_GetInPlace::ShapeWhere()const
   return myShapeWhere;
 }
 //=======================================================================
+//function : SetIndex
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::SetIndex
+  (const Handle(GEOMAlgo_GetInPlaceIndex)& theIndex)
+{
+  myIndex=theIndex;
+  if (!myIndex.IsNull()) {
+    myShapeWhere=myIndex->ShapeWhere();
+  }
+}
+//=======================================================================
+//function : Index
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_GetInPlaceIndex)& GEOMAlgo_GetInPlace::Index()const
+{
+  return myIndex;
+}
+//=======================================================================
 //function : ShapesIn
 //purpose  :
 //=======================================================================
@@ -255,6 +457,7 @@ void GEOMAlgo_GetInPlace::Perform()
   myFound=Standard_False;
   myErrorStatus=0;
   myWarningStatus=0;
+  myProfile.Clear();
   //
   Clear();
   if (myErrorStatus) {
@@ -266,7 +469,7 @@ void GEOMAlgo_GetInPlace::Perform()
     return;
   }
   //
-  // Initialize the context
+  // Initialize the context.
   GEOMAlgo_GluerAlgo::Perform();
   //
   Intersect();
@@ -346,6 +549,73 @@ void GEOMAlgo_GetInPlace::Perform()
   }
 }
 //=======================================================================
+//function : PerformList
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::PerformList(const TopTools_ListOfShape& theLWhat,
+                                      TopTools_ListOfShape& theLResults)
+{
+  Standard_Integer i, aNbS;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  GEOMAlgo_VectorOfGetInPlaceSolver aVGIP;
+  Handle(IntTools_Context) aContext;
+  //
+  myErrorStatus=0;
+  myWarningStatus=0;
+  myProfile.Clear();
+  myNbCandidates=0;
+  myNbPairs=0;
+  theLResults.Clear();
+  //
+  if (myShapeWhere.IsNull()) {
+    myErrorStatus=3;
+    return;
+  }
+  //
+  // 1. Prepare the shape Where once for all the arguments
+  if (myIndex.IsNull() || !myIndex->IsValid(myShapeWhere, myTolerance) ||
+      (myUseOBB && !myIndex->UseOBB())) {
+    myIndex=new GEOMAlgo_GetInPlaceIndex;
+    myIndex->SetShapeWhere(myShapeWhere);
+    myIndex->SetTolerance(myTolerance);
+    myIndex->SetUseOBB(myUseOBB);
+    myIndex->Perform();
+  }
+  // the own context of the algorithm (see Perform())
+  aContext=myContext;
+  if (aContext.IsNull()) {
+    aContext=new IntTools_Context;
+  }
+  // the cache of mass properties shared by the arguments, the
+  // arguments searched in parallel take the caches of their own
+  myGPropsCache=mySharedGProps;
+  if (myGPropsCache.IsNull()) {
+    myGPropsCache=new GEOMAlgo_GPropsCache;
+  }
+  GEOMAlgo_GPropsCachePool aPool(myGPropsCache);
+  //
+  // 2. Search the arguments
+  aItLS.Initialize(theLWhat);
+  for (; aItLS.More(); aItLS.Next()) {
+    GEOMAlgo_GetInPlaceSolver& aGIP=aVGIP.Appended();
+    aGIP.SetAlgo(*this);
+    aGIP.SetShapeWhat(aItLS.Value());
+    aGIP.SetGPropsCachePool(aPool);
+  }
+  //
+  BOPTools_Parallel::Perform(myRunParallel, aVGIP, aContext);
+  //
+  // the counters and the profiles of the arguments are summed up
+  aNbS=aVGIP.Length();
+  for (i=0; i<aNbS; ++i) {
+    const GEOMAlgo_GetInPlaceSolver& aGIP=aVGIP(i);
+    theLResults.Append(aGIP.Result());
+    myNbCandidates+=aGIP.NbCandidates();
+    myNbPairs+=aGIP.NbPairs();
+    myProfile.Add(aGIP.Profile(), "");
+  }
+}
+//=======================================================================
 //function : CheckData
 //purpose  :
 //=======================================================================
@@ -370,84 +640,158 @@ void GEOMAlgo_GetInPlace::CheckData()
 //=======================================================================
 void GEOMAlgo_GetInPlace::Intersect()
 {
-  Standard_Integer i, j, aNbS1, aNbS2, aNbSD;
+  GEOMAlgo_ProfileStage aPS(myProfile, "Intersect");
+  Standard_Boolean bUseOBB;
+  Standard_Integer i, j, aNbS1, aNbIds;
   TColStd_ListIteratorOfListOfInteger aItLI;
-  TopTools_IndexedMapOfShape aMS1, aMS2;
-  TopTools_DataMapOfShapeListOfShape aDMSLS;
-  TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItDMSLS;
-  TopTools_ListIteratorOfListOfShape aItLS;
+  TopTools_IndexedMapOfShape aMS1;
   GEOMAlgo_CoupleOfShapes aCS;
-  //
-  GEOMAlgo_BoxBndTreeSelector aSelector;
-  GEOMAlgo_BoxBndTree aBBTree;
-  NCollection_UBTreeFiller <Standard_Integer, Bnd_Box> aTreeFiller(aBBTree);
+  Handle(GEOMAlgo_GetInPlaceIndex) aIndex;
+  std::vector<Standard_Integer> aIds;
+  OSD_Timer aTimer;
   //
   myErrorStatus=0;
   myWarningStatus=0;
   //
   myIterator.Clear();
-  //
-  MapBRepShapes(myArgument, aMS1);
-  aNbS1=aMS1.Extent();
-  for (i=1; i<=aNbS1; ++i) {
-    Bnd_Box aBox1;
-    //
-    const TopoDS_Shape& aS1=aMS1(i);
-    BRepBndLib::Add(aS1, aBox1);
-    aBox1.Enlarge(myTolerance);
-    //
-    aTreeFiller.Add(i, aBox1);
+  for (i=0; i<IS_NbStages; ++i) {
+    myIntersectTimes[i]=0.;
+  }
+  myNbCandidates=0;
+  myNbPairs=0;
+  //
+  // 1. The tree of the sub-shapes of the shape Where
+  aTimer.Start();
+  aIndex=myIndex;
+  if (aIndex.IsNull() || !aIndex->IsValid(myShapeWhere, myTolerance)) {
+    aIndex=new GEOMAlgo_GetInPlaceIndex;
+    aIndex->SetShapeWhere(myShapeWhere);
+    aIndex->SetTolerance(myTolerance);
+    aIndex->SetRunParallel(myRunParallel);
+    aIndex->SetUseOBB(myUseOBB);
+    aIndex->Perform();
   }
+  aTimer.Stop();
+  myIntersectTimes[IS_Tree]=aTimer.ElapsedTime();
   //
-  aTreeFiller.Fill();
+  const TopTools_IndexedMapOfShape& aMS2=aIndex->Shapes();
+  const GEOMAlgo_BoxBndTree& aBBTree=aIndex->Tree();
   //
-  MapBRepShapes(myShapeWhere, aMS2);
-  aNbS2=aMS2.Extent();
-  for (j=1; j<=aNbS2; ++j) {
-    Bnd_Box aBox2;
-    //
-    const TopoDS_Shape& aS2=aMS2(j);
-    BRepBndLib::Add(aS2, aBox2);
-    aBox2.Enlarge(myTolerance);
-    //
-    aSelector.Clear();
-    aSelector.SetBox(aBox2);
-    aNbSD=aBBTree.Select(aSelector);
-    if (!aNbSD) {
-      continue;  // it should not be
+  // 2. The boxes of the sub-shapes of the argument
+  aTimer.Reset();
+  aTimer.Start();
+  GEOMAlgo_GetInPlaceIndex::MapShapes(myArgument, aMS1);
+  aNbS1=aMS1.Extent();
+  if (!aNbS1) {
+    return;
+  }
+  NCollection_Array1<Bnd_Box> aBoxes1(1, aNbS1);
+  GEOMAlgo_GetInPlaceIndex::ComputeBoxes(aMS1, myTolerance, aBoxes1,
+                                         myRunParallel);
+  aTimer.Stop();
+  myIntersectTimes[IS_Boxes]=aTimer.ElapsedTime();
+  //
+  // 3. The sub-shapes of the shape Where for each box
+  aTimer.Reset();
+  aTimer.Start();
+  NCollection_Array1<TColStd_ListOfInteger> aLIds(1, aNbS1);
+  aBBTree.Select(aBoxes1, aLIds, myRunParallel);
+  aTimer.Stop();
+  myIntersectTimes[IS_Select]=aTimer.ElapsedTime();
+  //
+  // 4. The oriented boxes of the sub-shapes of the argument and
+  //    of the shape Where to prune the pairs of the shapes whose
+  //    axis-aligned boxes intersect only
+  aTimer.Reset();
+  aTimer.Start();
+  bUseOBB=myUseOBB && aMS2.Extent();
+  NCollection_Array1<Bnd_OBB> aOBBs1(1, bUseOBB ? aNbS1 : 1);
+  NCollection_Array1<Bnd_OBB> aOBBs2Local(1, 1);
+  const NCollection_Array1<Bnd_OBB>* pOBBs2=&aOBBs2Local;
+  if (bUseOBB) {
+    GEOMAlgo_GetInPlaceIndex::ComputeOBBs(aMS1, myTolerance, aOBBs1,
+                                          myRunParallel);
+    if (aIndex->UseOBB()) {
+      pOBBs2=&aIndex->OBBs();
+    }
+    else {
+      // the index given by SetIndex() is prepared without them
+      aOBBs2Local.Resize(1, aMS2.Extent(), Standard_False);
+      GEOMAlgo_GetInPlaceIndex::ComputeOBBs(aMS2, myTolerance, aOBBs2Local,
+                                            myRunParallel);
+    }
+  }
+  const NCollection_Array1<Bnd_OBB>& aOBBs2=*pOBBs2;
+  aTimer.Stop();
+  myIntersectTimes[IS_OBB]=aTimer.ElapsedTime();
+  //
+  // 5. The pairs in the order of the sub-shapes of the argument
+  //    and of the shape Where
+  aTimer.Reset();
+  aTimer.Start();
+  for (i=1; i<=aNbS1; ++i) {
+    const TColStd_ListOfInteger& aLI=aLIds(i);
+    if (aLI.IsEmpty()) {
+      continue;
     }
     //
-    const TColStd_ListOfInteger& aLI=aSelector.Indices();
+    aIds.clear();
     aItLI.Initialize(aLI);
     for (; aItLI.More(); aItLI.Next()) {
-      i=aItLI.Value();
-      const TopoDS_Shape& aS1=aMS1(i);
-      //
-      if (aDMSLS.IsBound(aS1)) {
-        TopTools_ListOfShape& aLS=aDMSLS.ChangeFind(aS1);
-        aLS.Append(aS2);
-      }
-      else {
-        TopTools_ListOfShape aLS;
-        //
-        aLS.Append(aS2);
-        aDMSLS.Bind(aS1, aLS);
-      }
+      aIds.push_back(aItLI.Value());
     }
-  }// for (j=1; j<=aNbS2; ++j) {
-  //
-  aItDMSLS.Initialize(aDMSLS);
-  for (; aItDMSLS.More(); aItDMSLS.Next()) {
-    const TopoDS_Shape& aS1=aItDMSLS.Key();
-    const TopTools_ListOfShape& aLS2=aItDMSLS.Value();
-    aCS.SetShape1(aS1);
-    aItLS.Initialize(aLS2);
-    for (; aItLS.More(); aItLS.Next()) {
-      const TopoDS_Shape& aS2=aItLS.Value();
-      aCS.SetShape2(aS2);
+    std::sort(aIds.begin(), aIds.end());
+    aNbIds=(Standard_Integer)
+      (std::unique(aIds.begin(), aIds.end())-aIds.begin());
+    //
+    myNbCandidates+=aNbIds;
+    //
+    aCS.SetShape1(aMS1(i));
+    for (j=0; j<aNbIds; ++j) {
+      if (bUseOBB && aOBBs1(i).IsOut(aOBBs2(aIds[j]))) {
+        continue;
+      }
+      aCS.SetShape2(aMS2(aIds[j]));
       myIterator.AppendPair(aCS);
+      ++myNbPairs;
     }
   }
+  aTimer.Stop();
+  myIntersectTimes[IS_Pairs]=aTimer.ElapsedTime();
+  //
+  myProfile.AddTime("Intersect.Tree", myIntersectTimes[IS_Tree]);
+  myProfile.AddTime("Intersect.Boxes", myIntersectTimes[IS_Boxes]);
+  myProfile.AddTime("Intersect.Select", myIntersectTimes[IS_Select]);
+  myProfile.AddTime("Intersect.OBB", myIntersectTimes[IS_OBB]);
+  myProfile.AddTime("Intersect.Pairs", myIntersectTimes[IS_Pairs]);
+  myProfile.AddCount("TreeSelects", aNbS1);
+  myProfile.AddCount("CandidatePairs", myNbCandidates);
+  myProfile.AddCount("Pairs", myNbPairs);
+}
+//=======================================================================
+//function : IntersectTime
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_GetInPlace::IntersectTime
+  (const IntersectStage theStage) const
+{
+  return myIntersectTimes[theStage];
+}
+//=======================================================================
+//function : NbCandidates
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_GetInPlace::NbCandidates() const
+{
+  return myNbCandidates;
+}
+//=======================================================================
+//function : NbPairs
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_GetInPlace::NbPairs() const
+{
+  return myNbPairs;
 }
 //=======================================================================
 //function : PerformVV
@@ -455,6 +799,7 @@ void GEOMAlgo_GetInPlace::Intersect()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformVV()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformVV");
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -508,7 +853,9 @@ void GEOMAlgo_GetInPlace::FillEdgesOn(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformVE()
 {
-  Standard_Boolean bFound;
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformVE");
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -527,14 +874,10 @@ void GEOMAlgo_GetInPlace::PerformVE()
       }
     }
     //
-    bFound=CheckCoincidence(aE1, aV2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aE1, aV2);
-    }
+    aLCS.Append(aCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformEE
@@ -542,6 +885,10 @@ void GEOMAlgo_GetInPlace::PerformVE()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformEE()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformEE");
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -550,30 +897,24 @@ void GEOMAlgo_GetInPlace::PerformEE()
     const GEOMAlgo_CoupleOfShapes& aCS=myIterator.Value();
     const TopoDS_Shape& aE1=aCS.Shape1();
     const TopoDS_Shape& aE2=aCS.Shape2();
-
-    PerformEE(aE1, aE2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformEE(aE2, aE1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformEE(aE1, aE2, aLCS);
+    PerformEE(aE2, aE1, aLCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformEE
 //purpose  :
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformEE(const TopoDS_Shape &theE1,
-                                    const TopoDS_Shape &theE2)
+                                    const TopoDS_Shape &theE2,
+                                    GEOMAlgo_ListOfCoupleOfShapes& theLCS)
 {
   Standard_Boolean bHasOn, bHasIn, bFound;
   TopoDS_Iterator aIt;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_CoupleOfShapes aCS;
   //
   bHasOn=myShapesOn.IsBound(theE1);
   bHasIn=myShapesIn.IsBound(theE1);
@@ -593,13 +934,8 @@ void GEOMAlgo_GetInPlace::PerformEE(const TopoDS_Shape &theE1,
     return;
   }
   //
-  bFound=CheckCoincidence(theE1, theE2);
-  if (myErrorStatus) {
-    return;
-  }
-  if (bFound) {
-    FillShapesIn(theE1, theE2);
-  }
+  aCS.SetShapes(theE1, theE2);
+  theLCS.Append(aCS);
 }
 //=======================================================================
 //function : PerformVF
@@ -607,10 +943,13 @@ void GEOMAlgo_GetInPlace::PerformEE(const TopoDS_Shape &theE1,
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformVF()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformVF");
   Standard_Boolean bHasOn, bHasIn, bFound;
   Standard_Integer i, aNbE;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aME;
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -646,14 +985,10 @@ void GEOMAlgo_GetInPlace::PerformVF()
       continue;
     }
     //
-    bFound=CheckCoincidence(aF1, aV2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aF1, aV2);
-    }
+    aLCS.Append(aCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : FillFacesOn
@@ -706,9 +1041,12 @@ void GEOMAlgo_GetInPlace::FillFacesOn(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformEF()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformEF");
   Standard_Boolean  bFound, bHasOnF, bHasInF;
   TopoDS_Iterator aIt;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -743,14 +1081,10 @@ void GEOMAlgo_GetInPlace::PerformEF()
       continue;
     }
     //------------------------------
-    bFound=CheckCoincidence(aF1, aE2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aF1, aE2);
-    }
+    aLCS.Append(aCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformFF
@@ -758,6 +1092,10 @@ void GEOMAlgo_GetInPlace::PerformEF()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformFF()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformFF");
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -766,31 +1104,25 @@ void GEOMAlgo_GetInPlace::PerformFF()
     const GEOMAlgo_CoupleOfShapes& aCS=myIterator.Value();
     const TopoDS_Shape& aF1=aCS.Shape1();
     const TopoDS_Shape& aF2=aCS.Shape2();
-
-    PerformFF(aF1, aF2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformFF(aF2, aF1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformFF(aF1, aF2, aLCS);
+    PerformFF(aF2, aF1, aLCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformFF
 //purpose  :
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformFF(const TopoDS_Shape &theF1,
-                                    const TopoDS_Shape &theF2)
+                                    const TopoDS_Shape &theF2,
+                                    GEOMAlgo_ListOfCoupleOfShapes& theLCS)
 {
   Standard_Boolean  bFound, bHasOnF, bHasInF;
   Standard_Integer i, aNbS2;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aMS2;
+  GEOMAlgo_CoupleOfShapes aCS;
   //
   bHasOnF=myShapesOn.IsBound(theF1);
   const TopTools_MapOfShape& aMSOnF=(bHasOnF) ? myShapesOn.Find(theF1) : aMSX;
@@ -798,7 +1130,7 @@ void GEOMAlgo_GetInPlace::PerformFF(const TopoDS_Shape &theF1,
   bHasInF=myShapesIn.IsBound(theF1);
   const TopTools_MapOfShape& aMSInF=(bHasInF) ? myShapesIn.Find(theF1) : aMSX;
   //
-  MapBRepShapes(theF2, aMS2);
+  GEOMAlgo_GetInPlaceIndex::MapShapes(theF2, aMS2);
   //
   bFound=Standard_False;
   aNbS2=aMS2.Extent();
@@ -816,13 +1148,8 @@ void GEOMAlgo_GetInPlace::PerformFF(const TopoDS_Shape &theF1,
     return;
   }
   //
-  bFound=CheckCoincidence(theF1, theF2);
-  if (myErrorStatus) {
-    return;
-  }
-  if (bFound) {
-    FillShapesIn(theF1, theF2);
-  }
+  aCS.SetShapes(theF1, theF2);
+  theLCS.Append(aCS);
 }
 //=======================================================================
 //function : FillSolidsOn
@@ -872,8 +1199,11 @@ void GEOMAlgo_GetInPlace::FillSolidsOn(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformZF()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformZF");
   Standard_Boolean  bFound, bHasOnF;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -891,14 +1221,10 @@ void GEOMAlgo_GetInPlace::PerformZF()
       continue;
     }
     //------------------------------
-    bFound=CheckCoincidence(aSo1, aF2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aSo1, aF2);
-    }
+    aLCS.Append(aCS);
   }
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformZZ
@@ -906,6 +1232,10 @@ void GEOMAlgo_GetInPlace::PerformZF()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformZZ()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformZZ");
+  GEOMAlgo_ListOfCoupleOfShapes aLCS;
+  TColStd_MapOfInteger aMIn;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -914,31 +1244,26 @@ void GEOMAlgo_GetInPlace::PerformZZ()
     const GEOMAlgo_CoupleOfShapes& aCS=myIterator.Value();
     const TopoDS_Shape& aSo1=aCS.Shape1();
     const TopoDS_Shape& aSo2=aCS.Shape2();
-
-    PerformZZ(aSo1, aSo2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformZZ(aSo2, aSo1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformZZ(aSo1, aSo2, aLCS, aMIn);
+    PerformZZ(aSo2, aSo1, aLCS, aMIn);
   }// for (; myIterator.More(); myIterator.Next()) {
+  //
+  CheckCoincidence(aLCS, aMIn);
 }
 //=======================================================================
 //function : PerformZZ
 //purpose  :
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformZZ(const TopoDS_Shape &theSo1,
-                                    const TopoDS_Shape &theSo2)
+                                    const TopoDS_Shape &theSo2,
+                                    GEOMAlgo_ListOfCoupleOfShapes& theLCS,
+                                    TColStd_MapOfInteger& theMIn)
 {
   Standard_Boolean bFound, bHasOn, bHasIn;
   Standard_Integer i, aNbS2, iCntOn, iCntIn, iCntOut;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aMS2;
+  GEOMAlgo_CoupleOfShapes aCS;
   //
   bHasOn=myShapesOn.IsBound(theSo1);
   const TopTools_MapOfShape& aMSOn=(bHasOn) ? myShapesOn.Find(theSo1) : aMSX;
@@ -975,14 +1300,11 @@ void GEOMAlgo_GetInPlace::PerformZZ(const TopoDS_Shape &theSo1,
     return;
   }
   //
-  if (!iCntIn) {
-    bFound=CheckCoincidence(theSo1, theSo2);
-    if (myErrorStatus) {
-      return;
-    }
-  }
-  if (bFound) {
-    FillShapesIn(theSo1, theSo2);
+  aCS.SetShapes(theSo1, theSo2);
+  theLCS.Append(aCS);
+  if (iCntIn) {
+    // a face of theSo2 is IN theSo1, no need to check
+    theMIn.Add(theLCS.Extent());
   }
 }
 //=======================================================================
@@ -1203,37 +1525,6 @@ void GEOMAlgo_GetInPlace::FillShapesOn(const TopoDS_Shape& aS1,
   }
 }
 
-//=======================================================================
-//function : MapBRepShapes
-//purpose  :
-//=======================================================================
-void MapBRepShapes(const TopoDS_Shape& aS,
-                   TopTools_IndexedMapOfShape& aM)
-{
-  Standard_Boolean bDegenerated;
-  TopAbs_ShapeEnum aType;
-  TopoDS_Iterator aIt;
-  //
-  aType=aS.ShapeType();
-  if (aType==TopAbs_VERTEX || aType==TopAbs_EDGE ||
-      aType==TopAbs_FACE   || aType==TopAbs_SOLID) {
-    bDegenerated=Standard_False;
-    if (aType==TopAbs_EDGE) {
-      TopoDS_Edge *pE=(TopoDS_Edge*)&aS;
-      bDegenerated=BRep_Tool::Degenerated(*pE);
-    }
-    if (!bDegenerated) {
-      aM.Add(aS);
-    }
-  }
-  //
-  aIt.Initialize(aS);
-  for(; aIt.More(); aIt.Next()) {
-    const TopoDS_Shape& aSx=aIt.Value();
-    aType=aSx.ShapeType();
-    MapBRepShapes(aSx, aM);
-  }
-}
 //=======================================================================
 //function : Result
 //purpose  : 
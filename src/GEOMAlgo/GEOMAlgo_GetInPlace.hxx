@@ -43,8 +43,12 @@
 #include <GEOMAlgo_GluerAlgo.hxx>
 #include <GEOMAlgo_Algo.hxx>
 #include <GEOMAlgo_DataMapOfShapePnt.hxx>
+#include <GEOMAlgo_GetInPlaceIndex.hxx>
+#include <GEOMAlgo_GPropsCache.hxx>
 #include <TopTools_DataMapOfShapeInteger.hxx>
 #include <TopTools_DataMapOfShapeShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TColStd_MapOfInteger.hxx>
 
 
 //=======================================================================
@@ -174,6 +178,27 @@ class GEOMAlgo_GetInPlace  : public GEOMAlgo_GluerAlgo,
   Standard_EXPORT
     const TopoDS_Shape& ShapeWhere() const;
 
+  /**
+   * Modifier. Sets the prepared shape where the search is intended.
+   * The shape where the search is intended is set to the one of
+   * the index. The index is used if it is built for this shape and
+   * the tolerance of the algorithm, otherwise it is ignored.
+   * The results are the same as without the index.
+   * The index is not modified by the search, so it can be shared by
+   * the algorithms running concurrently.
+   * @param theIndex
+   *   The prepared shape where the search is intended.
+   */
+  Standard_EXPORT
+    void SetIndex(const Handle(GEOMAlgo_GetInPlaceIndex)& theIndex) ;
+
+  /**
+   * Selector. Returns the prepared shape where the search is intended.
+   * @return
+   *   The prepared shape where the search is intended.
+   */
+  Standard_EXPORT
+    const Handle(GEOMAlgo_GetInPlaceIndex)& Index() const;
   /**
    * Modifier. Sets the tolerance of mass.
    * @param theTol
@@ -206,12 +231,87 @@ class GEOMAlgo_GetInPlace  : public GEOMAlgo_GluerAlgo,
   Standard_EXPORT
     Standard_Real TolCG() const;
 
+  /**
+   * Modifier. Sets the cache of mass properties to share between
+   * the calls of Perform() and between the arguments of
+   * PerformList(). By default each call uses its own cache.
+   * The arguments of PerformList() searched in parallel use the
+   * cache one at a time, the others take the caches of their own.
+   * The shapes of the cache must not be modified between the calls.
+   * @param theCache
+   *   The cache of mass properties.
+   */
+  Standard_EXPORT
+    void SetGPropsCache(const Handle(GEOMAlgo_GPropsCache)& theCache) ;
+
+  /**
+   * Selector. Returns the cache of mass properties used by the
+   * last call of Perform() or PerformList() (shared by the
+   * arguments), e.g. to get its hit rate.
+   * @return
+   *   The cache of mass properties.
+   */
+  Standard_EXPORT
+    const Handle(GEOMAlgo_GPropsCache)& GPropsCache() const;
   /**
    * Perform the algorithm.
    */
   Standard_EXPORT
     virtual  void Perform() ;
 
+  /**
+   * Perform the algorithm for each shape of the list as the argument.
+   * The shape where the search is intended is prepared once (see
+   * SetIndex()) and the arguments are processed in parallel if
+   * RunParallel() is set.
+   * The profiles of the arguments (see SetProfiling()) are summed up
+   * into Profile().
+   * @param theLWhat
+   *   The arguments.
+   * @param theLResults
+   *   The results in the order of the arguments: Result() for the
+   *   argument that is found, NULL shape otherwise.
+   */
+  Standard_EXPORT
+    void PerformList(const TopTools_ListOfShape& theLWhat,
+                     TopTools_ListOfShape& theLResults) ;
+
+  /**
+   * The stages of the search of the pairs of intersected shapes.
+   */
+  enum IntersectStage {
+    IS_Tree,   //!< the tree of [Where], if the index is not reused
+    IS_Boxes,  //!< the bounding boxes of the argument
+    IS_Select, //!< the selection of the boxes in the tree
+    IS_OBB,    //!< the oriented bounding boxes, if UseOBB() is set
+    IS_Pairs,  //!< the list of the pairs
+    IS_NbStages
+  };
+
+  /**
+   * Returns the time (in seconds) of the stage of the search of the
+   * pairs of intersected shapes in the last call of Perform().
+   */
+  Standard_EXPORT
+    Standard_Real IntersectTime(const IntersectStage theStage) const;
+
+  /**
+   * Returns the number of the pairs of the shapes with intersected
+   * axis-aligned bounding boxes in the last call of Perform(), or
+   * the sum over the arguments of the last call of PerformList().
+   */
+  Standard_EXPORT
+    Standard_Size NbCandidates() const;
+
+  /**
+   * Returns the number of the pairs of intersected shapes to check
+   * in the last call of Perform() or PerformList() (see
+   * NbCandidates()). It is less than NbCandidates()
+   * if the pairs are pruned by the oriented bounding boxes
+   * (see SetUseOBB()).
+   */
+  Standard_EXPORT
+    Standard_Size NbPairs() const;
   /**
    * Returns state of the search.
    * @return
@@ -284,7 +384,8 @@ protected:
   Standard_EXPORT
     void PerformEE() ;
 
-    void PerformEE(const TopoDS_Shape &theE1, const TopoDS_Shape &theE2);
+    void PerformEE(const TopoDS_Shape &theE1, const TopoDS_Shape &theE2,
+                   GEOMAlgo_ListOfCoupleOfShapes& theLCS);
 
   Standard_EXPORT
     void PerformVF() ;
@@ -295,7 +396,8 @@ protected:
   Standard_EXPORT
     void PerformFF() ;
 
-    void PerformFF(const TopoDS_Shape &theF1, const TopoDS_Shape &theF2);
+    void PerformFF(const TopoDS_Shape &theF1, const TopoDS_Shape &theF2,
+                   GEOMAlgo_ListOfCoupleOfShapes& theLCS);
 
   Standard_EXPORT
     void FillEdgesOn(const TopoDS_Shape &theShape);
@@ -312,7 +414,9 @@ protected:
   Standard_EXPORT
     void PerformZZ() ;
 
-    void PerformZZ(const TopoDS_Shape &theSo1, const TopoDS_Shape &theSo2);
+    void PerformZZ(const TopoDS_Shape &theSo1, const TopoDS_Shape &theSo2,
+                   GEOMAlgo_ListOfCoupleOfShapes& theLCS,
+                   TColStd_MapOfInteger& theMIn);
 
   Standard_EXPORT
     void FillImages(const TopoDS_Shape &theShape,
@@ -343,19 +447,35 @@ protected:
   Standard_EXPORT
     Standard_Boolean CheckCoincidence(const TopoDS_Shape& theS1,
                                       const TopoDS_Shape& theS2);
+
+  /**
+   * Checks the coincidence of the shapes of each pair of theLCS
+   * and fills the shapes IN for the coincident ones in the order
+   * of the pairs. The pairs are checked in parallel if RunParallel()
+   * is set, the result is the same as for the pairwise checks.
+   * @param theLCS
+   *   The pairs of shapes to check.
+   * @param theMIn
+   *   The indices of the pairs in theLCS that are known to be
+   *   coincident and need no check.
+   */
+  Standard_EXPORT
+    void CheckCoincidence(const GEOMAlgo_ListOfCoupleOfShapes& theLCS,
+                          const TColStd_MapOfInteger& theMIn);
   
   Standard_EXPORT
     Standard_Integer CheckGProps(const TopoDS_Shape& theS);
 
   Standard_Boolean CompareGProps
                   (const TopoDS_Shape         &theShape1,
-                   const TopTools_ListOfShape &theListShape2) const;
+                   const TopTools_ListOfShape &theListShape2);
 
   Standard_EXPORT
     void UpdateChecked(const TopoDS_Shape& theS1,
                        const Standard_Integer theFlag);
   //
   TopoDS_Shape myShapeWhere;
+  Handle(GEOMAlgo_GetInPlaceIndex) myIndex;
   GEOMAlgo_GetInPlaceIterator myIterator;
   GEOMAlgo_DataMapOfShapeMapOfShape myShapesIn;
   GEOMAlgo_DataMapOfShapeMapOfShape myShapesOn;
@@ -365,6 +485,11 @@ protected:
   Standard_Boolean myFound;
   GEOMAlgo_DataMapOfShapePnt myMapShapePnt;
   TopTools_DataMapOfShapeInteger myChecked;
+  Handle(GEOMAlgo_GPropsCache) mySharedGProps;
+  Handle(GEOMAlgo_GPropsCache) myGPropsCache;
+  Standard_Real myIntersectTimes[IS_NbStages];
+  Standard_Size myNbCandidates;
+  Standard_Size myNbPairs;
   //
   TopoDS_Shape myResult;
 
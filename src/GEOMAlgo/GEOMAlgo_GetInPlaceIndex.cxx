@@ -0,0 +1,347 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_GetInPlaceIndex.cxx
+
+#include <GEOMAlgo_GetInPlaceIndex.hxx>
+
+#include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopLoc_Location.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <OSD_Parallel.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_GetInPlaceIndex, Standard_Transient)
+
+//=======================================================================
+//class    : GEOMAlgo_BoxFunctor
+//purpose  : computes the bounding boxes of the shapes
+//=======================================================================
+class GEOMAlgo_BoxFunctor
+{
+ public:
+  GEOMAlgo_BoxFunctor(const TopTools_IndexedMapOfShape& theMS,
+                      NCollection_Array1<Bnd_Box>& theBoxes)
+  :
+    myMS(theMS),
+    myBoxes(theBoxes)
+  {}
+  //
+  void operator()(const Standard_Integer theIndex) const
+  {
+    BRepBndLib::Add(myMS(theIndex), myBoxes(theIndex));
+  }
+  //
+ protected:
+  const TopTools_IndexedMapOfShape& myMS;
+  NCollection_Array1<Bnd_Box>& myBoxes;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_OBBFunctor
+//purpose  : computes the oriented bounding boxes of the shapes
+//=======================================================================
+class GEOMAlgo_OBBFunctor
+{
+ public:
+  GEOMAlgo_OBBFunctor(const TopTools_IndexedMapOfShape& theMS,
+                      const Standard_Real theTol,
+                      NCollection_Array1<Bnd_OBB>& theOBBs)
+  :
+    myMS(theMS),
+    myTol(theTol),
+    myOBBs(theOBBs)
+  {}
+  //
+  void operator()(const Standard_Integer theIndex) const
+  {
+    Bnd_OBB& aOBB=myOBBs(myOBBs.Lower()+theIndex-1);
+    //
+    // not optimal, but enclosing the shape with its tolerance
+    BRepBndLib::AddOBB(myMS(theIndex), aOBB,
+                       Standard_False, Standard_False, Standard_True);
+    aOBB.Enlarge(myTol);
+  }
+  //
+ protected:
+  const TopTools_IndexedMapOfShape& myMS;
+  Standard_Real myTol;
+  NCollection_Array1<Bnd_OBB>& myOBBs;
+};
+
+//=======================================================================
+//function : GEOMAlgo_GetInPlaceIndex
+//purpose  :
+//=======================================================================
+GEOMAlgo_GetInPlaceIndex::GEOMAlgo_GetInPlaceIndex()
+:
+  myTolerance(0.0001),
+  myIsDone(Standard_False),
+  myRunParallel(Standard_False),
+  myUseOBB(Standard_False)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_GetInPlaceIndex::~GEOMAlgo_GetInPlaceIndex()
+{
+}
+//=======================================================================
+//function : SetShapeWhere
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::SetShapeWhere(const TopoDS_Shape& theShape)
+{
+  myShapeWhere=theShape;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : ShapeWhere
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_GetInPlaceIndex::ShapeWhere() const
+{
+  return myShapeWhere;
+}
+//=======================================================================
+//function : SetTolerance
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::SetTolerance(const Standard_Real theTol)
+{
+  myTolerance=theTol;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : Tolerance
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_GetInPlaceIndex::Tolerance() const
+{
+  return myTolerance;
+}
+//=======================================================================
+//function : SetRunParallel
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::SetRunParallel(const Standard_Boolean theFlag)
+{
+  myRunParallel=theFlag;
+}
+//=======================================================================
+//function : SetUseOBB
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::SetUseOBB(const Standard_Boolean theFlag)
+{
+  myUseOBB=theFlag;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : UseOBB
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GetInPlaceIndex::UseOBB() const
+{
+  return myUseOBB;
+}
+//=======================================================================
+//function : Shapes
+//purpose  :
+//=======================================================================
+const TopTools_IndexedMapOfShape& GEOMAlgo_GetInPlaceIndex::Shapes() const
+{
+  return myShapes;
+}
+//=======================================================================
+//function : Tree
+//purpose  :
+//=======================================================================
+const GEOMAlgo_BoxBndTree& GEOMAlgo_GetInPlaceIndex::Tree() const
+{
+  return myTree;
+}
+//=======================================================================
+//function : OBBs
+//purpose  :
+//=======================================================================
+const NCollection_Array1<Bnd_OBB>& GEOMAlgo_GetInPlaceIndex::OBBs() const
+{
+  return myOBBs;
+}
+//=======================================================================
+//function : IsValid
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GetInPlaceIndex::IsValid
+  (const TopoDS_Shape& theShape,
+   const Standard_Real theTol) const
+{
+  return myIsDone &&
+         myShapeWhere.IsEqual(theShape) &&
+         myTolerance==theTol;
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::Perform()
+{
+  Standard_Integer i, aNbS;
+  //
+  myIsDone=Standard_False;
+  myShapes.Clear();
+  myTree.Clear();
+  //
+  if (myShapeWhere.IsNull()) {
+    return;
+  }
+  //
+  MapShapes(myShapeWhere, myShapes);
+  aNbS=myShapes.Extent();
+  if (aNbS) {
+    NCollection_Array1<Bnd_Box> aBoxes(1, aNbS);
+    //
+    ComputeBoxes(myShapes, myTolerance, aBoxes, myRunParallel);
+    for (i=1; i<=aNbS; ++i) {
+      myTree.Add(i, aBoxes(i));
+    }
+    //
+    if (myUseOBB) {
+      myOBBs.Resize(1, aNbS, Standard_False);
+      ComputeOBBs(myShapes, myTolerance, myOBBs, myRunParallel);
+    }
+  }
+  myTree.Build();
+  //
+  myIsDone=Standard_True;
+}
+//=======================================================================
+//function : ComputeBoxes
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::ComputeBoxes
+  (const TopTools_IndexedMapOfShape& theMS,
+   const Standard_Real theTol,
+   NCollection_Array1<Bnd_Box>& theBoxes,
+   const Standard_Boolean theRunParallel)
+{
+  Standard_Integer i, aNbS, aNbB;
+  TopTools_IndexedMapOfShape aMSB;
+  TopLoc_Location aLoc0;
+  //
+  aNbS=theMS.Extent();
+  if (!aNbS) {
+    return;
+  }
+  //
+  // the shapes to bound: the shapes located by a translation
+  // are bound without location
+  TColStd_Array1OfInteger aIB(1, aNbS);
+  for (i=1; i<=aNbS; ++i) {
+    const TopoDS_Shape& aS=theMS(i);
+    const TopLoc_Location& aLoc=aS.Location();
+    if (!aLoc.IsIdentity() &&
+        aLoc.Transformation().Form()==gp_Translation) {
+      aIB(i)=aMSB.Add(aS.Located(aLoc0));
+    }
+    else {
+      aIB(i)=aMSB.Add(aS);
+    }
+  }
+  //
+  aNbB=aMSB.Extent();
+  NCollection_Array1<Bnd_Box> aBoxesB(1, aNbB);
+  GEOMAlgo_BoxFunctor aFunctor(aMSB, aBoxesB);
+  //
+  OSD_Parallel::For(1, aNbB+1, aFunctor, !theRunParallel);
+  //
+  for (i=1; i<=aNbS; ++i) {
+    const TopLoc_Location& aLoc=theMS(i).Location();
+    const Bnd_Box& aBoxB=aBoxesB(aIB(i));
+    //
+    Bnd_Box& aBox=theBoxes(theBoxes.Lower()+i-1);
+    if (aMSB(aIB(i)).Location().IsEqual(aLoc)) {
+      aBox=aBoxB;
+    }
+    else {
+      aBox=aBoxB.Transformed(aLoc.Transformation());
+    }
+    aBox.Enlarge(theTol);
+  }
+}
+//=======================================================================
+//function : ComputeOBBs
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::ComputeOBBs
+  (const TopTools_IndexedMapOfShape& theMS,
+   const Standard_Real theTol,
+   NCollection_Array1<Bnd_OBB>& theOBBs,
+   const Standard_Boolean theRunParallel)
+{
+  Standard_Integer aNbS;
+  //
+  aNbS=theMS.Extent();
+  if (!aNbS) {
+    return;
+  }
+  //
+  GEOMAlgo_OBBFunctor aFunctor(theMS, theTol, theOBBs);
+  OSD_Parallel::For(1, aNbS+1, aFunctor, !theRunParallel);
+}
+//=======================================================================
+//function : MapShapes
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlaceIndex::MapShapes(const TopoDS_Shape& aS,
+                                         TopTools_IndexedMapOfShape& aM)
+{
+  Standard_Boolean bDegenerated;
+  TopAbs_ShapeEnum aType;
+  TopoDS_Iterator aIt;
+  //
+  aType=aS.ShapeType();
+  if (aType==TopAbs_VERTEX || aType==TopAbs_EDGE ||
+      aType==TopAbs_FACE   || aType==TopAbs_SOLID) {
+    bDegenerated=Standard_False;
+    if (aType==TopAbs_EDGE) {
+      bDegenerated=BRep_Tool::Degenerated(TopoDS::Edge(aS));
+    }
+    if (!bDegenerated) {
+      aM.Add(aS);
+    }
+  }
+  //
+  aIt.Initialize(aS);
+  for(; aIt.More(); aIt.Next()) {
+    const TopoDS_Shape& aSx=aIt.Value();
+    MapShapes(aSx, aM);
+  }
+}
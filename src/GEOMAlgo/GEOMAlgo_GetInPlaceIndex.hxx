@@ -0,0 +1,197 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_GetInPlaceIndex.hxx
+
+#ifndef _GEOMAlgo_GetInPlaceIndex_HeaderFile
+#define _GEOMAlgo_GetInPlaceIndex_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Boolean.hxx>
+
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
+#include <NCollection_Array1.hxx>
+
+#include <GEOMAlgo_BoxBndTree.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_GetInPlaceIndex, Standard_Transient)
+
+//=======================================================================
+/**
+ * The prepared shape [Where] for Get In Place Algorithm.
+ * It keeps the sub-shapes of [Where] to intersect and the tree
+ * of their bounding boxes, so that many arguments [What] can be
+ * searched in the same shape [Where] without rebuilding them
+ * (see GEOMAlgo_GetInPlace::SetIndex()).
+ * The built index is only read by the searches, so it can be shared
+ * by the searches running concurrently.
+ */
+//=======================================================================
+//class    : GEOMAlgo_GetInPlaceIndex
+//purpose  :
+//=======================================================================
+class GEOMAlgo_GetInPlaceIndex : public Standard_Transient
+{
+ public:
+  /**
+   * Constructor.
+   */
+  Standard_EXPORT
+    GEOMAlgo_GetInPlaceIndex();
+
+  /**
+   * Destructor.
+   */
+  Standard_EXPORT
+    virtual ~GEOMAlgo_GetInPlaceIndex();
+
+  /**
+   * Modifier. Sets the shape where the search is intended.
+   */
+  Standard_EXPORT
+    void SetShapeWhere(const TopoDS_Shape& theShape);
+
+  /**
+   * Selector. Returns the shape where the search is intended.
+   */
+  Standard_EXPORT
+    const TopoDS_Shape& ShapeWhere() const;
+
+  /**
+   * Modifier. Sets the tolerance the bounding boxes are enlarged by.
+   * It must be the tolerance of the algorithm using the index.
+   */
+  Standard_EXPORT
+    void SetTolerance(const Standard_Real theTol);
+
+  /**
+   * Selector. Returns the tolerance.
+   */
+  Standard_EXPORT
+    Standard_Real Tolerance() const;
+
+  /**
+   * Modifier. Sets the flag to compute the bounding boxes
+   * in parallel.
+   */
+  Standard_EXPORT
+    void SetRunParallel(const Standard_Boolean theFlag);
+
+  /**
+   * Modifier. Sets the flag to compute the oriented bounding boxes
+   * of the sub-shapes in addition to the axis-aligned ones.
+   */
+  Standard_EXPORT
+    void SetUseOBB(const Standard_Boolean theFlag);
+
+  /**
+   * Selector. Returns the flag to compute the oriented bounding boxes.
+   */
+  Standard_EXPORT
+    Standard_Boolean UseOBB() const;
+
+  /**
+   * Builds the index.
+   */
+  Standard_EXPORT
+    void Perform();
+
+  /**
+   * Returns Standard_True if the index is built for the shape
+   * theShape and the tolerance theTol.
+   */
+  Standard_EXPORT
+    Standard_Boolean IsValid(const TopoDS_Shape& theShape,
+                             const Standard_Real theTol) const;
+
+  /**
+   * Returns the sub-shapes of the shape [Where] to intersect.
+   */
+  Standard_EXPORT
+    const TopTools_IndexedMapOfShape& Shapes() const;
+
+  /**
+   * Returns the tree of the bounding boxes of the sub-shapes.
+   * The index of the box is the index of the sub-shape in Shapes().
+   */
+  Standard_EXPORT
+    const GEOMAlgo_BoxBndTree& Tree() const;
+
+  /**
+   * Returns the oriented bounding boxes of the sub-shapes enlarged
+   * by the tolerance, in the order of Shapes().
+   * They are computed only if UseOBB() is set.
+   */
+  Standard_EXPORT
+    const NCollection_Array1<Bnd_OBB>& OBBs() const;
+
+  /**
+   * Collects the vertices, non-degenerated edges, faces and solids
+   * of the shape theS into the map theM.
+   */
+  Standard_EXPORT
+    static void MapShapes(const TopoDS_Shape& theS,
+                          TopTools_IndexedMapOfShape& theM);
+
+  /**
+   * Computes the bounding boxes of the shapes theMS enlarged by
+   * theTol into theBoxes (of the same range as theMS).
+   * The box of the shapes that share the TShape and differ by
+   * a translation is computed once.
+   */
+  Standard_EXPORT
+    static void ComputeBoxes(const TopTools_IndexedMapOfShape& theMS,
+                             const Standard_Real theTol,
+                             NCollection_Array1<Bnd_Box>& theBoxes,
+                             const Standard_Boolean theRunParallel);
+
+  /**
+   * Computes the oriented bounding boxes of the shapes theMS
+   * enlarged by theTol into theOBBs (of the same range as theMS).
+   */
+  Standard_EXPORT
+    static void ComputeOBBs(const TopTools_IndexedMapOfShape& theMS,
+                            const Standard_Real theTol,
+                            NCollection_Array1<Bnd_OBB>& theOBBs,
+                            const Standard_Boolean theRunParallel);
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_GetInPlaceIndex, Standard_Transient)
+
+ protected:
+  TopoDS_Shape myShapeWhere;
+  Standard_Real myTolerance;
+  Standard_Boolean myIsDone;
+  Standard_Boolean myRunParallel;
+  Standard_Boolean myUseOBB;
+  TopTools_IndexedMapOfShape myShapes;
+  GEOMAlgo_BoxBndTree myTree;
+  NCollection_Array1<Bnd_OBB> myOBBs;
+};
+
+#endif
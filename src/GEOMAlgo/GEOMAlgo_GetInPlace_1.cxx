@@ -59,6 +59,11 @@
 
 #include <IntTools_Tools.hxx>
 
+#include <BOPTools_Parallel.hxx>
+
+#include <NCollection_Vector.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
 #include <GEOMAlgo_AlgoTools.hxx>
 
 
@@ -82,6 +87,159 @@ static
                               const Standard_Real aTol,
                               gp_Pnt& aP);
 
+static
+  Standard_Integer PntInShape(const TopoDS_Shape& aS,
+                              const Standard_Real aTol,
+                              gp_Pnt& aP);
+
+static
+  Standard_Boolean IsCoincident(const TopoDS_Shape& aS1,
+                                const gp_Pnt& aP2,
+                                const Standard_Real aTol,
+                                const Handle(IntTools_Context)& aCtx);
+
+//=======================================================================
+//class    : GEOMAlgo_PntInShape
+//purpose  : Computes the point inside the shape
+//=======================================================================
+class GEOMAlgo_PntInShape
+{
+ public:
+  GEOMAlgo_PntInShape()
+  :
+    myTol(0.),
+    myErr(0)
+  {}
+  //
+  void SetShape(const TopoDS_Shape& theS)
+  {
+    myS=theS;
+  }
+  //
+  void SetTolerance(const Standard_Real theTol)
+  {
+    myTol=theTol;
+  }
+  //
+  const gp_Pnt& Pnt() const
+  {
+    return myP;
+  }
+  //
+  Standard_Integer ErrorStatus() const
+  {
+    return myErr;
+  }
+  //
+  void Perform()
+  {
+    myErr=PntInShape(myS, myTol, myP);
+  }
+  //
+ protected:
+  TopoDS_Shape myS;
+  Standard_Real myTol;
+  Standard_Integer myErr;
+  gp_Pnt myP;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_PntInShape> GEOMAlgo_VectorOfPntInShape;
+//
+//=======================================================================
+//class    : GEOMAlgo_CoincidenceChecker
+//purpose  : Checks the coincidence of the shape with the point
+//           of the other shape
+//=======================================================================
+class GEOMAlgo_CoincidenceChecker
+{
+ public:
+  GEOMAlgo_CoincidenceChecker()
+  :
+    myTol(0.),
+    myToCheck(Standard_False),
+    myFound(Standard_False)
+  {}
+  //
+  void SetShape1(const TopoDS_Shape& theS1)
+  {
+    myS1=theS1;
+  }
+  //
+  void SetShape2(const TopoDS_Shape& theS2)
+  {
+    myS2=theS2;
+  }
+  //
+  const TopoDS_Shape& Shape1() const
+  {
+    return myS1;
+  }
+  //
+  const TopoDS_Shape& Shape2() const
+  {
+    return myS2;
+  }
+  //
+  void SetPnt2(const gp_Pnt& theP2)
+  {
+    myP2=theP2;
+  }
+  //
+  void SetTolerance(const Standard_Real theTol)
+  {
+    myTol=theTol;
+  }
+  //
+  void SetToCheck(const Standard_Boolean theFlag)
+  {
+    myToCheck=theFlag;
+  }
+  //
+  Standard_Boolean ToCheck() const
+  {
+    return myToCheck;
+  }
+  //
+  void SetFound(const Standard_Boolean theFlag)
+  {
+    myFound=theFlag;
+  }
+  //
+  Standard_Boolean IsFound() const
+  {
+    return myFound;
+  }
+  //
+  void SetContext(const Handle(IntTools_Context)& theContext)
+  {
+    myContext=theContext;
+  }
+  //
+  const Handle(IntTools_Context)& Context() const
+  {
+    return myContext;
+  }
+  //
+  void Perform()
+  {
+    if (myToCheck) {
+      myFound=IsCoincident(myS1, myP2, myTol, myContext);
+    }
+  }
+  //
+ protected:
+  TopoDS_Shape myS1;
+  TopoDS_Shape myS2;
+  gp_Pnt myP2;
+  Standard_Real myTol;
+  Standard_Boolean myToCheck;
+  Standard_Boolean myFound;
+  Handle(IntTools_Context) myContext;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_CoincidenceChecker>
+  GEOMAlgo_VectorOfCoincidenceChecker;
+
 
 //=======================================================================
 //function : CheckCoincidence
@@ -90,72 +248,185 @@ static
 Standard_Boolean GEOMAlgo_GetInPlace::CheckCoincidence(const TopoDS_Shape& aS1,
                                                        const TopoDS_Shape& aS2)
 {
-  Standard_Boolean bOk;
   Standard_Integer iErr;
-  //Standard_Real aTol2;
-  TopAbs_ShapeEnum aType1, aType2;
-  TopAbs_State aState;
-  gp_Pnt aP1, aP2;
+  gp_Pnt aP2;
   //
   myErrorStatus=0;
   //
-  iErr=0;
-  bOk=Standard_False;
-  //aTol2=myTolerance*myTolerance;
-  aType1=aS1.ShapeType();
-  aType2=aS2.ShapeType();
-  //
   // 1. A point on shape #2 -> aP2
   if (myMapShapePnt.IsBound(aS2)) {
     aP2=myMapShapePnt.Find(aS2);
   }
-  else {//else 1
-    if (aType2==TopAbs_VERTEX) {
-      const TopoDS_Vertex& aV2=*((TopoDS_Vertex*)&aS2);
-      aP2=BRep_Tool::Pnt(aV2);
+  else {
+    iErr=PntInShape(aS2, myTolerance, aP2);
+    if (iErr) {
+      myErrorStatus=50;
+      return Standard_False;
     }
     //
-    else if (aType2==TopAbs_EDGE) {
-      const TopoDS_Edge& aE2=*((TopoDS_Edge*)&aS2);
-      iErr=PntInEdge(aE2, aP2);
-    }
+    myMapShapePnt.Bind(aS2, aP2);
+  }
+  //
+  // 2. Project the point aP2 on shape #1 and check
+  return IsCoincident(aS1, aP2, myTolerance, myContext);
+}
+//=======================================================================
+//function : CheckCoincidence
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::CheckCoincidence
+  (const GEOMAlgo_ListOfCoupleOfShapes& theLCS,
+   const TColStd_MapOfInteger& theMIn)
+{
+  Standard_Integer i, aNbCS, aNbS2, aNbToCheck;
+  TopTools_IndexedMapOfShape aMS2;
+  GEOMAlgo_ListIteratorOfListOfCoupleOfShapes aItCS;
+  GEOMAlgo_VectorOfCoincidenceChecker aVCC;
+  GEOMAlgo_VectorOfPntInShape aVPS;
+  //
+  myErrorStatus=0;
+  //
+  // 1. The pairs and the shapes #2 with no point yet
+  aNbToCheck=0;
+  aItCS.Initialize(theLCS);
+  for (i=1; aItCS.More(); aItCS.Next(), ++i) {
+    const GEOMAlgo_CoupleOfShapes& aCS=aItCS.Value();
+    const TopoDS_Shape& aS2=aCS.Shape2();
     //
-    else if (aType2==TopAbs_FACE) {
-      const TopoDS_Face& aF2=*((TopoDS_Face*)&aS2);
-      iErr=PntInFace(aF2, aP2);
-    }
+    GEOMAlgo_CoincidenceChecker& aCC=aVCC.Appended();
+    aCC.SetShape1(aCS.Shape1());
+    aCC.SetShape2(aS2);
+    aCC.SetTolerance(myTolerance);
+    aCC.SetFound(theMIn.Contains(i));
+    aCC.SetToCheck(!aCC.IsFound());
     //
-    else if (aType2==TopAbs_SOLID) {
-      const TopoDS_Solid& aZ2=*((TopoDS_Solid*)&aS2);
-      iErr=PntInSolid(aZ2, myTolerance, aP2);
+    if (aCC.ToCheck()) {
+      ++aNbToCheck;
+      if (!myMapShapePnt.IsBound(aS2)) {
+        aMS2.Add(aS2);
+      }
+    }
+  }
+  //
+  // 2. The points on the shapes #2
+  aNbS2=aMS2.Extent();
+  myProfile.AddCount("CoincidenceChecks", aNbToCheck);
+  myProfile.AddCount("InnerPoints", aNbS2);
+  for (i=1; i<=aNbS2; ++i) {
+    GEOMAlgo_PntInShape& aPS=aVPS.Appended();
+    aPS.SetShape(aMS2(i));
+    aPS.SetTolerance(myTolerance);
+  }
+  //
+  BOPTools_Parallel::Perform(myRunParallel, aVPS);
+  //
+  for (i=1; i<=aNbS2; ++i) {
+    const GEOMAlgo_PntInShape& aPS=aVPS(i-1);
+    if (!aPS.ErrorStatus()) {
+      myMapShapePnt.Bind(aMS2(i), aPS.Pnt());
+    }
+  }
+  //
+  // 3. The checks of the pairs
+  aNbCS=aVCC.Length();
+  for (i=0; i<aNbCS; ++i) {
+    GEOMAlgo_CoincidenceChecker& aCC=aVCC(i);
+    if (!aCC.ToCheck()) {
+      continue;
     }
     //
+    if (myMapShapePnt.IsBound(aCC.Shape2())) {
+      aCC.SetPnt2(myMapShapePnt.Find(aCC.Shape2()));
+    }
     else {
-      iErr=1;
+      aCC.SetToCheck(Standard_False);
     }
-    //
-    if (iErr) {
-      myErrorStatus=50;
-      return bOk;
+  }
+  //
+  BOPTools_Parallel::Perform(myRunParallel, aVCC, myContext);
+  //
+  // 4. The shapes IN in the order of the pairs
+  for (i=0; i<aNbCS; ++i) {
+    const GEOMAlgo_CoincidenceChecker& aCC=aVCC(i);
+    if (!aCC.ToCheck() && !aCC.IsFound()) {
+      myErrorStatus=50; // no point on the shape #2
+      return;
     }
     //
-    myMapShapePnt.Bind(aS2, aP2);
-  } //else 1
+    if (aCC.IsFound()) {
+      FillShapesIn(aCC.Shape1(), aCC.Shape2());
+    }
+  }
+}
+//=======================================================================
+//function : PntInShape
+//purpose  :
+//=======================================================================
+Standard_Integer PntInShape(const TopoDS_Shape& aS,
+                            const Standard_Real aTol,
+                            gp_Pnt& aP)
+{
+  Standard_Integer iErr;
+  TopAbs_ShapeEnum aType;
+  //
+  iErr=0;
+  aType=aS.ShapeType();
+  if (aType==TopAbs_VERTEX) {
+    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aS);
+    aP=BRep_Tool::Pnt(aV);
+  }
+  //
+  else if (aType==TopAbs_EDGE) {
+    const TopoDS_Edge& aE=*((TopoDS_Edge*)&aS);
+    iErr=PntInEdge(aE, aP);
+  }
+  //
+  else if (aType==TopAbs_FACE) {
+    const TopoDS_Face& aF=*((TopoDS_Face*)&aS);
+    iErr=PntInFace(aF, aP);
+  }
+  //
+  else if (aType==TopAbs_SOLID) {
+    const TopoDS_Solid& aZ=*((TopoDS_Solid*)&aS);
+    iErr=PntInSolid(aZ, aTol, aP);
+  }
+  //
+  else {
+    iErr=1;
+  }
+  //
+  return iErr;
+}
+//=======================================================================
+//function : IsCoincident
+//purpose  : Projects the point aP2 on the shape aS1 and checks
+//           the distance
+//=======================================================================
+Standard_Boolean IsCoincident(const TopoDS_Shape& aS1,
+                              const gp_Pnt& aP2,
+                              const Standard_Real aTol,
+                              const Handle(IntTools_Context)& aCtx)
+{
+  Standard_Boolean bOk;
+  TopAbs_ShapeEnum aType1;
+  TopAbs_State aState;
+  //
+  bOk=Standard_False;
+  aType1=aS1.ShapeType();
   //
-  // 2. Project the point aP2 on shape #1 and check
   if (aType1==TopAbs_EDGE) {
     Standard_Integer aNbPoints;
     Standard_Real aDmin, aT, aT1, aT2, dT;
     //
     const TopoDS_Edge& aE1=*((TopoDS_Edge*)&aS1);
     //
-    GeomAPI_ProjectPointOnCurve& aPPC=myContext->ProjPC(aE1);
+    GeomAPI_ProjectPointOnCurve& aPPC=aCtx->ProjPC(aE1);
     aPPC.Perform(aP2);
     aNbPoints=aPPC.NbPoints();
     if (aNbPoints) {
       aDmin=aPPC.LowerDistance();
       aT=aPPC.LowerDistanceParameter();
-      if (aDmin < myTolerance) {
+      if (aDmin < aTol) {
         dT=1.e-12;
         BRep_Tool::Curve(aE1, aT1, aT2);
         if(aT > (aT1-dT) && aT < (aT2+dT)) {
@@ -163,30 +434,23 @@ Standard_Boolean GEOMAlgo_GetInPlace::CheckCoincidence(const TopoDS_Shape& aS1,
         }
       }
     }
-    //else {
-    // iErr=2;
-    //}
   }//if (aType1==TopAbs_EDGE) {
   //
   else if (aType1==TopAbs_FACE) {
     const TopoDS_Face& aF1=*((TopoDS_Face*)&aS1);
     //
-    bOk=myContext->IsValidPointForFace(aP2, aF1, myTolerance);
+    bOk=aCtx->IsValidPointForFace(aP2, aF1, aTol);
   }
   //
   else if (aType1==TopAbs_SOLID) {
     const TopoDS_Solid& aZ1=*((TopoDS_Solid*)&aS1);
     //
-    BRepClass3d_SolidClassifier& aSC=myContext->SolidClassifier(aZ1);
-    aSC.Perform(aP2, myTolerance);
+    BRepClass3d_SolidClassifier& aSC=aCtx->SolidClassifier(aZ1);
+    aSC.Perform(aP2, aTol);
     aState=aSC.State();
     bOk=(aState==TopAbs_IN);
   }
   //
-  if (iErr) {
-    myErrorStatus=50;
-  }
-  //
   return bOk;
 }
 //=======================================================================
@@ -45,7 +45,6 @@
 #include <TopExp.hxx>
 
 #include <GProp_GProps.hxx>
-#include <BRepGProp.hxx>
 
 
 static
@@ -60,6 +59,12 @@ static
 //=======================================================================
 void GEOMAlgo_GetInPlace::CheckGProps()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "CheckGProps");
+  myGPropsCache=mySharedGProps;
+  if (myGPropsCache.IsNull()) {
+    myGPropsCache=new GEOMAlgo_GPropsCache;
+  }
+  //
   myFound=Standard_True;
   CheckGProps(myArgument);
 }
@@ -177,44 +182,39 @@ Standard_Integer GEOMAlgo_GetInPlace::CheckGProps(const TopoDS_Shape& theS)
 //=======================================================================
 Standard_Boolean GEOMAlgo_GetInPlace::CompareGProps
                         (const TopoDS_Shape         &theShape1,
-                         const TopTools_ListOfShape &theListShape2) const
+                         const TopTools_ListOfShape &theListShape2)
 {
   Standard_Boolean                   aResult = Standard_True;
-  TopoDS_Compound                    aComp2;
-  BRep_Builder                       aBuilder;
-  TopTools_ListIteratorOfListOfShape anIt(theListShape2);
-
-  aBuilder.MakeCompound(aComp2);
-
-  for (; anIt.More(); anIt.Next()) {
-    const TopoDS_Shape &aShape2 = anIt.Value();
-
-    aBuilder.Add(aComp2, aShape2);
-  }
 
   // Compute General Properties.
   GProp_GProps           aG1;
   GProp_GProps           aG2;
   const Standard_Real    aTolCG2     = myTolCG*myTolCG;
-  Standard_Boolean       bOnlyClosed = Standard_False;
   const TopAbs_ShapeEnum aType       = theShape1.ShapeType();
   const Standard_Integer iDim        = Dimension(aType);
 
   if (iDim == 0) {
+    // the vertices shared by the shapes of the image count once
+    TopoDS_Compound                    aComp2;
+    BRep_Builder                       aBuilder;
+    TopTools_ListIteratorOfListOfShape anIt(theListShape2);
+
+    aBuilder.MakeCompound(aComp2);
+
+    for (; anIt.More(); anIt.Next()) {
+      const TopoDS_Shape &aShape2 = anIt.Value();
+
+      aBuilder.Add(aComp2, aShape2);
+    }
+
     PointProperties(theShape1, aG1);
     PointProperties(aComp2,    aG2);
   }
-  else if (iDim == 1) {
-    BRepGProp::LinearProperties(theShape1, aG1);
-    BRepGProp::LinearProperties(aComp2,    aG2);
-  }
-  else if (iDim == 2) {
-    BRepGProp::SurfaceProperties(theShape1, aG1);
-    BRepGProp::SurfaceProperties(aComp2,    aG2);
-  }
-  else if (iDim == 3) {
-    BRepGProp::VolumeProperties(theShape1, aG1, bOnlyClosed);
-    BRepGProp::VolumeProperties(aComp2,    aG2, bOnlyClosed);
+  else if (iDim > 0) {
+    // The properties of the image are summed up from the ones
+    // of its parts, that are shared by the images
+    aG1 = myGPropsCache->Properties(theShape1, iDim);
+    myGPropsCache->AddProperties(theListShape2, iDim, aG2);
   } else {
     return Standard_False;
   }
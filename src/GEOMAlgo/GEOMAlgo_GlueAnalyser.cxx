@@ -26,11 +26,6 @@
 
 #include <GEOMAlgo_GlueAnalyser.hxx>
 
-#include <Bnd_Box.hxx>
-#include <Bnd_HArray1OfBox.hxx>
-#include <Bnd_BoundSortBox.hxx>
-#include <BRepBndLib.hxx>
-
 #include <TColStd_ListIteratorOfListOfInteger.hxx>
 #include <TColStd_ListOfInteger.hxx>
 
@@ -41,6 +36,7 @@
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Vertex.hxx>
 
+#include <BRep_Tool.hxx>
 #include <BRep_Builder.hxx>
 
 #include <TopExp.hxx>
@@ -52,8 +48,7 @@
 #include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
 #include <TopTools_MapOfShape.hxx>
 
-#include <GEOMAlgo_IndexedDataMapOfIntegerShape.hxx>
-#include <GEOMAlgo_IndexedDataMapOfShapeBox.hxx>
+#include <GEOMAlgo_PointClusterer.hxx>
 #include <GEOMAlgo_PassKeyShape.hxx>
 #include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
 #include <GEOMAlgo_AlgoTools.hxx>
@@ -124,6 +119,8 @@
     return;
   }
   //
+  PrepareTopologyIndex();
+  //
   // Initialize the context
   GEOMAlgo_ShapeAlgo::Perform();
   //
@@ -160,39 +157,30 @@
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, i, aNbV, aIndex, aNbVSD;
-  TColStd_ListIteratorOfListOfInteger aIt;
-  Handle(Bnd_HArray1OfBox) aHAB;
-  Bnd_BoundSortBox aBSB;
-  TopoDS_Shape aSTmp, aVF;
+  Standard_Integer j, k, i, aNbV, aIndex, aNbVSD;
+  TopoDS_Shape aVF;
   TopoDS_Vertex aVnew;
-  TopTools_IndexedMapOfShape aMV, aMVProcessed;
+  TopTools_IndexedMapOfShape aMVProcessed;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBox aMSB;
+  GEOMAlgo_PointClusterer aClusterer;
   //
-  TopExp::MapShapes(myShape, TopAbs_VERTEX, aMV);
+  const TopTools_IndexedMapOfShape& aMV=myTopology->Shapes(TopAbs_VERTEX);
   aNbV=aMV.Extent();
   if (!aNbV) {
     myErrorStatus=2; // no vertices in source shape
     return;
   }
   //
-  aHAB=new Bnd_HArray1OfBox(1, aNbV);
-  //
+  // the boxes of the vertices enlarged by the tolerance
+  aClusterer.SetMetric(GEOMAlgo_PointClusterer::M_Box);
+  aClusterer.SetGap(myTol);
+  aClusterer.SetRunParallel(myRunParallel);
   for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
-    Bnd_Box aBox;
-    //
-    aBox.SetGap(myTol);
-    BRepBndLib::Add(aV, aBox);
-    aHAB->SetValue(i, aBox);
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
+    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
+    aClusterer.Add(BRep_Tool::Pnt(aV), BRep_Tool::Tolerance(aV));
   }
-  //
-  aBSB.Initialize(aHAB);
+  aClusterer.Perform();
   //
   for (i=1; i<=aNbV; ++i) {
     const TopoDS_Shape& aV=aMV(i);
@@ -201,9 +189,7 @@
       continue;
     }
     //
-    const Bnd_Box& aBoxV=aMSB.FindFromKey(aV);
-    const TColStd_ListOfInteger& aLI=aBSB.Compare(aBoxV);
-    aNbVSD=aLI.Extent();
+    aNbVSD=aClusterer.NbNeighbours(i);
     if (!aNbVSD) {
       myErrorStatus=3; // it must not be
       return;
@@ -212,10 +198,9 @@
     // Images
     TopTools_ListOfShape aLVSD;
     //
-    aIt.Initialize(aLI);
-    for (j=0; aIt.More(); aIt.Next(), ++j) {
-      aIndex=aIt.Value();
-      const TopoDS_Shape& aVx=aMIS.FindFromKey(aIndex);
+    for (k=1, j=0; k<=aNbVSD; ++k, ++j) {
+      aIndex=aClusterer.Neighbour(i, k);
+      const TopoDS_Shape& aVx=aMV(aIndex);
       if(!j) {
         aVF=aVx;
       }
@@ -265,12 +250,11 @@
   //
   Standard_Integer i, aNbF, aNbSDF, iErr;
   TopoDS_Shape aNewShape;
-  TopTools_IndexedMapOfShape aMF;
   TopTools_ListIteratorOfListOfShape aItS;
   GEOMAlgo_PassKeyShape aPKF;
   GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape aMPKLF;
   //
-  TopExp::MapShapes(myShape, aType, aMF);
+  const TopTools_IndexedMapOfShape& aMF=myTopology->Shapes(aType);
   //
   aNbF=aMF.Extent();
   for (i=1; i<=aNbF; ++i) {
@@ -278,12 +262,10 @@
     //
     //aPKF.Clear();//qft
     if (aType==TopAbs_FACE) {
-      const TopoDS_Face& aF=TopoDS::Face(aS);
-      FacePassKey(aF, aPKF);
+      FacePassKey(i, aPKF);
     }
     else if (aType==TopAbs_EDGE) {
-      const TopoDS_Edge& aE=TopoDS::Edge(aS);
-      EdgePassKey(aE, aPKF);
+      EdgePassKey(i, aPKF);
     }
     //
     if (myErrorStatus) {
@@ -303,7 +285,8 @@
   }
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext); //XX
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext,
+                                            myRunParallel); //XX
     if (iErr) {
       myErrorStatus=200;
       return;
@@ -341,11 +324,10 @@
 {
   myErrorStatus=0;
   //
-  Standard_Integer i, aNbF, aNbS, aNbC, aNbX;
+  Standard_Integer i, aNbF, aNbS, aNbC, aNbX, iF;
   TopoDS_Compound aCmp;
   BRep_Builder aBB;
-  TopTools_IndexedDataMapOfShapeListOfShape aMFS;
-  TopTools_IndexedMapOfShape aMx, aMS;
+  TopTools_IndexedMapOfShape aMx;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
   GEOMAlgo_CoupleOfShapes aCS;
   //
@@ -354,7 +336,8 @@
   //
   aBB.MakeCompound(aCmp);
   //
-  TopExp::MapShapesAndAncestors(myShape, TopAbs_FACE, TopAbs_SOLID, aMFS);
+  const TopTools_IndexedMapOfShape& aMF=myTopology->Shapes(TopAbs_FACE);
+  const TopTools_IndexedMapOfShape& aMS=myTopology->Shapes(TopAbs_SOLID);
   //
   aItIm.Initialize(myImages);
   for (; aItIm.More(); aItIm.Next()) {
@@ -374,16 +357,16 @@
     aFx[0]=aLF.First();
     aFx[1]=aLF.Last();
     for (i=0; i<2; ++i) {
-      if (!aMFS.Contains(aFx[i])) {
+      iF=aMF.FindIndex(aFx[i]);
+      if (!iF) {
         continue;// it must not be so
       }
       //
-      const TopTools_ListOfShape& aLS=aMFS.FindFromKey(aFx[i]);
-      aNbS=aLS.Extent();
+      aNbS=myTopology->NbIds(GEOMAlgo_TopologyIndex::T_FaceSolids, iF);
       if (aNbS!=1) {
         continue;
       }
-      aSx[i]=aLS.First();
+      aSx[i]=aMS(myTopology->Id(GEOMAlgo_TopologyIndex::T_FaceSolids, iF, 1));
     }
     //
     if (aSx[0].IsNull() || aSx[1].IsNull()) {
@@ -435,7 +418,6 @@
   myResult=aCmp;
   //
   // check alone solids
-  TopExp::MapShapes(myShape, TopAbs_SOLID, aMS);
   //
   aNbX=aMx.Extent();
   for (i=1; i<=aNbX; ++i) {
@@ -26,10 +26,12 @@
 #include <GEOMAlgo_GlueDetector.hxx>
 
 #include <Bnd_Box.hxx>
-#include <NCollection_UBTreeFiller.hxx>
+#include <NCollection_Array1.hxx>
+#include <OSD_Parallel.hxx>
 
 #include <TColStd_ListOfInteger.hxx>
 #include <TColStd_ListIteratorOfListOfInteger.hxx>
+#include <TColStd_MapOfInteger.hxx>
 #include <TColStd_MapIteratorOfMapOfInteger.hxx>
 
 #include <TopoDS_Shape.hxx>
@@ -57,22 +59,18 @@
 #include <TopExp_Explorer.hxx>
 #include <TopTools_MapOfShape.hxx>
 
-#include <GEOMAlgo_BndSphereTree.hxx>
-#include <GEOMAlgo_BndSphere.hxx>
-#include <GEOMAlgo_IndexedDataMapOfShapeBndSphere.hxx>
-
-#include <GEOMAlgo_IndexedDataMapOfIntegerShape.hxx>
+#include <GEOMAlgo_PointClusterer.hxx>
 #include <GEOMAlgo_PassKeyShape.hxx>
 #include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
 #include <GEOMAlgo_AlgoTools.hxx>
 
+
 //
 static
   Standard_Integer CheckAncesstors
   (const TopoDS_Shape& aVSD,
    const TopTools_MapOfShape& aMVSD,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMVE,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMEV,
+   const GEOMAlgo_TopologyIndex& aTI,
    TopTools_IndexedDataMapOfShapeListOfShape& aMEVZ);
 
 //=======================================================================
@@ -108,6 +106,7 @@ void GEOMAlgo_GlueDetector::Perform()
   myErrorStatus=0;
   myWarningStatus=0;
   myStickedShapes.Clear();
+  myProfile.Clear();
   //
   CheckData();
   if (myErrorStatus) {
@@ -117,12 +116,20 @@ void GEOMAlgo_GlueDetector::Perform()
   // Initialize the context
   GEOMAlgo_GluerAlgo::Perform();
   //
+  {
+    GEOMAlgo_ProfileStage aPS(myProfile, "TopologyIndex");
+    PrepareTopologyIndex();
+  }
+  //
   DetectVertices();
   if (myErrorStatus) {
     return;
   }
   //
-  CheckDetected();
+  {
+    GEOMAlgo_ProfileStage aPS(myProfile, "CheckDetected");
+    CheckDetected();
+  }
   if (myErrorStatus) {
     return;
   }
@@ -143,137 +150,46 @@ void GEOMAlgo_GlueDetector::Perform()
 //=======================================================================
 void GEOMAlgo_GlueDetector::DetectVertices()
 {
-  Standard_Integer j, i, aNbV, aNbVSD;
-  Standard_Real aTolV;
-  gp_Pnt aPV;
+  GEOMAlgo_ProfileStage aPS(myProfile, "DetectVertices");
+  Standard_Integer i, aNbV, aNbC;
   TColStd_ListIteratorOfListOfInteger aIt;
-  TopoDS_Shape aVF;
-  TopTools_IndexedMapOfShape aMV;
-  TopTools_MapOfShape aMVProcessed;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
-  TopTools_DataMapOfShapeListOfShape aMVV;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBndSphere aMSB;
-  GEOMAlgo_BndSphereTreeSelector aSelector;
-  GEOMAlgo_BndSphereTree aBBTree;
-  NCollection_UBTreeFiller <Standard_Integer, GEOMAlgo_BndSphere> aTreeFiller(aBBTree);
+  NCollection_Vector<TColStd_ListOfInteger> aChains;
+  GEOMAlgo_PointClusterer aClusterer;
   //
   myErrorStatus=0;
   //
-  TopExp::MapShapes(myArgument, TopAbs_VERTEX, aMV);
+  const TopTools_IndexedMapOfShape& aMV=myTopology->Shapes(TopAbs_VERTEX);
   aNbV=aMV.Extent();
   if (!aNbV) {
     myErrorStatus=2; // no vertices in source shape
     return;
   }
   //
+  aClusterer.SetGap(myTolerance);
+  aClusterer.SetRunParallel(myRunParallel);
   for (i=1; i<=aNbV; ++i) {
-    GEOMAlgo_BndSphere aBox;
-    //
     const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    aPV=BRep_Tool::Pnt(aV);
-    aTolV=BRep_Tool::Tolerance(aV);
-    //
-    aBox.SetGap(myTolerance);
-    aBox.SetCenter(aPV);
-    aBox.SetRadius(aTolV);
-    //
-    aTreeFiller.Add(i, aBox);
-    //
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
+    aClusterer.Add(BRep_Tool::Pnt(aV), BRep_Tool::Tolerance(aV));
   }
-  //
-  aTreeFiller.Fill();
+  aClusterer.Perform();
+  myProfile.AddCount("TestedPairs", aClusterer.NbTested());
+  myProfile.AddCount("CandidatePairs", aClusterer.NbPairs());
   //
   //---------------------------------------------------
   // Chains
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
-    //
-    if (aMVProcessed.Contains(aV)) {
-      continue;
-    }
-    //
-    Standard_Integer aNbIP, aIP, aNbIP1, aIP1;
+  aClusterer.MakeChains(aChains, Standard_False);
+  aNbC=aChains.Length();
+  for (i=0; i<aNbC; ++i) {
     TopTools_ListOfShape aLVSD;
-    TColStd_MapOfInteger aMIP, aMIP1, aMIPC;
-    TColStd_MapIteratorOfMapOfInteger aIt1;
     //
-    aMIP.Add(i);
-    for(;;) {
-      aNbIP=aMIP.Extent();
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        if (aMIPC.Contains(aIP)) {
-          continue;
-        }
-        //
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        const GEOMAlgo_BndSphere& aBoxVP=aMSB.FindFromKey(aVP);
-        //
-        aSelector.Clear();
-        aSelector.SetBox(aBoxVP);
-        //
-        aNbVSD=aBBTree.Select(aSelector);
-        if (!aNbVSD) {
-          continue;  // it should not be so [at least IP itself]
-        }
-        //
-        const TColStd_ListOfInteger& aLI=aSelector.Indices();
-        aIt.Initialize(aLI);
-        for (; aIt.More(); aIt.Next()) {
-          aIP1=aIt.Value();
-          if (aMIP.Contains(aIP1)) {
-            continue;
-          }
-          aMIP1.Add(aIP1);
-        } //for (; aIt.More(); aIt.Next()) {
-      }//for(; aIt1.More(); aIt1.Next()) {
-      //
-      aNbIP1=aMIP1.Extent();
-      if (!aNbIP1) {
-        break;
-      }
-      //
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIPC.Add(aIP);
-      }
-      //
-      aMIP.Clear();
-      aIt1.Initialize(aMIP1);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIP.Add(aIP);
-      }
-      aMIP1.Clear();
-    }// while(1)
-    //
-    // Fill myImages
-    aNbIP=aMIPC.Extent();
-    //
-    if (!aNbIP) {// no SD vertices is found
-      aMVProcessed.Add(aV);
-      continue;
+    aIt.Initialize(aChains(i));
+    for (; aIt.More(); aIt.Next()) {
+      aLVSD.Append(aMV(aIt.Value()));
     }
-    //else { // SD vertices founded [ aMIPC ]
-    aIt1.Initialize(aMIPC);
-    for(j=0; aIt1.More(); aIt1.Next(), ++j) {
-      aIP=aIt1.Key();
-      const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-      if (!j) {
-        aVF=aVP;
-      }
-      aLVSD.Append(aVP);
-      aMVProcessed.Add(aVP);
-    }
-    //}
-    myImages.Bind(aVF, aLVSD);
-  }// for (i=1; i<=aNbV; ++i) {
+    myImages.Bind(aLVSD.First(), aLVSD);
+  }
   //------------------------------
   // Origins
   aItIm.Initialize(myImages);
@@ -295,6 +211,7 @@ void GEOMAlgo_GlueDetector::DetectVertices()
 //=======================================================================
 void GEOMAlgo_GlueDetector::DetectFaces()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "DetectFaces");
   DetectShapes(TopAbs_FACE);
 }
 //=======================================================================
@@ -303,9 +220,41 @@ void GEOMAlgo_GlueDetector::DetectFaces()
 //=======================================================================
 void GEOMAlgo_GlueDetector::DetectEdges()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "DetectEdges");
   DetectShapes(TopAbs_EDGE);
 }
 //=======================================================================
+//class    : GEOMAlgo_PassKeyFunctor
+//purpose  : builds the pass keys of the edges or of the faces
+//=======================================================================
+class GEOMAlgo_PassKeyFunctor
+{
+ public:
+  GEOMAlgo_PassKeyFunctor(const GEOMAlgo_GlueDetector& theGD,
+                          const TopAbs_ShapeEnum theType,
+                          NCollection_Array1<GEOMAlgo_PassKeyShape>& thePKs)
+  :
+    myGD(theGD),
+    myType(theType),
+    myPKs(thePKs)
+  {}
+  //
+  void operator()(const Standard_Integer theIndex) const
+  {
+    if (myType==TopAbs_FACE) {
+      myGD.FacePassKey(theIndex, myPKs(theIndex));
+    }
+    else {
+      myGD.EdgePassKey(theIndex, myPKs(theIndex));
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_GlueDetector& myGD;
+  TopAbs_ShapeEnum myType;
+  NCollection_Array1<GEOMAlgo_PassKeyShape>& myPKs;
+};
+//=======================================================================
 //function : DetectShapes
 //purpose  :
 //=======================================================================
@@ -313,50 +262,65 @@ void GEOMAlgo_GlueDetector::DetectShapes(const TopAbs_ShapeEnum aType)
 {
   Standard_Boolean bDegenerated;
   Standard_Integer i, aNbF, aNbSDF, iErr;
-  TopTools_IndexedMapOfShape aMF;
+  Standard_Size aNbCandidates, aNbTested;
   TopTools_ListIteratorOfListOfShape aItLS;
-  GEOMAlgo_PassKeyShape aPKF;
   GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape aMPKLF;
   //
   myErrorStatus=0;
   //
-  TopExp::MapShapes(myArgument, aType, aMF);
+  const TopTools_IndexedMapOfShape& aMF=myTopology->Shapes(aType);
   //
   aNbF=aMF.Extent();
+  if (!aNbF) {
+    return;
+  }
+  //
+  // 1. The keys of the shapes.
+  //    They depend on myOrigins only, so they are built apart
+  NCollection_Array1<GEOMAlgo_PassKeyShape> aPKs(1, aNbF);
+  GEOMAlgo_PassKeyFunctor aFunctor(*this, aType, aPKs);
+  OSD_Parallel::For(1, aNbF+1, aFunctor, !myRunParallel);
+  //
+  // 2. The groups of the shapes with the same key, in the order
+  //    of the first shapes of the groups
   for (i=1; i<=aNbF; ++i) {
     const TopoDS_Shape& aS=aMF(i);
+    const GEOMAlgo_PassKeyShape& aPK=aPKs(i);
     //
-    if (aType==TopAbs_FACE) {
-      const TopoDS_Face& aF=*((TopoDS_Face*)&aS);
-      FacePassKey(aF, aPKF);
-    }
-    else if (aType==TopAbs_EDGE) {
-      const TopoDS_Edge& aE=*((TopoDS_Edge*)&aS);
-      EdgePassKey(aE, aPKF);
-    }
-    //
-    if (myErrorStatus) {
-      return;
-    }
-    //
-    if (aMPKLF.Contains(aPKF)) {
-      TopTools_ListOfShape& aLSDF=aMPKLF.ChangeFromKey(aPKF);
-      aLSDF.Append(aS);
+    TopTools_ListOfShape* pLSDF=aMPKLF.ChangeSeek(aPK);
+    if (pLSDF) {
+      pLSDF->Append(aS);
     }
     else {
       TopTools_ListOfShape aLSDF;
       //
       aLSDF.Append(aS);
-      aMPKLF.Add(aPKF, aLSDF);
+      aMPKLF.Add(aPK, aLSDF);
     }
   }
+  myProfile.AddCount(aType==TopAbs_EDGE ? "EdgePassKeyGroups" :
+                                         "FacePassKeyGroups",
+                     aMPKLF.Extent());
+  //
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTolerance, myContext);
+    aNbCandidates=0;
+    aNbTested=0;
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTolerance, myContext,
+                                            myRunParallel, myUseOBB,
+                                            &aNbCandidates, &aNbTested);
     if (iErr) {
       myErrorStatus=200;
       return;
     }
+    // the candidates left by the axis-aligned boxes and the ones
+    // tested by the projection, i.e. left by the oriented boxes
+    myProfile.AddCount(aType==TopAbs_EDGE ? "EdgeSDCandidates" :
+                                           "FaceSDCandidates",
+                       aNbCandidates);
+    myProfile.AddCount(aType==TopAbs_EDGE ? "EdgeSDTested" :
+                                           "FaceSDTested",
+                       aNbTested);
   }
   //
   // Images/Origins
@@ -398,19 +362,19 @@ void GEOMAlgo_GlueDetector::DetectShapes(const TopAbs_ShapeEnum aType)
 //function : FacePassKey
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GlueDetector::FacePassKey(const TopoDS_Face& aF,
-                                        GEOMAlgo_PassKeyShape& aPK)
+void GEOMAlgo_GlueDetector::FacePassKey(const Standard_Integer theIndex,
+                                        GEOMAlgo_PassKeyShape& aPK) const
 {
-  Standard_Integer i, aNbE;
+  Standard_Integer k, aNbE;
   TopoDS_Shape aER;
   TopTools_ListOfShape aLE;
-  TopTools_IndexedMapOfShape aME;
   //
-  TopExp::MapShapes(aF, TopAbs_EDGE, aME);
+  const TopTools_IndexedMapOfShape& aME=myTopology->Shapes(TopAbs_EDGE);
   //
-  aNbE=aME.Extent();
-  for (i=1; i<=aNbE; ++i) {
-    const TopoDS_Shape& aE=aME(i);
+  aNbE=myTopology->NbIds(GEOMAlgo_TopologyIndex::T_FaceEdges, theIndex);
+  for (k=1; k<=aNbE; ++k) {
+    const TopoDS_Shape& aE=
+      aME(myTopology->Id(GEOMAlgo_TopologyIndex::T_FaceEdges, theIndex, k));
     //
     const TopoDS_Edge& aEE=*((TopoDS_Edge*)&aE);
     if (BRep_Tool::Degenerated(aEE)) {
@@ -431,27 +395,26 @@ void GEOMAlgo_GlueDetector::FacePassKey(const TopoDS_Face& aF,
 //function : EdgePassKey
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GlueDetector::EdgePassKey(const TopoDS_Edge& aE,
-                                        GEOMAlgo_PassKeyShape& aPK)
+void GEOMAlgo_GlueDetector::EdgePassKey(const Standard_Integer theIndex,
+                                        GEOMAlgo_PassKeyShape& aPK) const
 {
-  TopAbs_Orientation aOr;
+  Standard_Integer k, aNbV;
   TopoDS_Shape aVR;
-  TopoDS_Iterator aIt;
   TopTools_ListOfShape aLV;
   //
-  aIt.Initialize(aE);
-  for (; aIt.More(); aIt.Next()) {
-    const TopoDS_Shape& aV=aIt.Value();
-    aOr=aV.Orientation();
-    if (aOr==TopAbs_FORWARD || aOr==TopAbs_REVERSED) {
-      if (myOrigins.IsBound(aV)) {
-        aVR=myOrigins.Find(aV);
-      }
-      else {
-        aVR=aV;
-      }
-      aLV.Append(aVR);
+  const TopTools_IndexedMapOfShape& aMV=myTopology->Shapes(TopAbs_VERTEX);
+  //
+  aNbV=myTopology->NbIds(GEOMAlgo_TopologyIndex::T_EdgeBounds, theIndex);
+  for (k=1; k<=aNbV; ++k) {
+    const TopoDS_Shape& aV=
+      aMV(myTopology->Id(GEOMAlgo_TopologyIndex::T_EdgeBounds, theIndex, k));
+    if (myOrigins.IsBound(aV)) {
+      aVR=myOrigins.Find(aV);
+    }
+    else {
+      aVR=aV;
     }
+    aLV.Append(aVR);
   }
   //
   aPK.SetShapes(aLV);
@@ -462,53 +425,23 @@ void GEOMAlgo_GlueDetector::EdgePassKey(const TopoDS_Edge& aE,
 //=======================================================================
 void GEOMAlgo_GlueDetector::CheckDetected()
 {
-  TopoDS_Iterator aItA;
-  TopExp_Explorer aExp;
-  TopTools_ListOfShape aLV;
-  TopTools_MapOfShape aMFence;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
-  TopTools_IndexedDataMapOfShapeListOfShape aMVE, aMEV;
   //
-  // 1. aMVE, aMEV
-  TopExp::MapShapesAndAncestors(myArgument, TopAbs_VERTEX, TopAbs_EDGE, aMVE);
-  //
-  aExp.Init(myArgument, TopAbs_EDGE);
-  for (; aExp.More(); aExp.Next()) {
-    const TopoDS_Shape& aE=aExp.Current();
-    //
-    aLV.Clear();
-    aMFence.Clear();
-    aItA.Initialize(aE);
-    for (; aItA.More(); aItA.Next()) {
-      const TopoDS_Shape& aV=aItA.Value();
-      if (aMFence.Add(aV)) {
-        aLV.Append(aV);
-      }
-    }
-    //
-    aMEV.Add(aE, aLV);
-  }
-  // 2. Checking
   aItIm.Initialize(myImages);
   for (; aItIm.More(); aItIm.Next()) {
     //const TopoDS_Shape& aV=aItIm.Key();
     const TopTools_ListOfShape& aLVSD=aItIm.Value();
-    CheckDetected(aLVSD, aMVE, aMEV);
+    CheckDetected(aLVSD);
   }
 }
 //=======================================================================
 //function : CheckDetected
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GlueDetector::CheckDetected
-  (const TopTools_ListOfShape& aLVSD,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMVE,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMEV)
+void GEOMAlgo_GlueDetector::CheckDetected(const TopTools_ListOfShape& aLVSD)
 {
   Standard_Integer aNbVSD, iRet;
-  TopExp_Explorer aExp, aExpA;
-  TopTools_MapOfShape aMFence, aMVSD;
-  TopTools_ListOfShape aLV;
+  TopTools_MapOfShape aMVSD;
   TopTools_ListIteratorOfListOfShape aItLS;
   //
   myErrorStatus=0;
@@ -528,7 +461,7 @@ void GEOMAlgo_GlueDetector::CheckDetected
   for (; aItLS.More(); aItLS.Next()) {
     const TopoDS_Shape& aVSD=aItLS.Value();
     //
-    iRet=CheckAncesstors(aVSD, aMVSD, aMVE, aMEV, myStickedShapes);
+    iRet=CheckAncesstors(aVSD, aMVSD, *myTopology, myStickedShapes);
     if (iRet) {
       // Sticked shapes detected
       myWarningStatus=2;
@@ -542,34 +475,33 @@ void GEOMAlgo_GlueDetector::CheckDetected
 Standard_Integer CheckAncesstors
   (const TopoDS_Shape& aVSD,
    const TopTools_MapOfShape& aMVSD,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMVE,
-   const TopTools_IndexedDataMapOfShapeListOfShape& aMEV,
+   const GEOMAlgo_TopologyIndex& aTI,
    TopTools_IndexedDataMapOfShapeListOfShape& aMEVZ)
 {
-  TopTools_ListOfShape *pLE, *pLV, *pLVZ;
-  Standard_Integer iRet, aNbVX;
-  TopTools_ListIteratorOfListOfShape aItLE, aItLV;
+  TopTools_ListOfShape *pLVZ;
+  Standard_Integer iRet, aNbVX, iV, iE, i, j, aNbE, aNbV;
   TopTools_MapOfShape aMFence;
   TopTools_ListOfShape aLVX;
   //
   iRet=0;
   //
-  pLE=const_cast<TopTools_IndexedDataMapOfShapeListOfShape&>(aMVE).ChangeSeek(aVSD);
-  if (!pLE) {
+  const TopTools_IndexedMapOfShape& aMV=aTI.Shapes(TopAbs_VERTEX);
+  const TopTools_IndexedMapOfShape& aME=aTI.Shapes(TopAbs_EDGE);
+  //
+  iV=aMV.FindIndex(aVSD);
+  if (!iV) {
     return iRet;
   }
-  aItLE.Initialize(*pLE);
-  for (; aItLE.More(); aItLE.Next()) {
-    const TopoDS_Shape& aE=aItLE.Value();
+  aNbE=aTI.NbIds(GEOMAlgo_TopologyIndex::T_VertexEdges, iV);
+  for (i=1; i<=aNbE; ++i) {
+    iE=aTI.Id(GEOMAlgo_TopologyIndex::T_VertexEdges, iV, i);
+    const TopoDS_Shape& aE=aME(iE);
     //
-    pLV=const_cast<TopTools_IndexedDataMapOfShapeListOfShape&>(aMEV).ChangeSeek(aE);
-    if (!pLV) {
-      continue; // it should be not so
-    }
     aLVX.Clear();
-    aItLV.Initialize(*pLV);
-    for (; aItLV.More(); aItLV.Next()) {
-      const TopoDS_Shape& aV=aItLV.Value();
+    aNbV=aTI.NbIds(GEOMAlgo_TopologyIndex::T_EdgeVertices, iE);
+    for (j=1; j<=aNbV; ++j) {
+      const TopoDS_Shape& aV=
+        aMV(aTI.Id(GEOMAlgo_TopologyIndex::T_EdgeVertices, iE, j));
       if (!aV.IsSame(aVSD)) {
         if (aMVSD.Contains(aV)) {
           if (aMFence.Add(aV)) {
@@ -71,26 +71,26 @@ protected:
   Standard_EXPORT
     void DetectShapes(const TopAbs_ShapeEnum aType) ;
 
+  //! Builds the key of the edge #theIndex of the topology index.
   Standard_EXPORT
-    void EdgePassKey(const TopoDS_Edge& aE,
-                     GEOMAlgo_PassKeyShape& aPK) ;
+    void EdgePassKey(const Standard_Integer theIndex,
+                     GEOMAlgo_PassKeyShape& aPK) const;
 
+  //! Builds the key of the face #theIndex of the topology index.
   Standard_EXPORT
-    void FacePassKey(const TopoDS_Face& aF,
-                     GEOMAlgo_PassKeyShape& aPK) ;
+    void FacePassKey(const Standard_Integer theIndex,
+                     GEOMAlgo_PassKeyShape& aPK) const;
 
   Standard_EXPORT
     void CheckDetected();
   //
   Standard_EXPORT
-    void CheckDetected
-      (const TopTools_ListOfShape& aLVSD,
-       const TopTools_IndexedDataMapOfShapeListOfShape& aMVE,
-       const TopTools_IndexedDataMapOfShapeListOfShape& aMEV);
+    void CheckDetected(const TopTools_ListOfShape& aLVSD);
 
 
  protected:
   TopTools_IndexedDataMapOfShapeListOfShape myStickedShapes;
 
+  friend class GEOMAlgo_PassKeyFunctor;
 };
 #endif
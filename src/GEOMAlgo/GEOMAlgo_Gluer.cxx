@@ -29,7 +29,6 @@
 
 #include <Basics_OCCTVersion.hxx>
 
-#include <NCollection_UBTreeFiller.hxx>
 
 #include <TColStd_MapIteratorOfMapOfInteger.hxx>
 #include <TColStd_MapOfInteger.hxx>
@@ -89,9 +88,7 @@
 #include <GEOMAlgo_IndexedDataMapOfShapeBox.hxx>
 #include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
 #include <GEOMAlgo_PassKeyShape.hxx>
-#include <GEOMAlgo_BndSphereTree.hxx>
-#include <GEOMAlgo_BndSphere.hxx>
-#include <GEOMAlgo_IndexedDataMapOfShapeBndSphere.hxx>
+#include <GEOMAlgo_PointClusterer.hxx>
 
 //
 static
@@ -176,12 +173,42 @@ const TopTools_DataMapOfShapeShape& GEOMAlgo_Gluer::Origins()const
   return myOrigins;
 }
 //=======================================================================
+//function : SetTopologyIndex
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer::SetTopologyIndex
+  (const Handle(GEOMAlgo_TopologyIndex)& theIndex)
+{
+  myTopology=theIndex;
+}
+//=======================================================================
+//function : TopologyIndex
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_TopologyIndex)& GEOMAlgo_Gluer::TopologyIndex()const
+{
+  return myTopology;
+}
+//=======================================================================
+//function : PrepareTopologyIndex
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer::PrepareTopologyIndex()
+{
+  if (!myTopology.IsNull() && myTopology->Shape().IsEqual(myShape)) {
+    return;
+  }
+  // the index given may be shared, so it is not changed
+  myTopology=new GEOMAlgo_TopologyIndex;
+  myTopology->Init(myShape);
+}
+//=======================================================================
 //function : Perform
 //purpose  :
 //=======================================================================
 void GEOMAlgo_Gluer::Perform()
 {
-  const Standard_Integer aNb=8;
+  const Standard_Integer aNb=9;
   Standard_Integer i;
   //
   myErrorStatus=0;
@@ -191,10 +218,11 @@ void GEOMAlgo_Gluer::Perform()
   GEOMAlgo_ShapeAlgo::Perform();
   //
   void (GEOMAlgo_Gluer::* pF[aNb])()={
-    &GEOMAlgo_Gluer::CheckData,       &GEOMAlgo_Gluer::InnerTolerance,
-    &GEOMAlgo_Gluer::MakeVertices,    &GEOMAlgo_Gluer::MakeEdges,
-    &GEOMAlgo_Gluer::MakeFaces,       &GEOMAlgo_Gluer::MakeShells,
-    &GEOMAlgo_Gluer::MakeSolids,      &GEOMAlgo_Gluer::CheckResult
+    &GEOMAlgo_Gluer::CheckData,       &GEOMAlgo_Gluer::PrepareTopologyIndex,
+    &GEOMAlgo_Gluer::InnerTolerance,  &GEOMAlgo_Gluer::MakeVertices,
+    &GEOMAlgo_Gluer::MakeEdges,       &GEOMAlgo_Gluer::MakeFaces,
+    &GEOMAlgo_Gluer::MakeShells,      &GEOMAlgo_Gluer::MakeSolids,
+    &GEOMAlgo_Gluer::CheckResult
   };
   //
   for (i=0; i<aNb; ++i) {
@@ -213,158 +241,63 @@ void GEOMAlgo_Gluer::MakeVertices()
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, i, aNbV, aNbVSD;
-  Standard_Real aTolV;
-  gp_Pnt aPV;
+  Standard_Integer i, aNbV, aNbVSD, aNbC;
   TColStd_ListIteratorOfListOfInteger aIt;
-  TopoDS_Shape aVF;
   TopoDS_Vertex aVnew;
-  TopTools_IndexedMapOfShape aMV, aMVProcessed;
+  TopTools_IndexedMapOfShape aMVx;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
   TopTools_DataMapOfShapeListOfShape aMVV;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBndSphere aMSB;
+  NCollection_Vector<TColStd_ListOfInteger> aChains;
+  GEOMAlgo_PointClusterer aClusterer;
   //
-  GEOMAlgo_BndSphereTreeSelector aSelector;
-  GEOMAlgo_BndSphereTree aBBTree;
-  NCollection_UBTreeFiller <Standard_Integer, GEOMAlgo_BndSphere> aTreeFiller(aBBTree);
-  //
-  TopExp::MapShapes(myShape, TopAbs_VERTEX, aMV);
+  const TopTools_IndexedMapOfShape& aMV=myTopology->Shapes(TopAbs_VERTEX);
   aNbV=aMV.Extent();
   if (!aNbV) {
     myErrorStatus=2; // no vertices in source shape
     return;
   }
   //
+  aClusterer.SetGap(myTol);
+  aClusterer.SetRunParallel(myRunParallel);
   for (i=1; i<=aNbV; ++i) {
-    GEOMAlgo_BndSphere aBox;
-    //
     const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    aPV=BRep_Tool::Pnt(aV);
-    aTolV=BRep_Tool::Tolerance(aV);
-    //
-    aBox.SetGap(myTol);
-    aBox.SetCenter(aPV);
-    aBox.SetRadius(aTolV);
-    //
-    aTreeFiller.Add(i, aBox);
-    //
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
+    aClusterer.Add(BRep_Tool::Pnt(aV), BRep_Tool::Tolerance(aV));
   }
-  //
-  aTreeFiller.Fill();
+  aClusterer.Perform();
   //
   //------------------------------
-  // Chains
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    //
-    if (aMVProcessed.Contains(aV)) {
-      continue;
-    }
-    //
-    Standard_Integer aNbIP, aIP, aNbIP1, aIP1;
+  // Chains, including the single vertices
+  aClusterer.MakeChains(aChains, Standard_True);
+  aNbC=aChains.Length();
+  for (i=0; i<aNbC; ++i) {
     TopTools_ListOfShape aLVSD;
-    TColStd_MapOfInteger aMIP, aMIP1, aMIPC;
-    TColStd_MapIteratorOfMapOfInteger aIt1;
-    //
-    aMIP.Add(i);
-    for(;;) {
-      aNbIP=aMIP.Extent();
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        if (aMIPC.Contains(aIP)) {
-          continue;
-        }
-        //
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        const GEOMAlgo_BndSphere& aBoxVP=aMSB.FindFromKey(aVP);
-        //
-        aSelector.Clear();
-        aSelector.SetBox(aBoxVP);
-        //
-        aNbVSD=aBBTree.Select(aSelector);
-        if (!aNbVSD) {
-          continue;  // it must not be
- }
-        //
-        const TColStd_ListOfInteger& aLI=aSelector.Indices();
-        //
-        aIt.Initialize(aLI);
-        for (; aIt.More(); aIt.Next()) {
-          aIP1=aIt.Value();
-          if (aMIP.Contains(aIP1)) {
-            continue;
-          }
-          aMIP1.Add(aIP1);
-        } //for (; aIt.More(); aIt.Next()) {
-      }//for(; aIt1.More(); aIt1.Next()) {
-      //
-      aNbIP1=aMIP1.Extent();
-      if (!aNbIP1) {
-        break;
-      }
-      //
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIPC.Add(aIP);
-      }
-      //
-      aMIP.Clear();
-      aIt1.Initialize(aMIP1);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIP.Add(aIP);
-      }
-      aMIP1.Clear();
-    }// while(1)
     //
-    // Fill myImages
-    aNbIP=aMIPC.Extent();
-    //
-    if (!aNbIP) {// no SD vertices founded
-      aVF=aV;
-      aLVSD.Append(aV);
-      aMVProcessed.Add(aV);
-    }
-    else { // SD vertices founded [ aMIPC ]
-      aIt1.Initialize(aMIPC);
-      for(j=0; aIt1.More(); aIt1.Next(), ++j) {
-        aIP=aIt1.Key();
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        if (!j) {
-          aVF=aVP;
-        }
-        aLVSD.Append(aVP);
-        aMVProcessed.Add(aVP);
-      }
+    aIt.Initialize(aChains(i));
+    for (; aIt.More(); aIt.Next()) {
+      aLVSD.Append(aMV(aIt.Value()));
     }
-    myImages.Bind(aVF, aLVSD);
-  }// for (i=1; i<=aNbV; ++i) {
+    myImages.Bind(aLVSD.First(), aLVSD);
+  }
   //------------------------------
   //
   // Make new vertices
-  aMV.Clear();
   aItIm.Initialize(myImages);
   for (; aItIm.More(); aItIm.Next()) {
     const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aItIm.Key());
     const TopTools_ListOfShape& aLVSD=aItIm.Value();
     aNbVSD=aLVSD.Extent();
     if (aNbVSD>1) {
-      aMV.Add(aV);
+      aMVx.Add(aV);
       MakeVertex(aLVSD, aVnew);
       aMVV.Bind(aVnew, aLVSD);
     }
   }
   //
   // UnBind old vertices
-  aNbV=aMV.Extent();
+  aNbV=aMVx.Extent();
   for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
+    const TopoDS_Shape& aV=aMVx(i);
     myImages.UnBind(aV);
   }
   //
@@ -413,32 +346,9 @@ void GEOMAlgo_Gluer::MakeSubShapes (const TopoDS_Shape&  theShape,
     }
   }
   else if (theShape.ShapeType() == TopAbs_SOLID)  {
-    // build a solid
-    TopoDS_Solid aNewSolid;
-    TopExp_Explorer aExpS, aExp;
-    //
-    const TopoDS_Solid& aSolid = TopoDS::Solid(theShape);
-    //
-    TopAbs_Orientation anOr = aSolid.Orientation();
-    //
-    aBB.MakeSolid(aNewSolid);
-    aNewSolid.Orientation(anOr);
-    //
-    aExp.Init(aSolid, TopAbs_SHELL);
-    for (; aExp.More(); aExp.Next())
-    {
-      const TopoDS_Shape& aShell=aExp.Current();
-      const TopoDS_Shape& aShellR=myOrigins.Find(aShell);
-      aBB.Add(aNewSolid, aShellR);
-    }
-    //
-    TopTools_ListOfShape aLS;
-    //
-    aLS.Append(aSolid);
-    myImages.Bind(aNewSolid, aLS);
-    myOrigins.Bind(aSolid, aNewSolid);
-    //
-    aBB.Add(theResult, aNewSolid);
+    // the solid is built by MakeSolids()
+    const TopoDS_Shape& aSolidR = myOrigins.Find(theShape);
+    aBB.Add(theResult, aSolidR);
   }
   else if (theShape.ShapeType() == TopAbs_WIRE)  {
     if (myKeepNonSolids)    {
@@ -497,10 +407,41 @@ void GEOMAlgo_Gluer::MakeSolids()
 {
   myErrorStatus=0;
   //
+  Standard_Integer i, aNbS;
+  TopAbs_Orientation anOr;
   BRep_Builder aBB;
   TopoDS_Compound aCmp;
+  TopoDS_Solid aNewSolid;
+  TopoDS_Iterator aIt;
   TopTools_MapOfShape aMS;
   //
+  // Build the solids from the images of the shells
+  const TopTools_IndexedMapOfShape& aMSo=myTopology->Shapes(TopAbs_SOLID);
+  aNbS=aMSo.Extent();
+  for (i=1; i<=aNbS; ++i) {
+    const TopoDS_Shape& aSolid=aMSo(i);
+    anOr=aSolid.Orientation();
+    //
+    aBB.MakeSolid(aNewSolid);
+    aNewSolid.Orientation(anOr);
+    //
+    aIt.Initialize(aSolid);
+    for (; aIt.More(); aIt.Next()) {
+      const TopoDS_Shape& aShell=aIt.Value();
+      if (aShell.ShapeType()!=TopAbs_SHELL) {
+        continue;
+      }
+      const TopoDS_Shape& aShellR=myOrigins.Find(aShell);
+      aBB.Add(aNewSolid, aShellR);
+    }
+    //
+    TopTools_ListOfShape aLS;
+    //
+    aLS.Append(aSolid);
+    myImages.Bind(aNewSolid, aLS);
+    myOrigins.Bind(aSolid, aNewSolid);
+  }
+  //
   aBB.MakeCompound(aCmp);
   //
   // Add images of all initial sub-shapes in the result.
@@ -527,11 +468,10 @@ void GEOMAlgo_Gluer::MakeShells()
   TopAbs_Orientation anOr;
   TopoDS_Shell aNewShell;
   TopoDS_Face aFR;
-  TopTools_IndexedMapOfShape aMS;
   TopExp_Explorer aExp;
   BRep_Builder aBB;
   //
-  TopExp::MapShapes(myShape, TopAbs_SHELL, aMS);
+  const TopTools_IndexedMapOfShape& aMS=myTopology->Shapes(TopAbs_SHELL);
   //
   aNbS=aMS.Extent();
   for (i=1; i<=aNbS; ++i) {
@@ -589,24 +529,21 @@ void GEOMAlgo_Gluer::MakeShapes(const TopAbs_ShapeEnum aType)
   Standard_Boolean bHasNewSubShape;
   Standard_Integer i, aNbF, aNbSDF, iErr;
   TopoDS_Shape aNewShape;
-  TopTools_IndexedMapOfShape aMF;
   TopTools_ListIteratorOfListOfShape aItS;
   GEOMAlgo_PassKeyShape aPKF;
   GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape aMPKLF;
   //
-  TopExp::MapShapes(myShape, aType, aMF);
+  const TopTools_IndexedMapOfShape& aMF=myTopology->Shapes(aType);
   //
   aNbF=aMF.Extent();
   for (i=1; i<=aNbF; ++i) {
     const TopoDS_Shape& aS=aMF(i);
     //
     if (aType==TopAbs_FACE) {
-      const TopoDS_Face& aF=TopoDS::Face(aS);
-      FacePassKey(aF, aPKF);
+      FacePassKey(i, aPKF);
     }
     else if (aType==TopAbs_EDGE) {
-      const TopoDS_Edge& aE=TopoDS::Edge(aS);
-      EdgePassKey(aE, aPKF);
+      EdgePassKey(i, aPKF);
     }
     //
     if (myErrorStatus) {
@@ -626,7 +563,8 @@ void GEOMAlgo_Gluer::MakeShapes(const TopAbs_ShapeEnum aType)
   }
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext);
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext,
+                                            myRunParallel);
     if (iErr) {
       myErrorStatus=200;
       return;
@@ -698,33 +636,24 @@ void GEOMAlgo_Gluer::CheckResult()
   }
   //
   Standard_Boolean bFound;
-  Standard_Integer i, j, aNbS, aNbFS, aNbSx;
-  TopTools_IndexedMapOfShape aMS, aMFS;
-  TopTools_IndexedDataMapOfShapeListOfShape aMFR;
+  Standard_Integer i, j, aNbS, aNbFS, aNbSx, iF;
+  Handle(GEOMAlgo_TopologyIndex) aTopologyR;
   //
-  TopExp::MapShapesAndAncestors(myResult, TopAbs_FACE, TopAbs_SOLID, aMFR);
-  TopExp::MapShapes(myResult, TopAbs_SOLID, aMS);
+  // the index of the result: the solids and the faces of the solids
+  aTopologyR=new GEOMAlgo_TopologyIndex;
+  aTopologyR->Init(myResult);
   //
-
   myNbAlone=0;
-  aNbS=aMS.Extent();
+  aNbS=aTopologyR->Shapes(TopAbs_SOLID).Extent();
   for (i=1; i<=aNbS; ++i) {
-    const TopoDS_Shape& aSolid=aMS(i);
-    //
-    aMFS.Clear();
-    TopExp::MapShapes(aSolid, TopAbs_FACE, aMFS);
-    //
     bFound=Standard_False;
-    aNbFS=aMFS.Extent();
+    aNbFS=aTopologyR->NbIds(GEOMAlgo_TopologyIndex::T_SolidFaces, i);
     for (j=1; j<=aNbFS; ++j) {
-      const TopoDS_Shape& aFS=aMFS(j);
-      if (aMFR.Contains(aFS)) {
-        const TopTools_ListOfShape& aLSx=aMFR.FindFromKey(aFS);
-        aNbSx=aLSx.Extent();
-        if (aNbSx==2) {
-          bFound=!bFound;
-          break;
-        }
+      iF=aTopologyR->Id(GEOMAlgo_TopologyIndex::T_SolidFaces, i, j);
+      aNbSx=aTopologyR->NbIds(GEOMAlgo_TopologyIndex::T_FaceSolids, iF);
+      if (aNbSx==2) {
+        bFound=!bFound;
+        break;
       }
     }
     //
@@ -826,6 +755,61 @@ void GEOMAlgo_Gluer::EdgePassKey(const TopoDS_Edge& aE,
   aPK.SetShapes(aVR1, aVR2);
 }
 //=======================================================================
+//function : FacePassKey
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer::FacePassKey(const Standard_Integer theIndex,
+     GEOMAlgo_PassKeyShape& aPK)
+{
+  Standard_Integer k, aNbE;
+  TopTools_ListOfShape aLE;
+  //
+  const TopTools_IndexedMapOfShape& aME=myTopology->Shapes(TopAbs_EDGE);
+  //
+  aNbE=myTopology->NbIds(GEOMAlgo_TopologyIndex::T_FaceEdges, theIndex);
+  for (k=1; k<=aNbE; ++k) {
+    const TopoDS_Shape& aE=
+      aME(myTopology->Id(GEOMAlgo_TopologyIndex::T_FaceEdges, theIndex, k));
+    if (!myOrigins.IsBound(aE)) {
+      myErrorStatus=102;
+      return;
+    }
+    const TopoDS_Shape& aER=myOrigins.Find(aE);
+    aLE.Append(aER);
+  }
+  aPK.SetShapes(aLE);
+}
+//=======================================================================
+//function : EdgePassKey
+//purpose  : the key of a closed edge contains its vertex twice,
+//           as the key made by TopExp::Vertices()
+//=======================================================================
+void GEOMAlgo_Gluer::EdgePassKey(const Standard_Integer theIndex,
+     GEOMAlgo_PassKeyShape& aPK)
+{
+  Standard_Integer aNbV;
+  //
+  const TopTools_IndexedMapOfShape& aMV=myTopology->Shapes(TopAbs_VERTEX);
+  //
+  aNbV=myTopology->NbIds(GEOMAlgo_TopologyIndex::T_EdgeBounds, theIndex);
+  if (!aNbV) {
+    myErrorStatus=100;
+    return;
+  }
+  //
+  const TopoDS_Shape& aV1=
+    aMV(myTopology->Id(GEOMAlgo_TopologyIndex::T_EdgeBounds, theIndex, 1));
+  const TopoDS_Shape& aV2=
+    aMV(myTopology->Id(GEOMAlgo_TopologyIndex::T_EdgeBounds, theIndex, aNbV));
+  if (!myOrigins.IsBound(aV1) || !myOrigins.IsBound(aV2) ) {
+     myErrorStatus=100;
+     return;
+  }
+  const TopoDS_Shape& aVR1=myOrigins.Find(aV1);
+  const TopoDS_Shape& aVR2=myOrigins.Find(aV2);
+  aPK.SetShapes(aVR1, aVR2);
+}
+//=======================================================================
 //function : MakeVertex
 //purpose  :
 //=======================================================================
@@ -51,6 +51,7 @@
 
 #include <GEOMAlgo_ShapeAlgo.hxx>
 #include <GEOMAlgo_PassKeyShape.hxx>
+#include <GEOMAlgo_TopologyIndex.hxx>
 
 //=======================================================================
 //class    : GEOMAlgo_Gluer
@@ -97,10 +98,22 @@ public:
   Standard_EXPORT
     const TopTools_DataMapOfShapeShape& Origins() const;
 
+  //! Sets the topology index of the shape to share it between
+  //! the algorithms; the index is built by the algorithm if it is
+  //! not set or it is built for an other shape.
+  Standard_EXPORT
+    void SetTopologyIndex(const Handle(GEOMAlgo_TopologyIndex)& theIndex) ;
+
+  Standard_EXPORT
+    const Handle(GEOMAlgo_TopologyIndex)& TopologyIndex() const;
+
  protected:
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    void PrepareTopologyIndex() ;
+
   Standard_EXPORT
     virtual  void CheckResult() ;
 
@@ -133,6 +146,16 @@ public:
     void FacePassKey(const TopoDS_Face& aF,
                      GEOMAlgo_PassKeyShape& aPK) ;
 
+  //! The pass key of the edge #theIndex of the topology index. <br>
+  Standard_EXPORT
+    void EdgePassKey(const Standard_Integer theIndex,
+                     GEOMAlgo_PassKeyShape& aPK) ;
+
+  //! The pass key of the face #theIndex of the topology index. <br>
+  Standard_EXPORT
+    void FacePassKey(const Standard_Integer theIndex,
+                     GEOMAlgo_PassKeyShape& aPK) ;
+
   Standard_EXPORT
     void MakeVertex(const TopTools_ListOfShape& aLV,
                     TopoDS_Vertex& aNewV) ;
@@ -165,5 +188,6 @@ public:
   TopTools_DataMapOfShapeShape myOrigins;
   Standard_Integer myNbAlone;
   TopTools_ListOfShape myGenerated;
+  Handle(GEOMAlgo_TopologyIndex) myTopology;
 };
 #endif
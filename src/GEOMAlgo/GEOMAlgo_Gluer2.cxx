@@ -26,6 +26,7 @@
 #include <GEOMAlgo_Gluer2.hxx>
 
 #include <TopAbs_ShapeEnum.hxx>
+#include <TopLoc_Location.hxx>
 
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Iterator.hxx>
@@ -44,11 +45,76 @@
 #include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <TColStd_ListOfInteger.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
+
 #include <BOPTools_AlgoTools.hxx>
+#include <BOPTools_Parallel.hxx>
+#include <IntTools_Context.hxx>
 
 #include <GEOMAlgo_GlueDetector.hxx>
 #include <GEOMAlgo_AlgoTools.hxx>
 
+#include <vector>
+
+//=======================================================================
+//class    : GEOMAlgo_Gluer2BRepShapeTask
+//purpose  : Builds the new edge or face of one shape into its slot
+//=======================================================================
+class GEOMAlgo_Gluer2BRepShapeTask
+{
+ public:
+  GEOMAlgo_Gluer2BRepShapeTask()
+  :
+    myGluer(NULL),
+    myNewShape(NULL)
+  {}
+  //
+  void SetGluer(GEOMAlgo_Gluer2& theGluer)
+  {
+    myGluer=&theGluer;
+  }
+  //
+  void SetShape(const TopoDS_Shape& theShape,
+                TopoDS_Shape& theNewShape)
+  {
+    myShape=theShape;
+    myNewShape=&theNewShape;
+  }
+  //
+  void SetContext(const Handle(IntTools_Context)& theContext)
+  {
+    myContext=theContext;
+  }
+  //
+  const Handle(IntTools_Context)& Context() const
+  {
+    return myContext;
+  }
+  //
+  void Perform()
+  {
+    myGluer->MakeBRepShapes(myShape, *myNewShape, myContext);
+  }
+  //
+ protected:
+  GEOMAlgo_Gluer2* myGluer;
+  TopoDS_Shape myShape;
+  TopoDS_Shape* myNewShape;
+  Handle(IntTools_Context) myContext;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_Gluer2BRepShapeTask>
+  GEOMAlgo_VectorOfGluer2BRepShapeTask;
+
+static
+  Standard_Integer MakeFaceBatches
+    (const NCollection_Vector<TopoDS_Shape>& aVF,
+     const TopTools_DataMapOfShapeShape& aOrigins,
+     NCollection_Array1<Standard_Integer>& aBatches);
+
 //=======================================================================
 //function : GEOMAlgo_Gluer2
 //purpose  :
@@ -59,6 +125,11 @@ GEOMAlgo_Gluer2::GEOMAlgo_Gluer2()
   GEOMAlgo_BuilderShape()
 {
   myTolerance=0.0001;
+  myTileSize=0.;
+  myPartsHistoryOnly=Standard_False;
+  myCheckIncremental=Standard_False;
+  myPartBoxesTolerance=0.;
+  myLastTolerance=0.;
 }
 //=======================================================================
 //function : ~GEOMAlgo_Gluer2
@@ -84,7 +155,14 @@ void GEOMAlgo_Gluer2::Clear()
   myImagesToWork.Clear();
   myOriginsToWork.Clear();
   myKeepNonSolids=Standard_False;
+  myTileSize=0.;
+  myPartsHistoryOnly=Standard_False;
+  myCheckIncremental=Standard_False;
   myDetector.Clear();
+  // no result to continue by PerformIncremental()
+  myShape.Nullify();
+  myLastArgument.Nullify();
+  myPartBoxes.Clear();
 }
 //=======================================================================
 //function : StickedShapes
@@ -129,6 +207,63 @@ Standard_Boolean GEOMAlgo_Gluer2::KeepNonSolids()const
   return myKeepNonSolids;
 }
 //=======================================================================
+//function : SetTileSize
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::SetTileSize(const Standard_Real theSize)
+{
+  myTileSize=theSize;
+}
+//=======================================================================
+//function : TileSize
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_Gluer2::TileSize()const
+{
+  return myTileSize;
+}
+//=======================================================================
+//function : SetPartsHistoryOnly
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::SetPartsHistoryOnly(const Standard_Boolean theFlag)
+{
+  myPartsHistoryOnly=theFlag;
+}
+//=======================================================================
+//function : PartsHistoryOnly
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Gluer2::PartsHistoryOnly()const
+{
+  return myPartsHistoryOnly;
+}
+//=======================================================================
+//function : IsTiled
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Gluer2::IsTiled()const
+{
+  return myTileSize>0. && !myShapesToGlue.Extent() &&
+    !myArgument.IsNull() && myArgument.ShapeType()==TopAbs_COMPOUND;
+}
+//=======================================================================
+//function : SetCheckIncremental
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::SetCheckIncremental(const Standard_Boolean theFlag)
+{
+  myCheckIncremental=theFlag;
+}
+//=======================================================================
+//function : CheckIncremental
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Gluer2::CheckIncremental()const
+{
+  return myCheckIncremental;
+}
+//=======================================================================
 //function : ShapesDetected
 //purpose  :
 //=======================================================================
@@ -152,6 +287,7 @@ void GEOMAlgo_Gluer2::Perform()
 {
   myErrorStatus=0;
   myWarningStatus=0;
+  myLastArgument.Nullify();
   //
   CheckData();
   if (myErrorStatus) {
@@ -161,6 +297,16 @@ void GEOMAlgo_Gluer2::Perform()
   // Initialize the context
   GEOMAlgo_GluerAlgo::Perform();
   //
+  if (IsTiled()) {
+    // the partitioned gluing
+    PerformTiled();
+    SetLastResult();
+    return;
+  }
+  //
+  // the topology of the argument, shared with the detector
+  PrepareTopologyIndex();
+  //
   PerformShapesToWork();
   if (myErrorStatus) {
     return;
@@ -168,6 +314,7 @@ void GEOMAlgo_Gluer2::Perform()
   if (myWarningStatus==1) {
     // no shapes to glue
     myShape=myArgument;
+    SetLastResult();
     return;
   }
   //
@@ -222,6 +369,18 @@ void GEOMAlgo_Gluer2::Perform()
   }
   //
   BRepLib::SameParameter(myShape, myTolerance, Standard_True);
+  SetLastResult();
+}
+//=======================================================================
+//function : SetLastResult
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::SetLastResult()
+{
+  if (!myErrorStatus) {
+    myLastArgument=myArgument;
+    myLastTolerance=myTolerance;
+  }
 }
 //=======================================================================
 //function : CheckData
@@ -273,6 +432,7 @@ void GEOMAlgo_Gluer2::CheckData()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillEdges()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillEdges");
   FillBRepShapes(TopAbs_EDGE);
 }
 //=======================================================================
@@ -281,6 +441,7 @@ void GEOMAlgo_Gluer2::FillEdges()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillFaces()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillFaces");
   FillBRepShapes(TopAbs_FACE);
 }
 //=======================================================================
@@ -289,6 +450,7 @@ void GEOMAlgo_Gluer2::FillFaces()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillWires()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillWires");
   FillContainers(TopAbs_WIRE);
 }
 //=======================================================================
@@ -297,6 +459,7 @@ void GEOMAlgo_Gluer2::FillWires()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillShells()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillShells");
   FillContainers(TopAbs_SHELL);
 }
 //=======================================================================
@@ -305,6 +468,7 @@ void GEOMAlgo_Gluer2::FillShells()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillSolids()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillSolids");
   FillContainers(TopAbs_SOLID);
 }
 //=======================================================================
@@ -313,6 +477,7 @@ void GEOMAlgo_Gluer2::FillSolids()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillCompSolids()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillCompSolids");
   FillContainers(TopAbs_COMPSOLID);
 }
 //=======================================================================
@@ -321,6 +486,7 @@ void GEOMAlgo_Gluer2::FillCompSolids()
 //=======================================================================
 void GEOMAlgo_Gluer2::FillVertices()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillVertices");
   TopAbs_ShapeEnum aType;
   TopoDS_Vertex aVnew;
   TopTools_ListIteratorOfListOfShape aItLS;
@@ -357,18 +523,17 @@ void GEOMAlgo_Gluer2::FillVertices()
 void GEOMAlgo_Gluer2::FillBRepShapes(const TopAbs_ShapeEnum theType)
 {
   Standard_Boolean bHasImage, bIsToWork;
-  Standard_Integer i, aNbE;
-  TopoDS_Iterator aItS;
-  TopoDS_Shape aEnew;
-  TopTools_IndexedMapOfShape aME;
+  Standard_Integer i, j, k, aNbE, aNbS, aNbB;
   TopTools_MapOfShape aMFence;
   TopTools_ListIteratorOfListOfShape aItLS;
+  NCollection_Vector<TopoDS_Shape> aVS;
   //
   myErrorStatus=0;
   myWarningStatus=0;
   //
-  TopExp::MapShapes(myArgument, theType, aME);
+  const TopTools_IndexedMapOfShape& aME=myTopology->Shapes(theType);
   //
+  // 1. The shapes to build, in the order of the map
   aNbE=aME.Extent();
   for (i=1; i<=aNbE; ++i) {
     const TopoDS_Shape& aE=aME(i);
@@ -383,9 +548,56 @@ void GEOMAlgo_Gluer2::FillBRepShapes(const TopAbs_ShapeEnum theType)
       continue;
     }
     //
-    MakeBRepShapes(aE, aEnew);
+    aVS.Append(aE);
     //
-    //myImages / myOrigins
+    if (bIsToWork) {
+      const TopoDS_Shape& aSkey=myOriginsToWork.Find(aE);
+      const TopTools_ListOfShape& aLSD=myImagesToWork.Find(aSkey);
+      //
+      aItLS.Initialize(aLSD);
+      for (; aItLS.More(); aItLS.Next()) {
+        aMFence.Add(aItLS.Value());
+      }
+    }
+  }
+  //
+  aNbS=aVS.Length();
+  if (!aNbS) {
+    return;
+  }
+  //
+  // 2. The new shapes.
+  //    The edges are independent. A face adds the p-curves to its
+  //    new edges and refills its new wires, so the faces sharing them
+  //    are built in the different batches
+  NCollection_Array1<TopoDS_Shape> aVSnew(0, aNbS-1);
+  NCollection_Array1<Standard_Integer> aBatches(0, aNbS-1);
+  aBatches.Init(0);
+  aNbB=1;
+  if (theType==TopAbs_FACE && myRunParallel) {
+    aNbB=MakeFaceBatches(aVS, myOrigins, aBatches);
+    myProfile.AddCount("FaceBatches", aNbB);
+  }
+  //
+  for (j=0; j<aNbB; ++j) {
+    GEOMAlgo_VectorOfGluer2BRepShapeTask aVTask;
+    //
+    for (k=0; k<aNbS; ++k) {
+      if (aBatches(k)==j) {
+        GEOMAlgo_Gluer2BRepShapeTask& aTask=aVTask.Appended();
+        aTask.SetGluer(*this);
+        aTask.SetShape(aVS(k), aVSnew(k));
+      }
+    }
+    BOPTools_Parallel::Perform(myRunParallel, aVTask, myContext);
+  }
+  //
+  // 3. myImages / myOrigins, in the order of the map
+  for (k=0; k<aNbS; ++k) {
+    const TopoDS_Shape& aE=aVS(k);
+    const TopoDS_Shape& aEnew=aVSnew(k);
+    //
+    bIsToWork=myOriginsToWork.IsBound(aE);
     if (bIsToWork) {
       const TopoDS_Shape& aSkey=myOriginsToWork.Find(aE);
       const TopTools_ListOfShape& aLSD=myImagesToWork.Find(aSkey);
@@ -396,8 +608,6 @@ void GEOMAlgo_Gluer2::FillBRepShapes(const TopAbs_ShapeEnum theType)
       for (; aItLS.More(); aItLS.Next()) {
         const TopoDS_Shape& aEx=aItLS.Value();
         myOrigins.Bind(aEx, aEnew);
-        //
-        aMFence.Add(aEx);
       }
     }
     else {
@@ -407,7 +617,86 @@ void GEOMAlgo_Gluer2::FillBRepShapes(const TopAbs_ShapeEnum theType)
       myImages.Bind(aEnew, aLSD);
       myOrigins.Bind(aE, aEnew);
     }
-  }//for (i=1; i<=aNbF; ++i) {
+  }
+}
+//=======================================================================
+//function : MakeFaceBatches
+//purpose  : Splits the faces into the batches without the common
+//           edges and wires to change. The faces are taken in their
+//           order, so the batches do not depend on the threads.
+//           Returns the number of the batches.
+//=======================================================================
+Standard_Integer MakeFaceBatches
+  (const NCollection_Vector<TopoDS_Shape>& aVF,
+   const TopTools_DataMapOfShapeShape& aOrigins,
+   NCollection_Array1<Standard_Integer>& aBatches)
+{
+  Standard_Boolean bFree;
+  Standard_Integer k, aNbF, aNbLeft, iB;
+  TopLoc_Location aLoc;
+  TopoDS_Iterator aItW, aItE;
+  TColStd_ListIteratorOfListOfInteger aIt;
+  TopTools_IndexedMapOfShape aMK;
+  //
+  aNbF=aVF.Length();
+  //
+  // 1. The keys of each face: the TShapes of the new wires and
+  //    of their edges (see MakeFace)
+  NCollection_Array1<TColStd_ListOfInteger> aKeys(0, aNbF-1);
+  for (k=0; k<aNbF; ++k) {
+    TColStd_ListOfInteger& aLK=aKeys(k);
+    //
+    aItW.Initialize(aVF(k));
+    for (; aItW.More(); aItW.Next()) {
+      const TopoDS_Shape& aW=aItW.Value();
+      if (!aOrigins.IsBound(aW)) {
+        continue;
+      }
+      //
+      aLK.Append(aMK.Add(aOrigins.Find(aW).Located(aLoc)));
+      //
+      aItE.Initialize(aW);
+      for (; aItE.More(); aItE.Next()) {
+        const TopoDS_Shape& aE=aItE.Value();
+        if (aOrigins.IsBound(aE)) {
+          aLK.Append(aMK.Add(aOrigins.Find(aE).Located(aLoc)));
+        }
+        else {
+          aLK.Append(aMK.Add(aE.Located(aLoc)));
+        }
+      }
+    }
+  }
+  //
+  // 2. The batches
+  std::vector<Standard_Integer> aStamp(aMK.Extent()+1, -1);
+  aBatches.Init(-1);
+  aNbLeft=aNbF;
+  for (iB=0; aNbLeft; ++iB) {
+    for (k=0; k<aNbF; ++k) {
+      if (aBatches(k)>=0) {
+        continue;
+      }
+      //
+      const TColStd_ListOfInteger& aLK=aKeys(k);
+      bFree=Standard_True;
+      aIt.Initialize(aLK);
+      for (; aIt.More() && bFree; aIt.Next()) {
+        bFree=(aStamp[aIt.Value()]!=iB);
+      }
+      if (!bFree) {
+        continue;
+      }
+      //
+      aIt.Initialize(aLK);
+      for (; aIt.More(); aIt.Next()) {
+        aStamp[aIt.Value()]=iB;
+      }
+      aBatches(k)=iB;
+      --aNbLeft;
+    }
+  }
+  return iB;
 }
 //=======================================================================
 //function : FillContainers
@@ -420,13 +709,12 @@ void GEOMAlgo_Gluer2::FillContainers(const TopAbs_ShapeEnum aType)
   TopoDS_Shape aWnew, aEnew;
   TopoDS_Iterator aItS;
   BRep_Builder aBB;
-  TopTools_IndexedMapOfShape aMW;
   TopTools_MapOfShape aMFence;
   //
   myErrorStatus=0;
   myWarningStatus=0;
   //
-  TopExp::MapShapes(myArgument, aType, aMW);
+  const TopTools_IndexedMapOfShape& aMW=myTopology->Shapes(aType);
   //
   aNbW=aMW.Extent();
   for (i=1; i<=aNbW; ++i) {
@@ -477,6 +765,7 @@ void GEOMAlgo_Gluer2::FillContainers(const TopAbs_ShapeEnum aType)
 //=======================================================================
 void GEOMAlgo_Gluer2::FillCompounds()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "FillCompounds");
   TopAbs_ShapeEnum aType;
   TopoDS_Iterator aItC;
   //
@@ -577,6 +866,7 @@ Standard_Boolean GEOMAlgo_Gluer2::HasImage(const TopoDS_Shape& aC)
 //=======================================================================
 void GEOMAlgo_Gluer2::BuildResult()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "BuildResult");
   Standard_Boolean bHasImage;
   TopoDS_Shape aCnew, aCXnew;
   TopoDS_Iterator aItC;
@@ -640,6 +930,8 @@ void GEOMAlgo_Gluer2::BuildResult()
 // 11   - GEOMAlgo_GlueDetector failed
 // 13   - PerformImagesToWork failed
 // 14   - PerformImagesToWork failed
+// 40   - PerformIncremental: the removed part is not in the argument
+// 41   - PerformIncremental: the added part is in the argument already
 //
 // WarningStatus
 // 1   - no shapes to glue
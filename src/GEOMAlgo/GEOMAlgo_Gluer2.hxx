@@ -39,6 +39,7 @@
 #include <GEOMAlgo_BuilderShape.hxx>
 #include <GEOMAlgo_GlueDetector.hxx>
 #include <GEOMAlgo_CoupleOfShapes.hxx>
+#include <GEOMAlgo_IndexedDataMapOfShapeBox.hxx>
 #include <GEOMAlgo_ListOfCoupleOfShapes.hxx>
 
 //=======================================================================
@@ -67,6 +68,69 @@ public:
   Standard_EXPORT
     Standard_Boolean KeepNonSolids() const;
 
+  //! Sets the size of the tiles of the partitioned gluing. <br>
+  //!          If the size is positive and the shapes to glue are not
+  //!          set, the parts of the argument (the shapes of its
+  //!          compounds) are glued by the cubic tiles of the size,
+  //!          then the parts crossing the tiles are glued with the
+  //!          parts they touch. The working data of the gluing are
+  //!          of the size of the tile, not of the argument; the
+  //!          history is of the argument (see SetPartsHistoryOnly()). <br>
+  //!          Detect() is not needed in this mode and ShapesDetected()
+  //!          is not filled. <br>
+  //!          The default is 0. (the argument is glued at once). <br>
+  Standard_EXPORT
+    void SetTileSize(const Standard_Real theSize) ;
+
+  Standard_EXPORT
+    Standard_Real TileSize() const;
+
+  //! Sets the flag to keep the history of the parts only in the
+  //!          partitioned and the incremental gluing. Then Images()
+  //!          and Origins() grow with the number of the parts instead
+  //!          of the number of their sub-shapes; Modified() and
+  //!          IsDeleted() are valid for the parts only. <br>
+  //!          The default is false. <br>
+  Standard_EXPORT
+    void SetPartsHistoryOnly(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean PartsHistoryOnly() const;
+
+  //! Glues the argument of the last run changed by the removal of
+  //!          the parts theRemoved and the addition of the parts
+  //!          theAdded (the parts are the shapes of the compounds of
+  //!          the argument). <br>
+  //!          The added parts are glued with the images of the parts
+  //!          touching them, the images of the other parts are kept,
+  //!          so the history of the last run is continued. <br>
+  //!          Without the result of the last run, if the argument
+  //!          (see SetArgument()) or the tolerance is changed since
+  //!          the last result or with the shapes to glue set, the
+  //!          changed argument is glued at full. <br>
+  //!          The boxes of the kept parts are kept for the next run. <br>
+  //!          The error status is 40 if a removed part is not in the
+  //!          argument, 41 if an added part is in the argument already
+  //!          (and is not removed); the argument and the result of
+  //!          the last run are not changed then. <br>
+  Standard_EXPORT
+    void PerformIncremental(const TopTools_ListOfShape& theRemoved,
+                            const TopTools_ListOfShape& theAdded) ;
+
+  //! Sets the flag to glue the argument at full after
+  //!          PerformIncremental() and to compare the results: the
+  //!          numbers of the sub-shapes (the vertices, the edges, the
+  //!          wires, the faces, the shells and the solids) and the
+  //!          numbers of the faces of the solids and of the solids of
+  //!          the faces. If they differ, the result of the full gluing
+  //!          is taken and the warning status is 3. <br>
+  //!          The default is false. <br>
+  Standard_EXPORT
+    void SetCheckIncremental(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean CheckIncremental() const;
+
   Standard_EXPORT   virtual  void Clear() ;
 
   Standard_EXPORT
@@ -156,9 +220,14 @@ protected:
   Standard_EXPORT
     Standard_Boolean HasImage(const TopoDS_Shape& theC) ;
 
+  //! Builds the new edge or face theSnew of theS.
+  //! It changes only the new shapes of theS, so the shapes without
+  //! the common new sub-shapes can be built concurrently with
+  //! the different contexts.
   Standard_EXPORT
     void MakeBRepShapes(const TopoDS_Shape& theS,
-                        TopoDS_Shape& theSnew) ;
+                        TopoDS_Shape& theSnew,
+                        const Handle(IntTools_Context)& theContext) ;
 
   Standard_EXPORT
     void MakeEdge(const TopoDS_Edge& theE,
@@ -166,7 +235,30 @@ protected:
 
   Standard_EXPORT
     void MakeFace(const TopoDS_Face& theF,
-                  TopoDS_Face& theFnew) ;
+                  TopoDS_Face& theFnew,
+                  const Handle(IntTools_Context)& theContext) ;
+
+  Standard_EXPORT
+    void PerformTiled() ;
+
+  //! Returns true if the partitioned gluing is to be done
+  Standard_EXPORT
+    Standard_Boolean IsTiled() const;
+
+  //! Detects the shapes to glue and glues them
+  Standard_EXPORT
+    void PerformFull() ;
+
+  //! Keeps the argument and the tolerance of the result, if it
+  //! is done, to continue it by PerformIncremental()
+  Standard_EXPORT
+    void SetLastResult() ;
+
+  //! Glues the parts theLS together, the history of the gluing
+  //! is added to myImages / myOrigins.
+  Standard_EXPORT
+    void GlueParts(const TopTools_ListOfShape& theLS,
+                   const Standard_CString thePrefix) ;
 
   Standard_EXPORT
     void TreatPair(const GEOMAlgo_CoupleOfShapes& theCS,
@@ -179,7 +271,16 @@ protected:
   TopTools_DataMapOfShapeListOfShape myImagesToWork;
   TopTools_DataMapOfShapeShape myOriginsToWork;
   Standard_Boolean myKeepNonSolids;
+  Standard_Real myTileSize;
+  Standard_Boolean myPartsHistoryOnly;
+  Standard_Boolean myCheckIncremental;
   GEOMAlgo_GlueDetector myDetector;
+  GEOMAlgo_IndexedDataMapOfShapeBox myPartBoxes;
+  Standard_Real myPartBoxesTolerance;
+  TopoDS_Shape myLastArgument;
+  Standard_Real myLastTolerance;
+
+  friend class GEOMAlgo_Gluer2BRepShapeTask;
 
 private:
 };
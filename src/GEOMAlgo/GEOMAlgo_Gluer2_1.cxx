@@ -59,8 +59,10 @@
 //function : MakeBRepShapes
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Gluer2::MakeBRepShapes(const TopoDS_Shape& theS,
-                                     TopoDS_Shape& theSnew)
+void GEOMAlgo_Gluer2::MakeBRepShapes
+  (const TopoDS_Shape& theS,
+   TopoDS_Shape& theSnew,
+   const Handle(IntTools_Context)& theContext)
 {
   TopAbs_ShapeEnum aType;
   //
@@ -80,7 +82,7 @@ void GEOMAlgo_Gluer2::MakeBRepShapes(const TopoDS_Shape& theS,
     TopoDS_Face aFF, aFFnew;
     //
     aFF=*((TopoDS_Face*)&theS);
-    MakeFace(aFF, aFFnew);
+    MakeFace(aFF, aFFnew, theContext);
     if (myErrorStatus) {
       return;
     }
@@ -93,7 +95,8 @@ void GEOMAlgo_Gluer2::MakeBRepShapes(const TopoDS_Shape& theS,
 //purpose  :
 //=======================================================================
 void GEOMAlgo_Gluer2::MakeFace(const TopoDS_Face& theF,
-                               TopoDS_Face& theFnew)
+                               TopoDS_Face& theFnew,
+                               const Handle(IntTools_Context)& theContext)
 {
   Standard_Boolean bIsToReverse, bIsUPeriodic;
   Standard_Integer iRet;
@@ -108,8 +111,6 @@ void GEOMAlgo_Gluer2::MakeFace(const TopoDS_Face& theF,
   TopTools_ListOfShape aLEr;
   TopTools_ListIteratorOfListOfShape aItLE;
   //
-  myErrorStatus=0;
-  //
   aFF=theF;
   aFF.Orientation(TopAbs_FORWARD);
   //
@@ -164,13 +165,13 @@ void GEOMAlgo_Gluer2::MakeFace(const TopoDS_Face& theF,
         }
         //
         //modified by NIZNHY-PKV Fri Feb 03 11:18:17 2012f
-        iRet=GEOMAlgo_AlgoTools::BuildPCurveForEdgeOnFace(aE_forward, aEx, aFF, myContext);
+        iRet=GEOMAlgo_AlgoTools::BuildPCurveForEdgeOnFace(aE_forward, aEx, aFF, theContext);
         if (iRet) {
           continue;
         }
         //modified by NIZNHY-PKV Fri Feb 03 11:18:20 2012t
         //
-        bIsToReverse=GEOMAlgo_AlgoTools::IsSplitToReverse(aEx, aE_forward, myContext);
+        bIsToReverse=GEOMAlgo_AlgoTools::IsSplitToReverse(aEx, aE_forward, theContext);
         //bIsToReverse=BOPTools_AlgoTools::IsSplitToReverse(aEx, aE, myContext);
 
         aEx.Orientation(aE.Orientation());
@@ -195,8 +196,6 @@ void GEOMAlgo_Gluer2::MakeFace(const TopoDS_Face& theF,
 void GEOMAlgo_Gluer2::MakeEdge(const TopoDS_Edge& aE,
                                TopoDS_Edge& aNewEdge)
 {
-  myErrorStatus=0;
-  //
   Standard_Boolean bIsDE;
   Standard_Real aT1, aT2;
   TopoDS_Vertex aV1, aV2, aVR1, aVR2;
@@ -41,6 +41,7 @@
 //=======================================================================
 void GEOMAlgo_Gluer2::PrepareHistory()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PrepareHistory");
   //Standard_Boolean bHasImage, bContainsSD;
   //
   // 1. Clearing
@@ -76,17 +76,26 @@ void GEOMAlgo_Gluer2::Detect()
   myImagesDetected.Clear();
   myOriginsDetected.Clear();
   //
+  // the profile of the gluing starts with the detection
+  myProfile.Clear();
+  GEOMAlgo_ProfileStage aPS(myProfile, "Detect");
+  //
   bCheckGeometry=Standard_True;
   //
   //modified by NIZNHY-PKV Tue Mar 13 13:33:35 2012f
   myDetector.Clear();
   myDetector.SetContext(myContext);
   //modified by NIZNHY-PKV Tue Mar 13 13:33:38 2012t
+  PrepareTopologyIndex();
+  myDetector.SetTopologyIndex(myTopology);
   myDetector.SetArgument(myArgument);
   myDetector.SetTolerance(myTolerance);
   myDetector.SetCheckGeometry(bCheckGeometry);
+  myDetector.SetUseOBB(myUseOBB);
+  myDetector.SetProfiling(myProfile.IsEnabled());
   //
   myDetector.Perform();
+  myProfile.Add(myDetector.Profile(), "Detect.");
   iErr=myDetector.ErrorStatus();
   if (iErr) {
     // Detector is failed
@@ -126,6 +135,7 @@ void GEOMAlgo_Gluer2::Detect()
 //=======================================================================
 void GEOMAlgo_Gluer2::PerformShapesToWork()
 {
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformShapesToWork");
   Standard_Integer aNbSG, i, j, k, aNbC, aNb, aNbSD;
   TopTools_ListIteratorOfListOfShape aItLS1, aItLS2;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItDMSLS;
@@ -0,0 +1,1016 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_Gluer2_4.cxx
+
+#include <GEOMAlgo_Gluer2.hxx>
+
+#include <gp_Pnt.hxx>
+
+#include <Bnd_Box.hxx>
+
+#include <TColStd_ListOfInteger.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+
+#include <TopAbs_ShapeEnum.hxx>
+
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopoDS_Iterator.hxx>
+
+#include <BRep_Tool.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepLib.hxx>
+
+#include <TopExp.hxx>
+
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_MapOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
+
+#include <GEOMAlgo_AlgoTools.hxx>
+#include <GEOMAlgo_BoxBndTree.hxx>
+#include <GEOMAlgo_TopologyIndex.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//=======================================================================
+//struct   : GEOMAlgo_TileCell
+//purpose  : The tile of the grid and the part in it
+//=======================================================================
+struct GEOMAlgo_TileCell
+{
+  Standard_Integer X, Y, Z;
+  Standard_Integer Index;
+  //
+  Standard_Boolean IsSameTile(const GEOMAlgo_TileCell& theOther) const
+  {
+    return X==theOther.X && Y==theOther.Y && Z==theOther.Z;
+  }
+  //
+  bool operator<(const GEOMAlgo_TileCell& theOther) const
+  {
+    if (X!=theOther.X) {
+      return X<theOther.X;
+    }
+    if (Y!=theOther.Y) {
+      return Y<theOther.Y;
+    }
+    if (Z!=theOther.Z) {
+      return Z<theOther.Z;
+    }
+    return Index<theOther.Index;
+  }
+};
+
+static
+  void MapParts(const TopoDS_Shape& theS,
+                TopTools_IndexedMapOfShape& theMP);
+
+static
+  void RemoveParts(const TopoDS_Shape& theS,
+                   const TopTools_IndexedMapOfShape& theMR,
+                   TopoDS_Shape& theSnew);
+
+static
+  Standard_Boolean HasSameNumbers(const TopoDS_Shape& theS1,
+                                  const TopoDS_Shape& theS2);
+
+static
+  void PartBox(const TopoDS_Shape& theS,
+               const Standard_Real theGap,
+               Bnd_Box& theBox);
+
+static
+  void TileCell(const Standard_Real theX,
+                const Standard_Real theY,
+                const Standard_Real theZ,
+                const Standard_Real theMin[3],
+                const Standard_Real theH,
+                GEOMAlgo_TileCell& theC);
+
+static
+  Standard_Boolean IsInTile(const Bnd_Box& theBox,
+                            const Standard_Real theMin[3],
+                            const Standard_Real theH,
+                            GEOMAlgo_TileCell& theC);
+
+static
+  Standard_Boolean IsInBox(const Bnd_Box& theBox,
+                           const Bnd_Box& theBoxOuter);
+
+//=======================================================================
+//function : PerformTiled
+//purpose  : The parts of the argument are glued in two steps:
+//           1. the parts inside a tile (their boxes enlarged by the
+//              tolerance are in the tile) are glued tile by tile;
+//              the parts of the different tiles can not be glued;
+//           2. the parts crossing the tiles (and the glued parts which
+//              image crosses the tile) are glued by the tiles of the
+//              shifted grids with the parts touching their boxes; the
+//              other shapes of the tiles are not changed, so they are
+//              shared as before.
+//=======================================================================
+void GEOMAlgo_Gluer2::PerformTiled()
+{
+  myProfile.Clear();
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformTiled");
+  Standard_Boolean bIsGlued;
+  Standard_Integer i, j, k, aNbP, aNbT, aNbS, aNbR, iWarn;
+  Standard_Real aMin[3], aMax[3], aX[6], aH;
+  TopoDS_Shape aSx;
+  TopTools_IndexedMapOfShape aMP;
+  TopTools_ListOfShape aLS;
+  GEOMAlgo_TileCell aC;
+  //
+  myErrorStatus=0;
+  myWarningStatus=0;
+  iWarn=0;
+  //
+  myImages.Clear();
+  myOrigins.Clear();
+  myImagesDetected.Clear();
+  myOriginsDetected.Clear();
+  myImagesToWork.Clear();
+  myOriginsToWork.Clear();
+  //
+  // 1. The parts and their boxes
+  MapParts(myArgument, aMP);
+  aNbP=aMP.Extent();
+  //
+  std::vector<Bnd_Box> aBoxes(aNbP);
+  for (k=0; k<3; ++k) {
+    aMin[k]=RealLast();
+    aMax[k]=RealFirst();
+  }
+  for (i=1; i<=aNbP; ++i) {
+    Bnd_Box& aBox=aBoxes[i-1];
+    PartBox(aMP(i), myTolerance, aBox);
+    if (aBox.IsVoid()) {
+      continue;
+    }
+    aBox.Get(aX[0], aX[1], aX[2], aX[3], aX[4], aX[5]);
+    for (k=0; k<3; ++k) {
+      aMin[k]=std::min(aMin[k], aX[k]);
+      aMax[k]=std::max(aMax[k], aX[k+3]);
+    }
+  }
+  //
+  aH=myTileSize;
+  for (k=0; k<3; ++k) {
+    // not more than 1.e9 tiles along an axis
+    if (aMax[k]>aMin[k]) {
+      aH=std::max(aH, 1.e-9*(aMax[k]-aMin[k]));
+    }
+  }
+  //
+  // 2. The parts inside the tiles, sorted by the tiles;
+  //    the parts crossing the tiles
+  std::vector<GEOMAlgo_TileCell> aCells;
+  std::vector<Standard_Boolean> aIsSeed(aNbP, Standard_False);
+  //
+  aNbR=0;
+  for (i=1; i<=aNbP; ++i) {
+    const Bnd_Box& aBox=aBoxes[i-1];
+    if (aBox.IsVoid()) {
+      // no vertices, nothing to glue
+      continue;
+    }
+    if (IsInTile(aBox, aMin, aH, aC)) {
+      aC.Index=i;
+      aCells.push_back(aC);
+    }
+    else {
+      aIsSeed[i-1]=Standard_True;
+      ++aNbR;
+    }
+  }
+  std::sort(aCells.begin(), aCells.end());
+  //
+  myProfile.AddCount("TileParts", aCells.size());
+  //
+  // 3. The gluing of the tiles
+  aNbT=0;
+  aNbS=(Standard_Integer)aCells.size();
+  {
+    GEOMAlgo_ProfileStage aPST(myProfile, "Tiles");
+    for (i=0; i<aNbS; i=j) {
+      aLS.Clear();
+      for (j=i; j<aNbS && aCells[j].IsSameTile(aCells[i]); ++j) {
+        aLS.Append(aMP(aCells[j].Index));
+      }
+      ++aNbT;
+      //
+      GlueParts(aLS, "Tile.");
+      if (myErrorStatus) {
+        return;
+      }
+      if (myWarningStatus) {
+        iWarn=myWarningStatus;
+      }
+      //
+      // the glued parts going out of the tile are glued again
+      for (k=i; k<j; ++k) {
+        const TopoDS_Shape& aS=aMP(aCells[k].Index);
+        if (!myOrigins.IsBound(aS)) {
+          continue;
+        }
+        //
+        Bnd_Box& aBox=aBoxes[aCells[k].Index-1];
+        aBox.SetVoid();
+        PartBox(myOrigins.Find(aS), myTolerance, aBox);
+        if (!IsInTile(aBox, aMin, aH, aC) || !aC.IsSameTile(aCells[i])) {
+          aIsSeed[aCells[k].Index-1]=Standard_True;
+          ++aNbR;
+        }
+      }
+    }
+  }
+  myProfile.AddCount("Tiles", aNbT);
+  //
+  // 4. The parts crossing the tiles are glued by the groups: the
+  //    tiles of the grid shifted by the half of the tile; the parts
+  //    that do not fit are placed in the next grid, its tiles are
+  //    twice larger. The parts of two tiles of a grid can not touch,
+  //    so each group is glued with the parts touching it only and
+  //    the groups do not grow with the model.
+  //    The parts touching a group are found by the tree of the boxes
+  //    of the parts. The boxes of the re-glued parts are refreshed;
+  //    the ones going out of their boxes in the tree are tested
+  //    apart, the tree is rebuilt if there are too many of them.
+  if (aNbR) {
+    GEOMAlgo_ProfileStage aPSR(myProfile, "Reconcile");
+    Standard_Boolean bLast;
+    Standard_Integer aNbG, aNbGMax, aNbRP, aNbTrees, aNbSG, iP, n;
+    Standard_Real aMinS[3], aHR, aExt;
+    std::vector<Standard_Integer> aRest, aNext, aGroup, aGrown, aCand;
+    std::vector<Standard_Integer> aStamp(aNbP, -1);
+    std::vector<Standard_Boolean> aIsGrown(aNbP, Standard_False);
+    std::vector<Bnd_Box> aTreeBoxes;
+    std::vector<GEOMAlgo_TileCell> aCellsR;
+    TColStd_ListIteratorOfListOfInteger aItLI;
+    GEOMAlgo_BoxBndTree aBBTree;
+    //
+    aNbTrees=0;
+    aExt=0.;
+    for (k=0; k<3; ++k) {
+      aExt=std::max(aExt, aMax[k]-aMin[k]);
+    }
+    //
+    for (i=1; i<=aNbP; ++i) {
+      if (aIsSeed[i-1]) {
+        aRest.push_back(i);
+      }
+    }
+    //
+    aNbG=0;
+    aNbGMax=0;
+    aNbRP=0;
+    aHR=aH;
+    while (!aRest.empty()) {
+      // the grid of the last step has one tile
+      bLast=(aHR>2.*aExt);
+      for (k=0; k<3; ++k) {
+        aMinS[k]=aMin[k]-0.5*aHR;
+      }
+      //
+      aCellsR.clear();
+      aNext.clear();
+      for (i=0; i<(Standard_Integer)aRest.size(); ++i) {
+        iP=aRest[i];
+        if (bLast) {
+          aC.X=0;
+          aC.Y=0;
+          aC.Z=0;
+        }
+        else if (!IsInTile(aBoxes[iP-1], aMinS, aHR, aC)) {
+          aNext.push_back(iP);
+          continue;
+        }
+        aC.Index=iP;
+        aCellsR.push_back(aC);
+      }
+      std::sort(aCellsR.begin(), aCellsR.end());
+      //
+      aNbS=(Standard_Integer)aCellsR.size();
+      for (i=0; i<aNbS; i=j) {
+        // the tree of the current boxes of the parts
+        if (!aNbTrees || (Standard_Integer)aGrown.size()>64+aNbP/16) {
+          aBBTree.Clear();
+          for (k=1; k<=aNbP; ++k) {
+            aBBTree.Add(k, aBoxes[k-1]);
+            aIsGrown[k-1]=Standard_False;
+          }
+          aBBTree.Build();
+          aTreeBoxes=aBoxes;
+          aGrown.clear();
+          ++aNbTrees;
+        }
+        //
+        aGroup.clear();
+        for (j=i; j<aNbS && aCellsR[j].IsSameTile(aCellsR[i]); ++j) {
+          iP=aCellsR[j].Index;
+          aStamp[iP-1]=aNbG;
+          aIsSeed[iP-1]=Standard_False;
+          aGroup.push_back(iP);
+        }
+        //
+        // the parts touching the group, except the parts to place
+        aNbSG=j-i;
+        NCollection_Array1<Bnd_Box> aBoxesG(1, aNbSG);
+        NCollection_Array1<TColStd_ListOfInteger> aLIds(1, aNbSG);
+        for (k=1; k<=aNbSG; ++k) {
+          aBoxesG(k)=aBoxes[aCellsR[i+k-1].Index-1];
+        }
+        aBBTree.Select(aBoxesG, aLIds, myRunParallel);
+        //
+        for (k=1; k<=aNbSG; ++k) {
+          const Bnd_Box& aBoxG=aBoxesG(k);
+          //
+          // the candidates of the tree and the grown parts
+          aCand.assign(aGrown.begin(), aGrown.end());
+          aItLI.Initialize(aLIds(k));
+          for (; aItLI.More(); aItLI.Next()) {
+            aCand.push_back(aItLI.Value());
+          }
+          for (n=0; n<(Standard_Integer)aCand.size(); ++n) {
+            iP=aCand[n];
+            if (aStamp[iP-1]==aNbG || aIsSeed[iP-1]) {
+              continue;
+            }
+            // the box in the tree may be the one before the gluing
+            if (aBoxes[iP-1].IsOut(aBoxG)) {
+              continue;
+            }
+            aStamp[iP-1]=aNbG;
+            aGroup.push_back(iP);
+          }
+        }
+        std::sort(aGroup.begin(), aGroup.end());
+        ++aNbG;
+        //
+        aLS.Clear();
+        for (k=0; k<(Standard_Integer)aGroup.size(); ++k) {
+          const TopoDS_Shape& aS=aMP(aGroup[k]);
+          if (myOrigins.IsBound(aS)) {
+            aSx=myOrigins.Find(aS);
+            aSx.Orientation(aS.Orientation());
+            aLS.Append(aSx);
+          }
+          else {
+            aLS.Append(aS);
+          }
+        }
+        aNbRP+=(Standard_Integer)aGroup.size();
+        aNbGMax=std::max(aNbGMax, (Standard_Integer)aGroup.size());
+        //
+        GlueParts(aLS, "Reconcile.");
+        if (myErrorStatus) {
+          return;
+        }
+        if (myWarningStatus) {
+          iWarn=myWarningStatus;
+        }
+        //
+        // the boxes of the re-glued parts
+        for (k=0; k<(Standard_Integer)aGroup.size(); ++k) {
+          iP=aGroup[k];
+          const TopoDS_Shape& aS=aMP(iP);
+          if (!myOrigins.IsBound(aS)) {
+            continue;
+          }
+          //
+          Bnd_Box& aBox=aBoxes[iP-1];
+          aBox.SetVoid();
+          PartBox(myOrigins.Find(aS), myTolerance, aBox);
+          if (!aIsGrown[iP-1] && !IsInBox(aBox, aTreeBoxes[iP-1])) {
+            aIsGrown[iP-1]=Standard_True;
+            aGrown.push_back(iP);
+          }
+        }
+      }
+      //
+      aRest.swap(aNext);
+      aHR*=2.;
+    }
+    myProfile.AddCount("ReconcileGroups", aNbG);
+    myProfile.AddCount("ReconciledParts", aNbRP);
+    myProfile.AddCount("ReconcileMaxParts", aNbGMax);
+    myProfile.AddCount("ReconcileTrees", aNbTrees);
+  }
+  //
+  // 5. The result
+  bIsGlued=(myOrigins.Extent()!=0);
+  //
+  FillCompounds();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  BuildResult();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  PrepareHistory();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  if (!bIsGlued) {
+    // no shapes to glue
+    myWarningStatus=1;
+    return;
+  }
+  myWarningStatus=iWarn;
+  //
+  BRepLib::SameParameter(myShape, myTolerance, Standard_True);
+}
+//=======================================================================
+//function : PerformIncremental
+//purpose  : The added parts are glued with the images of the parts
+//           touching their boxes. The shapes changed by the gluing
+//           are in the boxes, so all their containers are glued
+//           together and the other shapes are shared as before.
+//           The images of the removed parts are not in the result,
+//           the shapes they shared with the other parts are kept.
+//=======================================================================
+void GEOMAlgo_Gluer2::PerformIncremental(const TopTools_ListOfShape& theRemoved,
+                                         const TopTools_ListOfShape& theAdded)
+{
+  Standard_Boolean bHasResult;
+  Standard_Integer i, aNbP, aNbR, aNbA, iWarn, iB, aIB, aNbCached;
+  TopoDS_Shape aCnew, aSx, aSxnew;
+  TopoDS_Iterator aIt;
+  BRep_Builder aBB;
+  TopTools_IndexedMapOfShape aMP, aMR, aMA;
+  TopTools_ListOfShape aLS, aLP;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  //
+  // the result of the last run is of the current argument
+  bHasResult=(!myShape.IsNull() && !myLastArgument.IsNull() &&
+              myArgument.IsSame(myLastArgument) &&
+              myTolerance==myLastTolerance &&
+              !myShapesToGlue.Extent());
+  //
+  myErrorStatus=0;
+  myWarningStatus=0;
+  iWarn=0;
+  //
+  // 1. The changed argument
+  if (!myArgument.IsNull()) {
+    MapParts(myArgument, aMP);
+  }
+  //
+  aItLS.Initialize(theRemoved);
+  for (; aItLS.More(); aItLS.Next()) {
+    MapParts(aItLS.Value(), aMR);
+  }
+  aNbR=aMR.Extent();
+  for (i=1; i<=aNbR; ++i) {
+    if (!aMP.Contains(aMR(i))) {
+      myErrorStatus=40;// the removed part is not in the argument
+      return;
+    }
+  }
+  //
+  GEOMAlgo_AlgoTools::MakeContainer(TopAbs_COMPOUND, aCnew);
+  if (!myArgument.IsNull()) {
+    if (myArgument.ShapeType()==TopAbs_COMPOUND) {
+      aIt.Initialize(myArgument);
+      for (; aIt.More(); aIt.Next()) {
+        RemoveParts(aIt.Value(), aMR, aSxnew);
+        if (!aSxnew.IsNull()) {
+          aBB.Add(aCnew, aSxnew);
+        }
+      }
+    }
+    else if (!aMR.Contains(myArgument)) {
+      aBB.Add(aCnew, myArgument);
+    }
+  }
+  //
+  aItLS.Initialize(theAdded);
+  for (; aItLS.More(); aItLS.Next()) {
+    MapParts(aItLS.Value(), aMA);
+  }
+  aNbA=aMA.Extent();
+  for (i=1; i<=aNbA; ++i) {
+    if (aMP.Contains(aMA(i)) && !aMR.Contains(aMA(i))) {
+      myErrorStatus=41;// the added part is in the argument already
+      return;
+    }
+  }
+  //
+  aItLS.Initialize(theAdded);
+  for (; aItLS.More(); aItLS.Next()) {
+    aBB.Add(aCnew, aItLS.Value());
+  }
+  myArgument=aCnew;
+  myLastArgument.Nullify();
+  //
+  if (!bHasResult) {
+    // no result to continue
+    PerformFull();
+    return;
+  }
+  //
+  myProfile.Clear();
+  GEOMAlgo_ProfileStage aPS(myProfile, "PerformIncremental");
+  myProfile.AddCount("RemovedParts", aNbR);
+  //
+  myImagesDetected.Clear();
+  myOriginsDetected.Clear();
+  myImagesToWork.Clear();
+  myOriginsToWork.Clear();
+  //
+  // 2. The added parts and the parts touching them.
+  //    The boxes of the images of the kept parts are taken from
+  //    the last run if they are there
+  GEOMAlgo_IndexedDataMapOfShapeBox aMSB;
+  //
+  aNbCached=0;
+  if (myPartBoxesTolerance!=myTolerance) {
+    myPartBoxes.Clear();
+    myPartBoxesTolerance=myTolerance;
+  }
+  //
+  if (aNbA) {
+    Standard_Integer aNbK;
+    std::vector<Standard_Integer> aIP;
+    GEOMAlgo_BoxBndTree aBBTree;
+    //
+    for (i=1; i<=aNbA; ++i) {
+      Bnd_Box aBox;
+      //
+      PartBox(aMA(i), myTolerance, aBox);
+      aBBTree.Add(i, aBox);
+    }
+    aBBTree.Build();
+    //
+    // the boxes of the images of the kept parts
+    aNbP=aMP.Extent();
+    aIP.reserve(aNbP);
+    for (i=1; i<=aNbP; ++i) {
+      const TopoDS_Shape& aS=aMP(i);
+      if (aMR.Contains(aS) || aMA.Contains(aS)) {
+        continue;
+      }
+      //
+      aSx=aS;
+      if (myOrigins.IsBound(aS)) {
+        aSx=myOrigins.Find(aS);
+        aSx.Orientation(aS.Orientation());
+      }
+      //
+      iB=myPartBoxes.FindIndex(aSx);
+      if (iB) {
+        aIB=aMSB.Add(aSx, myPartBoxes(iB));
+        ++aNbCached;
+      }
+      else {
+        Bnd_Box aBox;
+        //
+        PartBox(aSx, myTolerance, aBox);
+        aIB=aMSB.Add(aSx, aBox);
+      }
+      if (aIB>(Standard_Integer)aIP.size()) {
+        aIP.push_back(i);
+      }
+    }
+    //
+    // the kept parts touching the added ones
+    aNbK=aMSB.Extent();
+    if (aNbK) {
+      NCollection_Array1<Bnd_Box> aBoxesK(1, aNbK);
+      NCollection_Array1<TColStd_ListOfInteger> aLIds(1, aNbK);
+      //
+      for (i=1; i<=aNbK; ++i) {
+        aBoxesK(i)=aMSB(i);
+      }
+      aBBTree.Select(aBoxesK, aLIds, myRunParallel);
+      //
+      for (i=1; i<=aNbK; ++i) {
+        if (!aLIds(i).IsEmpty()) {
+          aLS.Append(aMSB.FindKey(i));
+          aLP.Append(aMP(aIP[i-1]));
+        }
+      }
+    }
+    // the boxes of the images of the kept parts for the next run
+    myProfile.AddCount("CachedPartBoxes", aNbCached);
+    myPartBoxes.Exchange(aMSB);
+    //
+    myProfile.AddCount("TouchedParts", aLS.Extent());
+    myProfile.AddCount("AddedParts", aNbA);
+    //
+    for (i=1; i<=aNbA; ++i) {
+      aLS.Append(aMA(i));
+      aLP.Append(aMA(i));
+    }
+    //
+    GlueParts(aLS, "Incremental.");
+    if (myErrorStatus) {
+      return;
+    }
+    iWarn=myWarningStatus;
+  }
+  //
+  // 3. The result
+  FillCompounds();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  BuildResult();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  PrepareHistory();
+  if (myErrorStatus) {
+    return;
+  }
+  myWarningStatus=iWarn;
+  //
+  if (!aLP.IsEmpty()) {
+    TopoDS_Shape aCglued;
+    //
+    GEOMAlgo_AlgoTools::MakeContainer(TopAbs_COMPOUND, aCglued);
+    aItLS.Initialize(aLP);
+    for (; aItLS.More(); aItLS.Next()) {
+      const TopoDS_Shape& aS=aItLS.Value();
+      if (myOrigins.IsBound(aS)) {
+        aBB.Add(aCglued, myOrigins.Find(aS));
+      }
+    }
+    BRepLib::SameParameter(aCglued, myTolerance, Standard_True);
+  }
+  //
+  // 4. The validation by the full gluing
+  if (myCheckIncremental) {
+    GEOMAlgo_ProfileStage aPSC(myProfile, "CheckIncremental");
+    GEOMAlgo_Gluer2 aGluer;
+    //
+    aGluer.SetArgument(myArgument);
+    aGluer.SetTolerance(myTolerance);
+    aGluer.SetCheckGeometry(myCheckGeometry);
+    aGluer.SetUseOBB(myUseOBB);
+    aGluer.SetKeepNonSolids(myKeepNonSolids);
+    aGluer.SetRunParallel(myRunParallel);
+    aGluer.SetTileSize(myTileSize);
+    //
+    aGluer.PerformFull();
+    if (aGluer.ErrorStatus()) {
+      myErrorStatus=aGluer.ErrorStatus();
+      return;
+    }
+    //
+    if (!HasSameNumbers(myShape, aGluer.Shape())) {
+      myShape=aGluer.Shape();
+      myImages=aGluer.Images();
+      myOrigins=aGluer.Origins();
+      PrepareHistory();
+      myWarningStatus=3;
+    }
+  }
+  SetLastResult();
+}
+//=======================================================================
+//function : PerformFull
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::PerformFull()
+{
+  if (!IsTiled()) {
+    Detect();
+    if (myErrorStatus) {
+      return;
+    }
+  }
+  Perform();
+}
+//=======================================================================
+//function : GlueParts
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Gluer2::GlueParts(const TopTools_ListOfShape& theLS,
+                                const Standard_CString thePrefix)
+{
+  Standard_Integer iErr;
+  TopoDS_Shape aC;
+  BRep_Builder aBB;
+  TopTools_MapOfShape aMParts;
+  TopTools_ListIteratorOfListOfShape aItLS, aItLSx;
+  TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItDMSLS;
+  //
+  GEOMAlgo_AlgoTools::MakeContainer(TopAbs_COMPOUND, aC);
+  aItLS.Initialize(theLS);
+  for (; aItLS.More(); aItLS.Next()) {
+    aBB.Add(aC, aItLS.Value());
+    if (myPartsHistoryOnly) {
+      aMParts.Add(aItLS.Value());
+    }
+  }
+  //
+  // the gluer of the parts; its data are released at the exit
+  GEOMAlgo_Gluer2 aGluer;
+  //
+  aGluer.SetArgument(aC);
+  aGluer.SetTolerance(myTolerance);
+  aGluer.SetCheckGeometry(myCheckGeometry);
+  aGluer.SetUseOBB(myUseOBB);
+  aGluer.SetKeepNonSolids(Standard_True);
+  aGluer.SetRunParallel(myRunParallel);
+  aGluer.SetProfiling(myProfile.IsEnabled());
+  //
+  aGluer.Detect();
+  iErr=aGluer.ErrorStatus();
+  if (iErr) {
+    myErrorStatus=iErr;
+    return;
+  }
+  if (aGluer.WarningStatus()==2) {
+    // Sticked shapes are detected
+    myWarningStatus=2;
+  }
+  //
+  aGluer.Perform();
+  myProfile.Add(aGluer.Profile(), thePrefix);
+  iErr=aGluer.ErrorStatus();
+  if (iErr) {
+    myErrorStatus=iErr;
+    return;
+  }
+  //
+  // myImages / myOrigins: the images of the shapes glued before
+  // are replaced by the new ones
+  const TopTools_DataMapOfShapeListOfShape& aImages=aGluer.Images();
+  aItDMSLS.Initialize(aImages);
+  for (; aItDMSLS.More(); aItDMSLS.Next()) {
+    const TopoDS_Shape& aSnew=aItDMSLS.Key();
+    const TopTools_ListOfShape& aLSD=aItDMSLS.Value();
+    if (aLSD.First().IsSame(aC)) {
+      continue;
+    }
+    if (myPartsHistoryOnly && !aMParts.Contains(aLSD.First())) {
+      // the sub-shape of a part
+      continue;
+    }
+    //
+    TopTools_ListOfShape aLSnew;
+    //
+    aItLS.Initialize(aLSD);
+    for (; aItLS.More(); aItLS.Next()) {
+      const TopoDS_Shape& aS=aItLS.Value();
+      if (myImages.IsBound(aS)) {
+        TopTools_ListOfShape aLSx=myImages.Find(aS);
+        myImages.UnBind(aS);
+        //
+        aItLSx.Initialize(aLSx);
+        for (; aItLSx.More(); aItLSx.Next()) {
+          const TopoDS_Shape& aSx=aItLSx.Value();
+          myOrigins.Bind(aSx, aSnew);
+          aLSnew.Append(aSx);
+        }
+      }
+      else {
+        myOrigins.Bind(aS, aSnew);
+        aLSnew.Append(aS);
+      }
+    }
+    myImages.Bind(aSnew, aLSnew);
+  }
+}
+//=======================================================================
+//function : MapParts
+//purpose  : The shapes of the compounds of theS (or theS itself)
+//=======================================================================
+void MapParts(const TopoDS_Shape& theS,
+              TopTools_IndexedMapOfShape& theMP)
+{
+  TopoDS_Iterator aIt;
+  //
+  if (theS.ShapeType()!=TopAbs_COMPOUND) {
+    theMP.Add(theS);
+    return;
+  }
+  //
+  aIt.Initialize(theS);
+  for (; aIt.More(); aIt.Next()) {
+    MapParts(aIt.Value(), theMP);
+  }
+}
+//=======================================================================
+//function : RemoveParts
+//purpose  : theS without the parts theMR; the compounds without the
+//           removed parts are the same, theSnew is null if theS is
+//           removed
+//=======================================================================
+void RemoveParts(const TopoDS_Shape& theS,
+                 const TopTools_IndexedMapOfShape& theMR,
+                 TopoDS_Shape& theSnew)
+{
+  Standard_Boolean bChanged;
+  TopoDS_Shape aSxnew;
+  TopoDS_Iterator aIt;
+  BRep_Builder aBB;
+  TopTools_ListOfShape aLS;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  //
+  theSnew.Nullify();
+  if (theS.ShapeType()!=TopAbs_COMPOUND) {
+    if (!theMR.Contains(theS)) {
+      theSnew=theS;
+    }
+    return;
+  }
+  //
+  bChanged=Standard_False;
+  aIt.Initialize(theS);
+  for (; aIt.More(); aIt.Next()) {
+    const TopoDS_Shape& aSx=aIt.Value();
+    RemoveParts(aSx, theMR, aSxnew);
+    if (aSxnew.IsNull()) {
+      bChanged=Standard_True;
+      continue;
+    }
+    if (!aSxnew.IsSame(aSx)) {
+      bChanged=Standard_True;
+    }
+    aLS.Append(aSxnew);
+  }
+  //
+  if (!bChanged) {
+    theSnew=theS;
+    return;
+  }
+  //
+  GEOMAlgo_AlgoTools::MakeContainer(TopAbs_COMPOUND, theSnew);
+  aItLS.Initialize(aLS);
+  for (; aItLS.More(); aItLS.Next()) {
+    aBB.Add(theSnew, aItLS.Value());
+  }
+}
+//=======================================================================
+//function : HasSameNumbers
+//purpose  : Returns true if theS1 and theS2 have the same numbers of
+//           the vertices, the edges, the wires, the faces, the shells
+//           and the solids and the same incidence of the solids and
+//           the faces: the sorted numbers of the faces of the solids
+//           and of the solids of the faces (e.g. the shared faces)
+//=======================================================================
+Standard_Boolean HasSameNumbers(const TopoDS_Shape& theS1,
+                                const TopoDS_Shape& theS2)
+{
+  Standard_Integer i, j, aNb;
+  TopAbs_ShapeEnum aTypes[6]={
+    TopAbs_VERTEX, TopAbs_EDGE, TopAbs_WIRE,
+    TopAbs_FACE, TopAbs_SHELL, TopAbs_SOLID
+  };
+  GEOMAlgo_TopologyIndex::Table aTables[2]={
+    GEOMAlgo_TopologyIndex::T_SolidFaces,
+    GEOMAlgo_TopologyIndex::T_FaceSolids
+  };
+  TopAbs_ShapeEnum aTableTypes[2]={
+    TopAbs_SOLID, TopAbs_FACE
+  };
+  Handle(GEOMAlgo_TopologyIndex) aTopology1, aTopology2;
+  //
+  aTopology1=new GEOMAlgo_TopologyIndex;
+  aTopology2=new GEOMAlgo_TopologyIndex;
+  aTopology1->Init(theS1);
+  aTopology2->Init(theS2);
+  //
+  for (i=0; i<6; ++i) {
+    if (aTopology1->Shapes(aTypes[i]).Extent()!=
+        aTopology2->Shapes(aTypes[i]).Extent()) {
+      return Standard_False;
+    }
+  }
+  //
+  for (i=0; i<2; ++i) {
+    std::vector<Standard_Integer> aN1, aN2;
+    //
+    aNb=aTopology1->Shapes(aTableTypes[i]).Extent();
+    aN1.reserve(aNb);
+    aN2.reserve(aNb);
+    for (j=1; j<=aNb; ++j) {
+      aN1.push_back(aTopology1->NbIds(aTables[i], j));
+      aN2.push_back(aTopology2->NbIds(aTables[i], j));
+    }
+    std::sort(aN1.begin(), aN1.end());
+    std::sort(aN2.begin(), aN2.end());
+    if (aN1!=aN2) {
+      return Standard_False;
+    }
+  }
+  return Standard_True;
+}
+//=======================================================================
+//function : PartBox
+//purpose  : The box of the vertices of theS enlarged by their
+//           tolerances and theGap, as the vertices are compared
+//           by GEOMAlgo_GlueDetector
+//=======================================================================
+void PartBox(const TopoDS_Shape& theS,
+             const Standard_Real theGap,
+             Bnd_Box& theBox)
+{
+  Standard_Integer i, aNbV;
+  TopTools_IndexedMapOfShape aMV;
+  //
+  TopExp::MapShapes(theS, TopAbs_VERTEX, aMV);
+  aNbV=aMV.Extent();
+  for (i=1; i<=aNbV; ++i) {
+    const TopoDS_Vertex& aV=TopoDS::Vertex(aMV(i));
+    Bnd_Box aBoxV;
+    //
+    aBoxV.Add(BRep_Tool::Pnt(aV));
+    aBoxV.Enlarge(BRep_Tool::Tolerance(aV)+theGap);
+    theBox.Add(aBoxV);
+  }
+}
+//=======================================================================
+//function : TileCell
+//purpose  :
+//=======================================================================
+void TileCell(const Standard_Real theX,
+              const Standard_Real theY,
+              const Standard_Real theZ,
+              const Standard_Real theMin[3],
+              const Standard_Real theH,
+              GEOMAlgo_TileCell& theC)
+{
+  theC.X=(Standard_Integer)std::floor((theX-theMin[0])/theH);
+  theC.Y=(Standard_Integer)std::floor((theY-theMin[1])/theH);
+  theC.Z=(Standard_Integer)std::floor((theZ-theMin[2])/theH);
+  theC.Index=0;
+}
+//=======================================================================
+//function : IsInTile
+//purpose  : Returns true if theBox is in one tile theC
+//=======================================================================
+Standard_Boolean IsInTile(const Bnd_Box& theBox,
+                          const Standard_Real theMin[3],
+                          const Standard_Real theH,
+                          GEOMAlgo_TileCell& theC)
+{
+  Standard_Real aX[6];
+  GEOMAlgo_TileCell aC2;
+  //
+  theBox.Get(aX[0], aX[1], aX[2], aX[3], aX[4], aX[5]);
+  TileCell(aX[0], aX[1], aX[2], theMin, theH, theC);
+  TileCell(aX[3], aX[4], aX[5], theMin, theH, aC2);
+  //
+  return theC.IsSameTile(aC2);
+}
+//=======================================================================
+//function : IsInBox
+//purpose  : Returns true if theBox is inside theBoxOuter
+//=======================================================================
+Standard_Boolean IsInBox(const Bnd_Box& theBox,
+                         const Bnd_Box& theBoxOuter)
+{
+  Standard_Integer k;
+  Standard_Real aX[6], aXO[6];
+  //
+  if (theBox.IsVoid()) {
+    return Standard_True;
+  }
+  if (theBoxOuter.IsVoid()) {
+    return Standard_False;
+  }
+  theBox.Get(aX[0], aX[1], aX[2], aX[3], aX[4], aX[5]);
+  theBoxOuter.Get(aXO[0], aXO[1], aXO[2], aXO[3], aXO[4], aXO[5]);
+  for (k=0; k<3; ++k) {
+    if (aX[k]<aXO[k] || aX[k+3]>aXO[k+3]) {
+      return Standard_False;
+    }
+  }
+  return Standard_True;
+}
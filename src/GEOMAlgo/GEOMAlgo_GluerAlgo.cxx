@@ -35,6 +35,7 @@ GEOMAlgo_GluerAlgo::GEOMAlgo_GluerAlgo()
 {
   myTolerance=0.0001;
   myCheckGeometry=Standard_True;
+  myUseOBB=Standard_False;
 }
 //=======================================================================
 //function : ~GEOMAlgo_GluerAlgo
@@ -93,6 +94,22 @@ Standard_Boolean GEOMAlgo_GluerAlgo::CheckGeometry() const
   return myCheckGeometry;
 }
 //=======================================================================
+//function : SetUseOBB
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GluerAlgo::SetUseOBB(const Standard_Boolean theFlag)
+{
+  myUseOBB=theFlag;
+}
+//=======================================================================
+//function : UseOBB
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GluerAlgo::UseOBB() const
+{
+  return myUseOBB;
+}
+//=======================================================================
 //function : SetContext
 //purpose  :
 //=======================================================================
@@ -109,6 +126,36 @@ const Handle(IntTools_Context)& GEOMAlgo_GluerAlgo::Context()
   return myContext;
 }
 //=======================================================================
+//function : SetTopologyIndex
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GluerAlgo::SetTopologyIndex
+  (const Handle(GEOMAlgo_TopologyIndex)& theIndex)
+{
+  myTopology=theIndex;
+}
+//=======================================================================
+//function : TopologyIndex
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_TopologyIndex)& GEOMAlgo_GluerAlgo::TopologyIndex()const
+{
+  return myTopology;
+}
+//=======================================================================
+//function : PrepareTopologyIndex
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GluerAlgo::PrepareTopologyIndex()
+{
+  if (!myTopology.IsNull() && myTopology->Shape().IsEqual(myArgument)) {
+    return;
+  }
+  // the index given may be shared, so it is not changed
+  myTopology=new GEOMAlgo_TopologyIndex;
+  myTopology->Init(myArgument);
+}
+//=======================================================================
 //function : Images
 //purpose  :
 //=======================================================================
@@ -34,6 +34,7 @@
 #include <IntTools_Context.hxx>
 #include <TopTools_DataMapOfShapeListOfShape.hxx>
 #include <TopTools_DataMapOfShapeShape.hxx>
+#include <GEOMAlgo_TopologyIndex.hxx>
 
 //=======================================================================
 //class    : GEOMAlgo_GluerAlgo
@@ -66,6 +67,15 @@ public:
   Standard_EXPORT
     Standard_Boolean CheckGeometry() const;
 
+  //! Sets the flag to prune the candidates by oriented bounding
+  //! boxes (Bnd_OBB) after the axis-aligned ones.
+  //! It is useful for thin rotated shapes; the result is the same.
+  Standard_EXPORT
+    void SetUseOBB(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean UseOBB() const;
+
   Standard_EXPORT
     virtual  void Perform() ;
 
@@ -78,17 +88,32 @@ public:
   Standard_EXPORT
     const Handle(IntTools_Context)& Context() ;
 
+  //! Sets the topology index of the argument to share it between
+  //! the algorithms; the index is built by the algorithm if it is
+  //! not set or it is built for an other shape.
+  Standard_EXPORT
+    void SetTopologyIndex(const Handle(GEOMAlgo_TopologyIndex)& theIndex) ;
+
+  Standard_EXPORT
+    const Handle(GEOMAlgo_TopologyIndex)& TopologyIndex() const;
+
   Standard_EXPORT
     const TopTools_DataMapOfShapeListOfShape& Images() const;
 
   Standard_EXPORT
     const TopTools_DataMapOfShapeShape& Origins() const;
 
+protected:
+  Standard_EXPORT
+    void PrepareTopologyIndex() ;
+
 protected:
   TopoDS_Shape myArgument;
   Standard_Real myTolerance;
   Standard_Boolean myCheckGeometry;
+  Standard_Boolean myUseOBB;
   Handle(IntTools_Context) myContext;
+  Handle(GEOMAlgo_TopologyIndex) myTopology;
   TopTools_DataMapOfShapeListOfShape myImages;
   TopTools_DataMapOfShapeShape myOrigins;
 
@@ -0,0 +1,275 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_LinearBVH.cxx
+
+#include <GEOMAlgo_LinearBVH.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+static
+  unsigned int ExpandBits(unsigned int aV);
+
+static
+  unsigned int MortonCode(const Standard_Real aC[3],
+                          const Standard_Real aMin[3],
+                          const Standard_Real aScale[3]);
+
+//! Max number of elements in a leaf
+static const Standard_Integer THE_LEAF_SIZE=4;
+
+//=======================================================================
+//function : GEOMAlgo_LinearBVH
+//purpose  :
+//=======================================================================
+GEOMAlgo_LinearBVH::GEOMAlgo_LinearBVH()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_LinearBVH::Clear()
+{
+  myMin.clear();
+  myMax.clear();
+  myIds.clear();
+  myNodes.clear();
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+void GEOMAlgo_LinearBVH::Add(const Standard_Integer theId,
+                             const Standard_Real theMin[3],
+                             const Standard_Real theMax[3])
+{
+  Standard_Integer k;
+  //
+  for (k=0; k<3; ++k) {
+    myMin.push_back(theMin[k]);
+    myMax.push_back(theMax[k]);
+  }
+  myIds.push_back(theId);
+}
+//=======================================================================
+//function : Build
+//purpose  :
+//=======================================================================
+void GEOMAlgo_LinearBVH::Build()
+{
+  Standard_Integer i, k, aNb;
+  Standard_Real aMin[3], aMax[3], aScale[3], aC[3];
+  //
+  myNodes.clear();
+  //
+  aNb=Size();
+  if (!aNb) {
+    return;
+  }
+  //
+  // 1. Bounds of the centers
+  for (k=0; k<3; ++k) {
+    aMin[k]=std::numeric_limits<Standard_Real>::max();
+    aMax[k]=-aMin[k];
+  }
+  for (i=0; i<aNb; ++i) {
+    for (k=0; k<3; ++k) {
+      aC[k]=0.5*myMin[3*i+k]+0.5*myMax[3*i+k];
+      aMin[k]=std::min(aMin[k], aC[k]);
+      aMax[k]=std::max(aMax[k], aC[k]);
+    }
+  }
+  for (k=0; k<3; ++k) {
+    aScale[k]=(aMax[k]>aMin[k]) ? 1023./(aMax[k]-aMin[k]) : 0.;
+  }
+  //
+  // 2. Morton order; the position is the second key to keep
+  //    the order deterministic
+  std::vector< std::pair<unsigned int, Standard_Integer> > aCodes(aNb);
+  for (i=0; i<aNb; ++i) {
+    for (k=0; k<3; ++k) {
+      aC[k]=0.5*myMin[3*i+k]+0.5*myMax[3*i+k];
+    }
+    aCodes[i]=std::make_pair(MortonCode(aC, aMin, aScale), i);
+  }
+  std::sort(aCodes.begin(), aCodes.end());
+  //
+  std::vector<Standard_Real> aSMin(3*aNb), aSMax(3*aNb);
+  std::vector<Standard_Integer> aSIds(aNb);
+  for (i=0; i<aNb; ++i) {
+    const Standard_Integer aPos=aCodes[i].second;
+    for (k=0; k<3; ++k) {
+      aSMin[3*i+k]=myMin[3*aPos+k];
+      aSMax[3*i+k]=myMax[3*aPos+k];
+    }
+    aSIds[i]=myIds[aPos];
+  }
+  myMin.swap(aSMin);
+  myMax.swap(aSMax);
+  myIds.swap(aSIds);
+  //
+  // 3. Nodes
+  myNodes.reserve(aNb/THE_LEAF_SIZE+1);
+  BuildNode(0, aNb);
+}
+//=======================================================================
+//function : BuildNode
+//purpose  : Splits the range [theBegin, theEnd) into four parts
+//=======================================================================
+Standard_Integer GEOMAlgo_LinearBVH::BuildNode(const Standard_Integer theBegin,
+                                               const Standard_Integer theEnd)
+{
+  Standard_Integer i, k, m, aNode, aChunk, aB, aE, aChild, aCount;
+  Standard_Real aMin[3], aMax[3];
+  float aMinF[3], aMaxF[3];
+  //
+  aNode=(Standard_Integer)myNodes.size();
+  myNodes.push_back(Node());
+  //
+  aChunk=(theEnd-theBegin+3)/4;
+  for (k=0; k<4; ++k) {
+    aB=std::min(theBegin+k*aChunk, theEnd);
+    aE=std::min(aB+aChunk, theEnd);
+    //
+    aChild=-1;
+    aCount=0;
+    aMinF[0]=aMinF[1]=aMinF[2]=std::numeric_limits<float>::infinity();
+    aMaxF[0]=aMaxF[1]=aMaxF[2]=-std::numeric_limits<float>::infinity();
+    //
+    if (aB<aE) {
+      for (m=0; m<3; ++m) {
+        aMin[m]=myMin[3*aB+m];
+        aMax[m]=myMax[3*aB+m];
+      }
+      for (i=aB+1; i<aE; ++i) {
+        for (m=0; m<3; ++m) {
+          aMin[m]=std::min(aMin[m], myMin[3*i+m]);
+          aMax[m]=std::max(aMax[m], myMax[3*i+m]);
+        }
+      }
+      RoundDown(aMin, aMinF);
+      RoundUp(aMax, aMaxF);
+      //
+      if (aE-aB<=THE_LEAF_SIZE) {
+        aChild=aB;
+        aCount=aE-aB;
+      }
+      else {
+        aChild=BuildNode(aB, aE);
+      }
+    }
+    //
+    // myNodes may be reallocated by BuildNode()
+    Node& aN=myNodes[aNode];
+    aN.MinX[k]=aMinF[0]; aN.MinY[k]=aMinF[1]; aN.MinZ[k]=aMinF[2];
+    aN.MaxX[k]=aMaxF[0]; aN.MaxY[k]=aMaxF[1]; aN.MaxZ[k]=aMaxF[2];
+    aN.Child[k]=aChild;
+    aN.Count[k]=aCount;
+  }
+  return aNode;
+}
+//=======================================================================
+//function : RoundDown
+//purpose  : Converts the bounds to float rounding them down
+//=======================================================================
+void GEOMAlgo_LinearBVH::RoundDown(const Standard_Real theMin[3],
+                                   float theMinF[3])
+{
+  Standard_Integer k;
+  const float aMaxF=std::numeric_limits<float>::max();
+  const float aInf=std::numeric_limits<float>::infinity();
+  //
+  for (k=0; k<3; ++k) {
+    if (theMin[k]<-aMaxF) {
+      theMinF[k]=-aInf;
+    }
+    else if (theMin[k]>aMaxF) {
+      theMinF[k]=aMaxF;
+    }
+    else {
+      theMinF[k]=(float)theMin[k];
+      if ((Standard_Real)theMinF[k]>theMin[k]) {
+        theMinF[k]=std::nextafter(theMinF[k], -aInf);
+      }
+    }
+  }
+}
+//=======================================================================
+//function : RoundUp
+//purpose  : Converts the bounds to float rounding them up
+//=======================================================================
+void GEOMAlgo_LinearBVH::RoundUp(const Standard_Real theMax[3],
+                                 float theMaxF[3])
+{
+  Standard_Integer k;
+  const float aMaxF=std::numeric_limits<float>::max();
+  const float aInf=std::numeric_limits<float>::infinity();
+  //
+  for (k=0; k<3; ++k) {
+    if (theMax[k]>aMaxF) {
+      theMaxF[k]=aInf;
+    }
+    else if (theMax[k]<-aMaxF) {
+      theMaxF[k]=-aMaxF;
+    }
+    else {
+      theMaxF[k]=(float)theMax[k];
+      if ((Standard_Real)theMaxF[k]<theMax[k]) {
+        theMaxF[k]=std::nextafter(theMaxF[k], aInf);
+      }
+    }
+  }
+}
+//=======================================================================
+//function : ExpandBits
+//purpose  : Inserts two zero bits after each of the 10 low bits
+//=======================================================================
+unsigned int ExpandBits(unsigned int aV)
+{
+  aV=(aV*0x00010001u) & 0xFF0000FFu;
+  aV=(aV*0x00000101u) & 0x0F00F00Fu;
+  aV=(aV*0x00000011u) & 0xC30C30C3u;
+  aV=(aV*0x00000005u) & 0x49249249u;
+  return aV;
+}
+//=======================================================================
+//function : MortonCode
+//purpose  : 30-bit Morton code of the point
+//=======================================================================
+unsigned int MortonCode(const Standard_Real aC[3],
+                        const Standard_Real aMin[3],
+                        const Standard_Real aScale[3])
+{
+  Standard_Integer k;
+  unsigned int aCode[3];
+  //
+  for (k=0; k<3; ++k) {
+    Standard_Real aX=(aC[k]-aMin[k])*aScale[k];
+    aX=std::min(std::max(aX, 0.), 1023.);
+    aCode[k]=ExpandBits((unsigned int)aX);
+  }
+  return (aCode[0]<<2) | (aCode[1]<<1) | aCode[2];
+}
@@ -0,0 +1,153 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_LinearBVH.hxx
+
+#ifndef _GEOMAlgo_LinearBVH_HeaderFile
+#define _GEOMAlgo_LinearBVH_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+
+#include <vector>
+
+//=======================================================================
+//class    : GEOMAlgo_LinearBVH
+//purpose  : Flat bounding volume hierarchy over axis-aligned boxes.
+//           The elements are ordered along the Morton curve of their
+//           centers and grouped into nodes of four children.
+//           The bounds of the four children of a node are stored as
+//           structure of arrays, so that one node test checks all
+//           of them in a loop the compiler can vectorize.
+//           The tree only prunes the candidates; the exact test of
+//           an element is made by the visitor passed to Select().
+//=======================================================================
+class GEOMAlgo_LinearBVH
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_LinearBVH();
+
+  Standard_EXPORT
+    void Clear();
+
+  //! Adds the element <theId> with the given bounds. <br>
+  Standard_EXPORT
+    void Add(const Standard_Integer theId,
+             const Standard_Real theMin[3],
+             const Standard_Real theMax[3]);
+
+  //! Builds the tree from the elements added. <br>
+  Standard_EXPORT
+    void Build();
+
+  //! Returns the number of elements. <br>
+  Standard_Integer Size() const
+  {
+    return (Standard_Integer)myIds.size();
+  }
+
+  //! Calls theVisitor(theId) for each element whose bounds
+  //! overlap the box [theMin, theMax]. <br>
+  template <class TheVisitor>
+    void Select(const Standard_Real theMin[3],
+                const Standard_Real theMax[3],
+                TheVisitor& theVisitor) const;
+
+ protected:
+  //! Four children of an inner node.
+  //! Count>0  : leaf, elements [Child, Child+Count) of myIds;
+  //! Count==0 : inner node Child, or empty lane if Child<0.
+  struct Node
+  {
+    float MinX[4], MinY[4], MinZ[4];
+    float MaxX[4], MaxY[4], MaxZ[4];
+    Standard_Integer Child[4];
+    Standard_Integer Count[4];
+  };
+
+  Standard_EXPORT
+    Standard_Integer BuildNode(const Standard_Integer theBegin,
+                               const Standard_Integer theEnd);
+
+  Standard_EXPORT
+    static void RoundDown(const Standard_Real theMin[3], float theMinF[3]);
+
+  Standard_EXPORT
+    static void RoundUp(const Standard_Real theMax[3], float theMaxF[3]);
+
+ protected:
+  std::vector<Standard_Real> myMin;
+  std::vector<Standard_Real> myMax;
+  std::vector<Standard_Integer> myIds;
+  std::vector<Node> myNodes;
+};
+
+//=======================================================================
+//function : Select
+//purpose  :
+//=======================================================================
+template <class TheVisitor>
+  void GEOMAlgo_LinearBVH::Select(const Standard_Real theMin[3],
+                                  const Standard_Real theMax[3],
+                                  TheVisitor& theVisitor) const
+{
+  Standard_Integer aStack[256], aTop, k, j, aNode, aHit[4];
+  float aQMin[3], aQMax[3];
+  //
+  if (myNodes.empty()) {
+    return;
+  }
+  //
+  RoundDown(theMin, aQMin);
+  RoundUp(theMax, aQMax);
+  //
+  aTop=0;
+  aStack[aTop++]=0;
+  while (aTop) {
+    aNode=aStack[--aTop];
+    const Node& aN=myNodes[aNode];
+    //
+    for (k=0; k<4; ++k) {
+      aHit[k]=(aN.MinX[k]<=aQMax[0]) & (aN.MaxX[k]>=aQMin[0]) &
+              (aN.MinY[k]<=aQMax[1]) & (aN.MaxY[k]>=aQMin[1]) &
+              (aN.MinZ[k]<=aQMax[2]) & (aN.MaxZ[k]>=aQMin[2]);
+    }
+    //
+    for (k=3; k>=0; --k) {
+      if (!aHit[k]) {
+        continue;
+      }
+      if (!aN.Count[k]) {
+        aStack[aTop++]=aN.Child[k];
+        continue;
+      }
+      for (j=aN.Child[k]; j<aN.Child[k]+aN.Count[k]; ++j) {
+        theVisitor(myIds[j]);
+      }
+    }
+  }
+}
+
+#endif
@@ -27,18 +27,10 @@
 //
 #include <GEOMAlgo_PassKey.hxx>
 
-#include <stdio.h>
-#include <string.h>
 #include <TColStd_ListIteratorOfListOfInteger.hxx>
 #include <TColStd_ListOfInteger.hxx>
 
-#ifdef WIN32
-#pragma warning( disable : 4101)
-#endif
-
-static
-  Standard_Integer NormalizedId(const Standard_Integer aId,
-                                const Standard_Integer aDiv);
+#include <algorithm>
 
 //=======================================================================
 //function :
@@ -54,9 +46,7 @@ static
 //=======================================================================
   GEOMAlgo_PassKey::GEOMAlgo_PassKey(const GEOMAlgo_PassKey& aOther)
 {
-  myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  Assign(aOther);
 }
 //=======================================================================
 //function :Assign
@@ -64,9 +54,14 @@ static
 //=======================================================================
   GEOMAlgo_PassKey& GEOMAlgo_PassKey::Assign(const GEOMAlgo_PassKey& aOther)
 {
+  Standard_Integer i;
+  //
   myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  myHash=aOther.myHash;
+  for (i=0; i<NbInline; ++i) {
+    myInline[i]=aOther.myInline[i];
+  }
+  myExtra=aOther.myExtra;
   return *this;
 }
 //=======================================================================
@@ -83,8 +78,8 @@ static
   void GEOMAlgo_PassKey::Clear()
 {
   myNbIds=0;
-  mySum=0;
-  myMap.Clear();
+  myHash=0;
+  myExtra.clear();
 }
 //=======================================================================
 //function :SetIds
@@ -95,8 +90,8 @@ static
 {
   Clear();
   myNbIds=1;
-  myMap.Add(aId1);
-  mySum=NormalizedId(aId1, myNbIds);
+  myInline[0]=aId1;
+  Sort();
 }
 //=======================================================================
 //function :SetIds
@@ -105,11 +100,11 @@ static
   void GEOMAlgo_PassKey::SetIds(const Standard_Integer aId1,
                                 const Standard_Integer aId2)
 {
-  TColStd_ListOfInteger aLI;
-  //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  SetIds(aLI);
+  Clear();
+  myNbIds=2;
+  myInline[0]=aId1;
+  myInline[1]=aId2;
+  Sort();
 }
 //=======================================================================
 //function :SetIds
@@ -119,12 +114,12 @@ static
                                 const Standard_Integer aId2,
                                 const Standard_Integer aId3)
 {
-  TColStd_ListOfInteger aLI;
-  //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  aLI.Append(aId3);
-  SetIds(aLI);
+  Clear();
+  myNbIds=3;
+  myInline[0]=aId1;
+  myInline[1]=aId2;
+  myInline[2]=aId3;
+  Sort();
 }
 //=======================================================================
 //function :SetIds
@@ -135,13 +130,13 @@ static
                                 const Standard_Integer aId3,
                                 const Standard_Integer aId4)
 {
-  TColStd_ListOfInteger aLI;
-  //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  aLI.Append(aId3);
-  aLI.Append(aId4);
-  SetIds(aLI);
+  Clear();
+  myNbIds=4;
+  myInline[0]=aId1;
+  myInline[1]=aId2;
+  myInline[2]=aId3;
+  myInline[3]=aId4;
+  Sort();
 }
 //=======================================================================
 //function :SetIds
@@ -149,20 +144,54 @@ static
 //=======================================================================
   void GEOMAlgo_PassKey::SetIds(const TColStd_ListOfInteger& aLI)
 {
-  Standard_Integer i, aId, aIdN;
+  Standard_Integer i;
+  Standard_Integer* pIds;
   TColStd_ListIteratorOfListOfInteger aIt;
   //
   Clear();
+  myNbIds=aLI.Extent();
+  if (myNbIds>NbInline) {
+    myExtra.resize(myNbIds);
+    pIds=&myExtra[0];
+  }
+  else {
+    pIds=myInline;
+  }
+  //
   aIt.Initialize(aLI);
-  for (; aIt.More(); aIt.Next()) {
-    aId=aIt.Value();
-    myMap.Add(aId);
+  for (i=0; aIt.More(); aIt.Next(), ++i) {
+    pIds[i]=aIt.Value();
   }
-  myNbIds=myMap.Extent();
-  for(i=1; i<=myNbIds; ++i) {
-    aId=myMap(i);
-    aIdN=NormalizedId(aId, myNbIds);
-    mySum+=aIdN;
+  Sort();
+}
+//=======================================================================
+//function :Sort
+//purpose  : Sorts the ids, removes the duplicates and computes the hash
+//=======================================================================
+  void GEOMAlgo_PassKey::Sort()
+{
+  Standard_Integer i, aNb;
+  Standard_Integer* pIds;
+  //
+  pIds=(myNbIds>NbInline) ? &myExtra[0] : myInline;
+  std::sort(pIds, pIds+myNbIds);
+  aNb=(Standard_Integer)(std::unique(pIds, pIds+myNbIds)-pIds);
+  //
+  if (myNbIds>NbInline) {
+    if (aNb>NbInline) {
+      myExtra.resize(aNb);
+    }
+    else {
+      std::copy(pIds, pIds+aNb, myInline);
+      myExtra.clear();
+    }
+  }
+  myNbIds=aNb;
+  //
+  pIds=(myNbIds>NbInline) ? &myExtra[0] : myInline;
+  myHash=(size_t)myNbIds;
+  for (i=0; i<myNbIds; ++i) {
+    myHash=HashCombine(myHash, (size_t)pIds[i]);
   }
 }
 //=======================================================================
@@ -182,7 +211,7 @@ static
   if (aIndex<1 || aIndex>myNbIds) {
     return -1;
   }
-  return myMap(aIndex);
+  return Ids()[aIndex-1];
 }
 //=======================================================================
 //function :IsEqual
@@ -190,21 +219,10 @@ static
 //=======================================================================
   Standard_Boolean GEOMAlgo_PassKey::IsEqual(const GEOMAlgo_PassKey& aOther) const
 {
-  Standard_Boolean bRet;
-  Standard_Integer i, aId;
-  //
-  bRet=Standard_False;
-  //
-  if (myNbIds!=aOther.myNbIds) {
-    return bRet;
-  }
-  for (i=1; i<=myNbIds; ++i) {
-    aId=myMap(i);
-    if (!aOther.myMap.Contains(aId)) {
-      return bRet;
-    }
+  if (myNbIds!=aOther.myNbIds || myHash!=aOther.myHash) {
+    return Standard_False;
   }
-  return !bRet;
+  return std::equal(Ids(), Ids()+myNbIds, aOther.Ids());
 }
 #if OCC_VERSION_LARGE < 0x07080000
 //=======================================================================
@@ -213,30 +231,32 @@ static
 //=======================================================================
   Standard_Integer GEOMAlgo_PassKey::HashCode(const Standard_Integer aUpper) const
 {
-  return ::HashCode(mySum, aUpper);
+  return ::HashCode((Standard_Integer)(myHash & (size_t)IntegerLast()), aUpper);
 }
 #endif
 //=======================================================================
-//function : Dump
-//purpose  :
+//function : HashCombine
+//purpose  : Mixes the value into the hash (64-bit Murmur3 finalizer)
 //=======================================================================
-  void GEOMAlgo_PassKey::Dump(const Standard_Integer )const
+  size_t GEOMAlgo_PassKey::HashCombine(const size_t theHash,
+                                       const size_t theValue)
 {
+  unsigned long long aX;
+  //
+  aX=(unsigned long long)theValue+0x9e3779b97f4a7c15ULL+
+    ((unsigned long long)theHash<<6)+((unsigned long long)theHash>>2);
+  aX^=(unsigned long long)theHash;
+  aX^=aX>>33;
+  aX*=0xff51afd7ed558ccdULL;
+  aX^=aX>>33;
+  aX*=0xc4ceb9fe1a85ec53ULL;
+  aX^=aX>>33;
+  return (size_t)aX;
 }
 //=======================================================================
-// function: NormalizedId
-// purpose :
+//function : Dump
+//purpose  :
 //=======================================================================
-Standard_Integer NormalizedId(const Standard_Integer aId,
-                              const Standard_Integer aDiv)
+  void GEOMAlgo_PassKey::Dump(const Standard_Integer )const
 {
-  Standard_Integer aMax, aTresh, aIdRet;
-  //
-  aIdRet=aId;
-  aMax=::IntegerLast();
-  aTresh=aMax/aDiv;
-  if (aId>aTresh) {
-    aIdRet=aId%aTresh;
-  }
-  return aIdRet;
 }
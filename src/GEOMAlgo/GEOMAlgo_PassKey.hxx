@@ -36,11 +36,15 @@
 #include <Standard_Boolean.hxx>
 
 #include <TColStd_ListOfInteger.hxx>
-#include <TColStd_IndexedMapOfInteger.hxx>
+
+#include <vector>
 
 //=======================================================================
 //class : GEOMAlgo_PassKey
-//purpose  :
+//purpose  : Unordered set of ids.
+//           The ids are kept sorted; up to four of them are stored
+//           inline, so that the keys of edges and of most faces
+//           do not allocate memory.
 //=======================================================================
 class GEOMAlgo_PassKey  {
  public:
@@ -101,8 +105,9 @@ class GEOMAlgo_PassKey  {
     return IsEqual(theOther);
   }
 
+  //! Returns the hash code of the sorted ids
   Standard_EXPORT
-  size_t GetSum() const { return (size_t)mySum; }
+  size_t GetSum() const { return myHash; }
 
   Standard_EXPORT
     Standard_Integer Id(const Standard_Integer aIndex) const;
@@ -110,10 +115,26 @@ class GEOMAlgo_PassKey  {
   Standard_EXPORT
     void Dump(const Standard_Integer aHex = 0) const;
 
+  //! Mixes <theValue> into <theHash>
+  Standard_EXPORT
+    static size_t HashCombine(const size_t theHash,
+                              const size_t theValue);
+
+ protected:
+  Standard_EXPORT
+    void Sort() ;
+
+  const Standard_Integer* Ids() const
+  {
+    return (myNbIds>NbInline) ? &myExtra[0] : myInline;
+  }
+
  protected:
+  enum { NbInline = 4 };
   Standard_Integer myNbIds;
-  Standard_Integer mySum;
-  TColStd_IndexedMapOfInteger myMap;
+  size_t myHash;
+  Standard_Integer myInline[NbInline];
+  std::vector<Standard_Integer> myExtra;
 };
 
 namespace std
@@ -32,17 +32,20 @@
 #include <TopTools_ListOfShape.hxx>
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 
+#include <GEOMAlgo_PassKey.hxx>
+
+#include <algorithm>
+
 
 static
-  Standard_Integer NormalizedId(const Standard_Integer aId,
-                                const Standard_Integer aDiv);
+  size_t ShapeKey(const TopoDS_Shape& aS);
 //=======================================================================
 //function :
 //purpose  :
 //=======================================================================
   GEOMAlgo_PassKeyShape::GEOMAlgo_PassKeyShape()
 {
-  myUpper=432123;
+  Clear();
 }
 //=======================================================================
 //function :
@@ -50,10 +53,7 @@ static
 //=======================================================================
   GEOMAlgo_PassKeyShape::GEOMAlgo_PassKeyShape(const GEOMAlgo_PassKeyShape& aOther)
 {
-  myUpper=432123;
-  myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  Assign(aOther);
 }
 //=======================================================================
 //function :~
@@ -68,10 +68,14 @@ static
 //=======================================================================
   GEOMAlgo_PassKeyShape& GEOMAlgo_PassKeyShape::Assign(const GEOMAlgo_PassKeyShape& aOther)
 {
-  myUpper=432123;
+  Standard_Integer i;
+  //
   myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  myHash=aOther.myHash;
+  for (i=0; i<NbInline; ++i) {
+    myInline[i]=aOther.myInline[i];
+  }
+  myExtra=aOther.myExtra;
   return *this;
 }
 //=======================================================================
@@ -80,9 +84,14 @@ static
 //=======================================================================
   void GEOMAlgo_PassKeyShape::Clear()
 {
+  Standard_Integer i;
+  //
   myNbIds=0;
-  mySum=0;
-  myMap.Clear();
+  myHash=0;
+  for (i=0; i<NbInline; ++i) {
+    myInline[i].Shape.Nullify();
+  }
+  myExtra.clear();
 }
 //=======================================================================
 //function :SetShapes
@@ -91,17 +100,10 @@ static
   void GEOMAlgo_PassKeyShape::SetShapes(const TopoDS_Shape& aS1)
 
 {
-  Standard_Integer aHC;
-  //
   Clear();
   myNbIds=1;
-  myMap.Add(aS1);
-#if OCC_VERSION_LARGE < 0x07080000
-  aHC=aS1.HashCode(myUpper);
-#else
-  aHC = std::hash<TopoDS_Shape>{}(aS1);
-#endif
-  mySum=NormalizedId(aHC, myNbIds);
+  myInline[0].Shape=aS1;
+  Sort();
 }
 //=======================================================================
 //function :SetShapes
@@ -110,11 +112,11 @@ static
   void GEOMAlgo_PassKeyShape::SetShapes(const TopoDS_Shape& aS1,
                                         const TopoDS_Shape& aS2)
 {
-  TopTools_ListOfShape aLS;
-  //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  SetShapes(aLS);
+  Clear();
+  myNbIds=2;
+  myInline[0].Shape=aS1;
+  myInline[1].Shape=aS2;
+  Sort();
 }
 //=======================================================================
 //function :SetShapes
@@ -124,12 +126,12 @@ static
                                         const TopoDS_Shape& aS2,
                                         const TopoDS_Shape& aS3)
 {
-  TopTools_ListOfShape aLS;
-  //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  aLS.Append(aS3);
-  SetShapes(aLS);
+  Clear();
+  myNbIds=3;
+  myInline[0].Shape=aS1;
+  myInline[1].Shape=aS2;
+  myInline[2].Shape=aS3;
+  Sort();
 }
 //=======================================================================
 //function :SetShapes
@@ -140,13 +142,13 @@ static
                                         const TopoDS_Shape& aS3,
                                         const TopoDS_Shape& aS4)
 {
-  TopTools_ListOfShape aLS;
-  //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  aLS.Append(aS3);
-  aLS.Append(aS4);
-  SetShapes(aLS);
+  Clear();
+  myNbIds=4;
+  myInline[0].Shape=aS1;
+  myInline[1].Shape=aS2;
+  myInline[2].Shape=aS3;
+  myInline[3].Shape=aS4;
+  Sort();
 }
 //=======================================================================
 //function :SetShapes
@@ -154,25 +156,78 @@ static
 //=======================================================================
   void GEOMAlgo_PassKeyShape::SetShapes(const TopTools_ListOfShape& aLS)
 {
-  Standard_Integer i, aId, aIdN;
+  Standard_Integer i;
+  Item* pItems;
   TopTools_ListIteratorOfListOfShape aIt;
   //
   Clear();
+  myNbIds=aLS.Extent();
+  if (myNbIds>NbInline) {
+    myExtra.resize(myNbIds);
+    pItems=&myExtra[0];
+  }
+  else {
+    pItems=myInline;
+  }
+  //
   aIt.Initialize(aLS);
-  for (; aIt.More(); aIt.Next()) {
-    const TopoDS_Shape& aS=aIt.Value();
-    myMap.Add(aS);
+  for (i=0; aIt.More(); aIt.Next(), ++i) {
+    pItems[i].Shape=aIt.Value();
   }
-  myNbIds=myMap.Extent();
-  for(i=1; i<=myNbIds; ++i) {
-    const TopoDS_Shape& aS=myMap(i);
-#if OCC_VERSION_LARGE < 0x07080000
-    aId=aS.HashCode(myUpper);
-#else
-    aId = std::hash<TopoDS_Shape>{}(aS);
-#endif
-    aIdN=NormalizedId(aId, myNbIds);
-    mySum+=aIdN;
+  Sort();
+}
+//=======================================================================
+//function :Sort
+//purpose  : Sorts the shapes by their keys, removes the duplicates
+//           and computes the hash
+//=======================================================================
+  void GEOMAlgo_PassKeyShape::Sort()
+{
+  Standard_Boolean bFound;
+  Standard_Integer i, j, aNb;
+  Item* pItems;
+  //
+  pItems=(myNbIds>NbInline) ? &myExtra[0] : myInline;
+  for (i=0; i<myNbIds; ++i) {
+    pItems[i].Key=ShapeKey(pItems[i].Shape);
+  }
+  std::stable_sort(pItems, pItems+myNbIds,
+                   [](const Item& theI1, const Item& theI2)
+                   { return theI1.Key<theI2.Key; });
+  //
+  // the shapes with equal keys are adjacent
+  aNb=0;
+  for (i=0; i<myNbIds; ++i) {
+    bFound=Standard_False;
+    for (j=aNb-1; j>=0 && pItems[j].Key==pItems[i].Key; --j) {
+      if (pItems[j].Shape.IsSame(pItems[i].Shape)) {
+        bFound=Standard_True;
+        break;
+      }
+    }
+    if (!bFound) {
+      if (aNb!=i) {
+        pItems[aNb]=pItems[i];
+      }
+      ++aNb;
+    }
+  }
+  //
+  if (myNbIds>NbInline) {
+    if (aNb>NbInline) {
+      myExtra.resize(aNb);
+    }
+    else {
+      std::copy(pItems, pItems+aNb, myInline);
+      myExtra.clear();
+    }
+  }
+  myNbIds=aNb;
+  //
+  pItems=(myNbIds>NbInline) ? &myExtra[0] : myInline;
+  myHash=(size_t)myNbIds;
+  for (i=0; i<myNbIds; ++i) {
+    myHash=GEOMAlgo_PassKey::HashCombine(myHash, pItems[i].Key);
   }
 }
 //=======================================================================
@@ -189,21 +244,36 @@ static
 //=======================================================================
   Standard_Boolean GEOMAlgo_PassKeyShape::IsEqual(const GEOMAlgo_PassKeyShape& aOther) const
 {
-  Standard_Boolean bRet;
-  Standard_Integer i;
+  Standard_Boolean bFound;
+  Standard_Integer i, j;
   //
-  bRet=Standard_False;
+  if (myNbIds!=aOther.myNbIds || myHash!=aOther.myHash) {
+    return Standard_False;
+  }
   //
-  if (myNbIds!=aOther.myNbIds) {
-    return bRet;
+  const Item* pItems=Items();
+  const Item* pOther=aOther.Items();
+  for (i=0; i<myNbIds; ++i) {
+    if (pItems[i].Key!=pOther[i].Key) {
+      return Standard_False;
+    }
   }
-  for (i=1; i<=myNbIds; ++i) {
-    const TopoDS_Shape& aS=myMap(i);
-    if (!aOther.myMap.Contains(aS)) {
-      return bRet;
+  //
+  for (i=0; i<myNbIds; ++i) {
+    if (pItems[i].Shape.IsSame(pOther[i].Shape)) {
+      continue;
+    }
+    // different shapes with equal keys may be in any order
+    bFound=Standard_False;
+    for (j=0; j<myNbIds && !bFound; ++j) {
+      bFound=(pOther[j].Key==pItems[i].Key &&
+              pOther[j].Shape.IsSame(pItems[i].Shape));
+    }
+    if (!bFound) {
+      return Standard_False;
     }
   }
-  return !bRet;
+  return Standard_True;
 }
 #if OCC_VERSION_LARGE < 0x07080000
 //=======================================================================
@@ -212,7 +282,7 @@ static
 //=======================================================================
   Standard_Integer GEOMAlgo_PassKeyShape::HashCode(const Standard_Integer aUpper) const
 {
-  return ::HashCode(mySum, aUpper);
+  return ::HashCode((Standard_Integer)(myHash & (size_t)IntegerLast()), aUpper);
 }
 #endif
 //=======================================================================
@@ -223,19 +293,14 @@ static
 {
 }
 //=======================================================================
-// function: NormalizedId
-// purpose :
+// function: ShapeKey
+// purpose : Hash code of the shape consistent with IsSame()
 //=======================================================================
-Standard_Integer NormalizedId(const Standard_Integer aId,
-                              const Standard_Integer aDiv)
+size_t ShapeKey(const TopoDS_Shape& aS)
 {
-  Standard_Integer aMax, aTresh, aIdRet;
-  //
-  aIdRet=aId;
-  aMax=::IntegerLast();
-  aTresh=aMax/aDiv;
-  if (aId>aTresh) {
-    aIdRet=aId%aTresh;
-  }
-  return aIdRet;
+#if OCC_VERSION_LARGE < 0x07080000
+  return (size_t)aS.HashCode(IntegerLast());
+#else
+  return std::hash<TopoDS_Shape>{}(aS);
+#endif
 }
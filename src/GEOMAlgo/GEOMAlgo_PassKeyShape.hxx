@@ -34,15 +34,18 @@
 #include <Standard.hxx>
 #include <Standard_Macro.hxx>
 #include <Standard_Integer.hxx>
-#include <TopTools_IndexedMapOfShape.hxx>
 #include <Standard_Boolean.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopTools_ListOfShape.hxx>
 
+#include <vector>
+
 
 //=======================================================================
 //class    : GEOMAlgo_PassKeyShape
-//purpose  :
+//purpose  : Unordered set of shapes (compared by IsSame()).
+//           The shapes are kept sorted by their hash codes; up to
+//           four of them are stored inline (see GEOMAlgo_PassKey).
 //=======================================================================
 class GEOMAlgo_PassKeyShape  {
  public:
@@ -103,16 +106,33 @@ class GEOMAlgo_PassKeyShape  {
     return IsEqual(theOther);
   }
 
+  //! Returns the hash code of the sorted shapes
   Standard_EXPORT
-    size_t GetSum() const { return (size_t)mySum; }
+    size_t GetSum() const { return myHash; }
 
   Standard_EXPORT
     void Dump(const Standard_Integer aHex = 0) const;
 
 protected:
+  struct Item
+  {
+    size_t Key;
+    TopoDS_Shape Shape;
+  };
+
+  Standard_EXPORT
+    void Sort() ;
+
+  const Item* Items() const
+  {
+    return (myNbIds>NbInline) ? &myExtra[0] : myInline;
+  }
+
+protected:
+  enum { NbInline = 4 };
   Standard_Integer myNbIds;
-  Standard_Integer mySum;
-  Standard_Integer myUpper;
-  TopTools_IndexedMapOfShape myMap;
+  size_t myHash;
+  Item myInline[NbInline];
+  std::vector<Item> myExtra;
 };
 #endif
@@ -0,0 +1,724 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_PointClusterer.cxx
+
+#include <GEOMAlgo_PointClusterer.hxx>
+
+#include <OSD_Parallel.hxx>
+#include <TColStd_MapOfInteger.hxx>
+#include <TColStd_MapIteratorOfMapOfInteger.hxx>
+#include <NCollection_Array1.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+//=======================================================================
+//struct   : GEOMAlgo_PointCell
+//purpose  : The cell of the grid of the level and the point in it
+//=======================================================================
+struct GEOMAlgo_PointCell
+{
+  Standard_Integer Level;
+  Standard_Integer X, Y, Z;
+  Standard_Integer Index;
+  //
+  bool operator<(const GEOMAlgo_PointCell& theOther) const
+  {
+    if (Level!=theOther.Level) {
+      return Level<theOther.Level;
+    }
+    if (X!=theOther.X) {
+      return X<theOther.X;
+    }
+    if (Y!=theOther.Y) {
+      return Y<theOther.Y;
+    }
+    if (Z!=theOther.Z) {
+      return Z<theOther.Z;
+    }
+    return Index<theOther.Index;
+  }
+};
+
+//=======================================================================
+//struct   : GEOMAlgo_PointGrid
+//purpose  : The grids of the levels: the cells of the points, sorted,
+//           the level of each point and the size of the cells of
+//           each level
+//=======================================================================
+struct GEOMAlgo_PointGrid
+{
+  std::vector<GEOMAlgo_PointCell> Cells;
+  std::vector<Standard_Integer> Levels;
+  std::vector<Standard_Real> Sizes;
+  Standard_Real Min[3];
+  //
+  void Cell(const gp_Pnt& theP,
+            const Standard_Integer theLevel,
+            GEOMAlgo_PointCell& theCell) const
+  {
+    const Standard_Real aH=Sizes[theLevel];
+    //
+    theCell.Level=theLevel;
+    theCell.X=(Standard_Integer)std::floor((theP.X()-Min[0])/aH);
+    theCell.Y=(Standard_Integer)std::floor((theP.Y()-Min[1])/aH);
+    theCell.Z=(Standard_Integer)std::floor((theP.Z()-Min[2])/aH);
+  }
+};
+
+//=======================================================================
+//class    : GEOMAlgo_PointClustererFunctor
+//purpose  : Counts (myOffsets==NULL) or fills the neighbours of the
+//           points among the points of the same or the coarser levels
+//=======================================================================
+class GEOMAlgo_PointClustererFunctor
+{
+ public:
+  GEOMAlgo_PointClustererFunctor
+    (const GEOMAlgo_PointClusterer& theClusterer,
+     const GEOMAlgo_PointGrid& theGrid,
+     std::vector<Standard_Integer>& theCounts,
+     std::vector<Standard_Size>& theTested,
+     const std::vector<Standard_Integer>* theOffsets,
+     std::vector<Standard_Integer>* theNeighbours)
+  :
+    myClusterer(theClusterer),
+    myGrid(theGrid),
+    myCounts(theCounts),
+    myTested(theTested),
+    myOffsets(theOffsets),
+    myNeighbours(theNeighbours)
+  {}
+  //
+  void operator()(const Standard_Integer i) const
+  {
+    Standard_Integer aL, aNbL, aDX, aDY, aDZ, aNb, j;
+    Standard_Size aNbTested;
+    Standard_Integer* pN;
+    GEOMAlgo_PointCell aC, aC1, aC2;
+    std::vector<GEOMAlgo_PointCell>::const_iterator aIt1, aIt2;
+    //
+    const std::vector<GEOMAlgo_PointCell>& aCells=myGrid.Cells;
+    const gp_Pnt& aP=myClusterer.myPoints[i-1];
+    //
+    pN=NULL;
+    if (myOffsets) {
+      pN=myNeighbours->data()+(*myOffsets)[i-1];
+    }
+    //
+    aNb=0;
+    aNbTested=0;
+    aNbL=(Standard_Integer)myGrid.Sizes.size();
+    for (aL=myGrid.Levels[i]; aL<aNbL; ++aL) {
+      myGrid.Cell(aP, aL, aC);
+      for (aDX=-1; aDX<=1; ++aDX) {
+        for (aDY=-1; aDY<=1; ++aDY) {
+          for (aDZ=-1; aDZ<=1; ++aDZ) {
+            aC1.Level=aL;
+            aC1.X=aC.X+aDX;
+            aC1.Y=aC.Y+aDY;
+            aC1.Z=aC.Z+aDZ;
+            aC1.Index=0;
+            aC2=aC1;
+            aC2.Index=IntegerLast();
+            //
+            aIt1=std::lower_bound(aCells.begin(), aCells.end(), aC1);
+            aIt2=std::upper_bound(aIt1, aCells.end(), aC2);
+            for (; aIt1!=aIt2; ++aIt1) {
+              j=aIt1->Index;
+              ++aNbTested;
+              if (myClusterer.IsNeighbour(i, j)) {
+                if (pN) {
+                  pN[aNb]=j;
+                }
+                ++aNb;
+              }
+            }
+          }
+        }
+      }
+    }
+    //
+    if (pN) {
+      std::sort(pN, pN+aNb);
+    }
+    else {
+      myCounts[i]=aNb;
+      myTested[i]=aNbTested;
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_PointClusterer& myClusterer;
+  const GEOMAlgo_PointGrid& myGrid;
+  std::vector<Standard_Integer>& myCounts;
+  std::vector<Standard_Size>& myTested;
+  const std::vector<Standard_Integer>* myOffsets;
+  std::vector<Standard_Integer>* myNeighbours;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_PointUnionFunctor
+//purpose  : Concurrent union-find over the neighbour pairs.
+//           The root of each set is its minimal index.
+//=======================================================================
+class GEOMAlgo_PointUnionFunctor
+{
+ public:
+  GEOMAlgo_PointUnionFunctor
+    (const GEOMAlgo_PointClusterer& theClusterer,
+     std::vector< std::atomic<Standard_Integer> >& theParent)
+  :
+    myClusterer(theClusterer),
+    myParent(theParent)
+  {}
+  //
+  void operator()(const Standard_Integer i) const
+  {
+    Standard_Integer k, aNb;
+    //
+    aNb=myClusterer.NbNeighbours(i);
+    for (k=1; k<=aNb; ++k) {
+      Union(i, myClusterer.Neighbour(i, k));
+    }
+  }
+  //
+  Standard_Integer Find(Standard_Integer i) const
+  {
+    Standard_Integer aP, aGP;
+    //
+    for(;;) {
+      aP=myParent[i].load();
+      if (aP==i) {
+        return i;
+      }
+      aGP=myParent[aP].load();
+      if (aGP!=aP) {
+        // path halving
+        myParent[i].compare_exchange_weak(aP, aGP);
+      }
+      i=aGP;
+    }
+  }
+  //
+  void Union(Standard_Integer i1, Standard_Integer i2) const
+  {
+    Standard_Integer aR1, aR2, aTmp;
+    //
+    for(;;) {
+      aR1=Find(i1);
+      aR2=Find(i2);
+      if (aR1==aR2) {
+        return;
+      }
+      if (aR1<aR2) {
+        aTmp=aR1; aR1=aR2; aR2=aTmp;
+      }
+      // link the greater root to the lesser one
+      if (myParent[aR1].compare_exchange_strong(aR1, aR2)) {
+        return;
+      }
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_PointClusterer& myClusterer;
+  std::vector< std::atomic<Standard_Integer> >& myParent;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_PointChainFunctor
+//purpose  : Builds the chain of each seed by the growth of its
+//           neighbourhood
+//=======================================================================
+class GEOMAlgo_PointChainFunctor
+{
+ public:
+  GEOMAlgo_PointChainFunctor
+    (const GEOMAlgo_PointClusterer& theClusterer,
+     const NCollection_Array1<Standard_Integer>& theSeeds,
+     NCollection_Array1<TColStd_ListOfInteger>& theChains)
+  :
+    myClusterer(theClusterer),
+    mySeeds(theSeeds),
+    myChains(theChains)
+  {}
+  //
+  void operator()(const Standard_Integer k) const
+  {
+    Standard_Integer aIP, aIP1, j, aNb;
+    TColStd_MapOfInteger aMIP, aMIP1, aMIPC;
+    TColStd_MapIteratorOfMapOfInteger aIt1;
+    //
+    aMIP.Add(mySeeds(k));
+    for(;;) {
+      aIt1.Initialize(aMIP);
+      for(; aIt1.More(); aIt1.Next()) {
+        aIP=aIt1.Key();
+        if (aMIPC.Contains(aIP)) {
+          continue;
+        }
+        //
+        aNb=myClusterer.NbNeighbours(aIP);
+        for (j=1; j<=aNb; ++j) {
+          aIP1=myClusterer.Neighbour(aIP, j);
+          if (aMIP.Contains(aIP1)) {
+            continue;
+          }
+          aMIP1.Add(aIP1);
+        }
+      }
+      //
+      if (!aMIP1.Extent()) {
+        break;
+      }
+      //
+      aIt1.Initialize(aMIP);
+      for(; aIt1.More(); aIt1.Next()) {
+        aMIPC.Add(aIt1.Key());
+      }
+      //
+      aMIP.Clear();
+      aIt1.Initialize(aMIP1);
+      for(; aIt1.More(); aIt1.Next()) {
+        aMIP.Add(aIt1.Key());
+      }
+      aMIP1.Clear();
+    }
+    //
+    TColStd_ListOfInteger& aLI=myChains(k);
+    if (!aMIPC.Extent()) {
+      aLI.Append(mySeeds(k)); // single point
+      return;
+    }
+    aIt1.Initialize(aMIPC);
+    for(; aIt1.More(); aIt1.Next()) {
+      aLI.Append(aIt1.Key());
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_PointClusterer& myClusterer;
+  const NCollection_Array1<Standard_Integer>& mySeeds;
+  NCollection_Array1<TColStd_ListOfInteger>& myChains;
+};
+
+//=======================================================================
+//function : GEOMAlgo_PointClusterer
+//purpose  :
+//=======================================================================
+GEOMAlgo_PointClusterer::GEOMAlgo_PointClusterer()
+:
+  myGap(0.),
+  myMetric(M_Sphere),
+  myRunParallel(Standard_False),
+  myNbTested(0)
+{
+  myOffsets.assign(1, 0);
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_PointClusterer::~GEOMAlgo_PointClusterer()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PointClusterer::Clear()
+{
+  myPoints.clear();
+  myRadii.clear();
+  myOffsets.assign(1, 0);
+  myNeighbours.clear();
+  myNbTested=0;
+}
+//=======================================================================
+//function : SetGap
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PointClusterer::SetGap(const Standard_Real theGap)
+{
+  myGap=theGap;
+}
+//=======================================================================
+//function : Gap
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_PointClusterer::Gap() const
+{
+  return myGap;
+}
+//=======================================================================
+//function : SetMetric
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PointClusterer::SetMetric(const Metric theMetric)
+{
+  myMetric=theMetric;
+}
+//=======================================================================
+//function : GetMetric
+//purpose  :
+//=======================================================================
+GEOMAlgo_PointClusterer::Metric GEOMAlgo_PointClusterer::GetMetric() const
+{
+  return myMetric;
+}
+//=======================================================================
+//function : SetRunParallel
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PointClusterer::SetRunParallel(const Standard_Boolean theFlag)
+{
+  myRunParallel=theFlag;
+}
+//=======================================================================
+//function : RunParallel
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_PointClusterer::RunParallel() const
+{
+  return myRunParallel;
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_PointClusterer::Add(const gp_Pnt& thePnt,
+                                              const Standard_Real theRadius)
+{
+  myPoints.push_back(thePnt);
+  myRadii.push_back(theRadius);
+  return (Standard_Integer)myPoints.size();
+}
+//=======================================================================
+//function : NbPoints
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_PointClusterer::NbPoints() const
+{
+  return (Standard_Integer)myPoints.size();
+}
+//=======================================================================
+//function : NbTested
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_PointClusterer::NbTested() const
+{
+  return myNbTested;
+}
+//=======================================================================
+//function : NbPairs
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_PointClusterer::NbPairs() const
+{
+  return myNeighbours.size();
+}
+//=======================================================================
+//function : Reach
+//purpose  : the distance of the point to the bound of its zone
+//=======================================================================
+Standard_Real GEOMAlgo_PointClusterer::Reach
+  (const Standard_Integer theIndex) const
+{
+  const Standard_Real aR=myRadii[theIndex-1];
+  //
+  if (myMetric==M_Box) {
+    // the gap of Bnd_Box is enlarged up to the tolerance
+    return (aR>myGap) ? aR : myGap;
+  }
+  return aR+myGap;
+}
+//=======================================================================
+//function : IsNeighbour
+//purpose  : The test is made from the lesser point, so the relation
+//           is symmetric. The sums are evaluated in the order of
+//           GEOMAlgo_BndSphere::IsOut() and Bnd_Box::IsOut().
+//=======================================================================
+Standard_Boolean GEOMAlgo_PointClusterer::IsNeighbour
+  (const Standard_Integer theI,
+   const Standard_Integer theJ) const
+{
+  Standard_Integer i, j;
+  Standard_Real aT, aD2;
+  //
+  i=(theI<theJ) ? theI : theJ;
+  j=(theI<theJ) ? theJ : theI;
+  //
+  const gp_Pnt& aP1=myPoints[i-1];
+  const gp_Pnt& aP2=myPoints[j-1];
+  //
+  if (myMetric==M_Box) {
+    aT=Reach(j)+Reach(i);
+    return !(aP1.X()-aP2.X()>aT || aP2.X()-aP1.X()>aT ||
+             aP1.Y()-aP2.Y()>aT || aP2.Y()-aP1.Y()>aT ||
+             aP1.Z()-aP2.Z()>aT || aP2.Z()-aP1.Z()>aT);
+  }
+  //
+  aD2=aP1.SquareDistance(aP2);
+  aT=myRadii[i-1]+myGap+myRadii[j-1]+myGap;
+  return !(aD2>aT*aT);
+}
+//=======================================================================
+//function : Perform
+//purpose  : The points are bucketed by the reach into the levels, so
+//           that a few points of a large tolerance do not enlarge the
+//           cells of all the others. The pair of the points of the
+//           levels L1<L2 is found by the point of L1 in the grid of
+//           L2, then it is added to the neighbours of the other point.
+//=======================================================================
+void GEOMAlgo_PointClusterer::Perform()
+{
+  Standard_Integer i, j, k, aNbP, aNbL, aL, aNbX;
+  Standard_Real aR, aR0, aRL, aH, aMax[3], aX;
+  GEOMAlgo_PointGrid aGrid;
+  //
+  myOffsets.assign(1, 0);
+  myNeighbours.clear();
+  myNbTested=0;
+  //
+  aNbP=NbPoints();
+  if (!aNbP) {
+    return;
+  }
+  //
+  // 1. The reach and the bounds of the points
+  std::vector<Standard_Real> aReach(aNbP);
+  for (k=0; k<3; ++k) {
+    aGrid.Min[k]=RealLast();
+    aMax[k]=RealFirst();
+  }
+  for (i=1; i<=aNbP; ++i) {
+    aReach[i-1]=Reach(i);
+    for (k=0; k<3; ++k) {
+      aX=myPoints[i-1].Coord(k+1);
+      if (aX<aGrid.Min[k]) {
+        aGrid.Min[k]=aX;
+      }
+      if (aX>aMax[k]) {
+        aMax[k]=aX;
+      }
+    }
+  }
+  //
+  // 2. The levels: the points of the level #L have the reach up to
+  //    R0*2^L, R0 is the median reach
+  std::vector<Standard_Real> aSorted(aReach);
+  std::nth_element(aSorted.begin(), aSorted.begin()+aNbP/2, aSorted.end());
+  aR0=aSorted[aNbP/2];
+  if (aR0<=0.) {
+    for (i=0; i<aNbP; ++i) {
+      aR=aReach[i];
+      if (aR>0. && (aR0<=0. || aR<aR0)) {
+        aR0=aR;
+      }
+    }
+  }
+  //
+  std::vector<Standard_Integer> aRaw(aNbP+1, 0);
+  for (i=1; i<=aNbP; ++i) {
+    aR=aReach[i-1];
+    if (aR0>0. && aR>aR0) {
+      aRaw[i]=(Standard_Integer)std::ceil(std::log2(aR/aR0));
+    }
+  }
+  //
+  // the levels met only, in the ascending order
+  std::vector<Standard_Integer> aMet(aRaw.begin()+1, aRaw.end());
+  std::sort(aMet.begin(), aMet.end());
+  aMet.erase(std::unique(aMet.begin(), aMet.end()), aMet.end());
+  aNbL=(Standard_Integer)aMet.size();
+  //
+  std::vector<Standard_Real> aRMax(aNbL, 0.);
+  aGrid.Levels.assign(aNbP+1, 0);
+  for (i=1; i<=aNbP; ++i) {
+    aL=(Standard_Integer)(std::lower_bound(aMet.begin(), aMet.end(),
+                                           aRaw[i])-aMet.begin());
+    aGrid.Levels[i]=aL;
+    if (aReach[i-1]>aRMax[aL]) {
+      aRMax[aL]=aReach[i-1];
+    }
+  }
+  //
+  // 3. The size of the cells of the level: the greatest distance
+  //    between its point and a point of the same or a finer level,
+  //    so the neighbours are in the adjacent cells
+  aGrid.Sizes.resize(aNbL);
+  aRL=0.;
+  for (aL=0; aL<aNbL; ++aL) {
+    if (aRMax[aL]>aRL) {
+      aRL=aRMax[aL];
+    }
+    aH=2.*aRL*(1.+1.e-7);
+    for (k=0; k<3; ++k) {
+      // not more than 1.e9 cells along an axis
+      aX=1.e-9*(aMax[k]-aGrid.Min[k]);
+      if (aX>aH) {
+        aH=aX;
+      }
+    }
+    if (aH<=0.) {
+      aH=1.;
+    }
+    aGrid.Sizes[aL]=aH;
+  }
+  //
+  // 4. The cells, sorted
+  aGrid.Cells.resize(aNbP);
+  for (i=1; i<=aNbP; ++i) {
+    GEOMAlgo_PointCell& aC=aGrid.Cells[i-1];
+    aGrid.Cell(myPoints[i-1], aGrid.Levels[i], aC);
+    aC.Index=i;
+  }
+  std::sort(aGrid.Cells.begin(), aGrid.Cells.end());
+  //
+  // 5. The neighbours of the same or the coarser levels:
+  //    the numbers, then the indices
+  std::vector<Standard_Integer> aCounts(aNbP+1, 0);
+  std::vector<Standard_Size> aTested(aNbP+1, 0);
+  std::vector<Standard_Integer> aOffsets(aNbP+1, 0);
+  std::vector<Standard_Integer> aUpper;
+  {
+    GEOMAlgo_PointClustererFunctor aFunctor(*this, aGrid,
+                                            aCounts, aTested, NULL, NULL);
+    OSD_Parallel::For(1, aNbP+1, aFunctor, !myRunParallel);
+  }
+  //
+  for (i=1; i<=aNbP; ++i) {
+    aOffsets[i]=aOffsets[i-1]+aCounts[i];
+    myNbTested+=aTested[i];
+  }
+  aUpper.resize(aOffsets[aNbP]);
+  {
+    GEOMAlgo_PointClustererFunctor aFunctor(*this, aGrid,
+                                            aCounts, aTested,
+                                            &aOffsets, &aUpper);
+    OSD_Parallel::For(1, aNbP+1, aFunctor, !myRunParallel);
+  }
+  //
+  // 6. The pairs of the different levels are added to the points
+  //    of the coarser levels
+  aNbX=0;
+  for (i=1; i<=aNbP; ++i) {
+    for (k=aOffsets[i-1]; k<aOffsets[i]; ++k) {
+      j=aUpper[k];
+      if (aGrid.Levels[j]>aGrid.Levels[i]) {
+        ++aCounts[j];
+        ++aNbX;
+      }
+    }
+  }
+  if (!aNbX) {
+    myOffsets.swap(aOffsets);
+    myNeighbours.swap(aUpper);
+    return;
+  }
+  //
+  myOffsets.resize(aNbP+1);
+  for (i=1; i<=aNbP; ++i) {
+    myOffsets[i]=myOffsets[i-1]+aCounts[i];
+  }
+  myNeighbours.resize(myOffsets[aNbP]);
+  //
+  std::vector<Standard_Integer> aFill(myOffsets.begin(), myOffsets.end()-1);
+  for (i=1; i<=aNbP; ++i) {
+    for (k=aOffsets[i-1]; k<aOffsets[i]; ++k) {
+      myNeighbours[aFill[i-1]++]=aUpper[k];
+    }
+  }
+  for (i=1; i<=aNbP; ++i) {
+    for (k=aOffsets[i-1]; k<aOffsets[i]; ++k) {
+      j=aUpper[k];
+      if (aGrid.Levels[j]>aGrid.Levels[i]) {
+        myNeighbours[aFill[j-1]++]=i;
+      }
+    }
+  }
+  //
+  // the found neighbours and the added ones are sorted each
+  for (i=1; i<=aNbP; ++i) {
+    std::inplace_merge(myNeighbours.begin()+myOffsets[i-1],
+                       myNeighbours.begin()+myOffsets[i-1]+
+                         (aOffsets[i]-aOffsets[i-1]),
+                       myNeighbours.begin()+myOffsets[i]);
+  }
+}
+//=======================================================================
+//function : MakeChains
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PointClusterer::MakeChains
+  (NCollection_Vector<TColStd_ListOfInteger>& theChains,
+   const Standard_Boolean theWithSingles) const
+{
+  Standard_Integer i, k, aNbP, aNbSeeds;
+  //
+  theChains.Clear();
+  //
+  aNbP=(Standard_Integer)myOffsets.size()-1;
+  if (!aNbP) {
+    return;
+  }
+  //
+  // 1. Union-find; the root of a set is its least point
+  std::vector< std::atomic<Standard_Integer> > aParent(aNbP+1);
+  for (i=0; i<=aNbP; ++i) {
+    aParent[i].store(i);
+  }
+  GEOMAlgo_PointUnionFunctor aUnionFunctor(*this, aParent);
+  OSD_Parallel::For(1, aNbP+1, aUnionFunctor, !myRunParallel);
+  //
+  // 2. The seeds; a root without other neighbours is a single point
+  aNbSeeds=0;
+  for (i=1; i<=aNbP; ++i) {
+    if (aUnionFunctor.Find(i)==i &&
+        (theWithSingles || NbNeighbours(i)>1)) {
+      ++aNbSeeds;
+    }
+  }
+  if (!aNbSeeds) {
+    return;
+  }
+  //
+  NCollection_Array1<Standard_Integer> aSeeds(1, aNbSeeds);
+  NCollection_Array1<TColStd_ListOfInteger> aChains(1, aNbSeeds);
+  for (i=1, k=0; i<=aNbP; ++i) {
+    if (aUnionFunctor.Find(i)==i &&
+        (theWithSingles || NbNeighbours(i)>1)) {
+      aSeeds(++k)=i;
+    }
+  }
+  //
+  // 3. The chains
+  GEOMAlgo_PointChainFunctor aChainFunctor(*this, aSeeds, aChains);
+  OSD_Parallel::For(1, aNbSeeds+1, aChainFunctor, !myRunParallel);
+  //
+  for (k=1; k<=aNbSeeds; ++k) {
+    theChains.Append(aChains(k));
+  }
+}
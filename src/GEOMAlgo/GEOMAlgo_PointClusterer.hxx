@@ -0,0 +1,198 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_PointClusterer.hxx
+
+#ifndef _GEOMAlgo_PointClusterer_HeaderFile
+#define _GEOMAlgo_PointClusterer_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+
+#include <gp_Pnt.hxx>
+#include <NCollection_Vector.hxx>
+#include <TColStd_ListOfInteger.hxx>
+
+#include <vector>
+
+//=======================================================================
+/**
+ * Finds the coincident points, e.g. the coincident vertices of the
+ * gluing algorithms.
+ * Each point #i (1..NbPoints(), in the order of Add()) has the radius
+ * (the tolerance of the vertex); all the points have the same gap
+ * (the tolerance of the algorithm). Two points are the neighbours:
+ * - M_Sphere: if the distance between them is not greater than
+ *   Ri+Gap+Rj+Gap (as GEOMAlgo_BndSphere);
+ * - M_Box   : if each coordinate differs by not more than
+ *   Max(Ri,Gap)+Max(Rj,Gap) (as the Bnd_Box of a vertex).
+ * The neighbours are found by the hash grids of the levels: the points
+ * are bucketed by the reach (R0*2^L for the level L, R0 is the median
+ * reach), the cells of a level have the size of the greatest distance
+ * between its point and a point of the same or a finer level. A point
+ * tests the 27 cells around it in the grid of its level and of each
+ * coarser level, so a few points of a large tolerance do not make the
+ * cells of all the points large. The neighbours of each point are
+ * sorted; a point is the neighbour of itself.
+ */
+//=======================================================================
+//class    : GEOMAlgo_PointClusterer
+//purpose  :
+//=======================================================================
+class GEOMAlgo_PointClusterer
+{
+ public:
+  /**
+   * The test of the neighbours.
+   */
+  enum Metric {
+    M_Sphere,
+    M_Box
+  };
+
+  /**
+   * Constructor.
+   */
+  Standard_EXPORT
+    GEOMAlgo_PointClusterer();
+
+  /**
+   * Destructor.
+   */
+  Standard_EXPORT
+    virtual ~GEOMAlgo_PointClusterer();
+
+  /**
+   * Clears the points and the results.
+   */
+  Standard_EXPORT
+    void Clear();
+
+  /**
+   * Sets the gap, common for all the points.
+   */
+  Standard_EXPORT
+    void SetGap(const Standard_Real theGap);
+
+  Standard_EXPORT
+    Standard_Real Gap() const;
+
+  /**
+   * Sets the test of the neighbours (M_Sphere by default).
+   */
+  Standard_EXPORT
+    void SetMetric(const Metric theMetric);
+
+  Standard_EXPORT
+    Metric GetMetric() const;
+
+  /**
+   * Sets the flag of the parallel processing.
+   */
+  Standard_EXPORT
+    void SetRunParallel(const Standard_Boolean theFlag);
+
+  Standard_EXPORT
+    Standard_Boolean RunParallel() const;
+
+  /**
+   * Adds the point thePnt of the radius theRadius.
+   * Returns the index of the point.
+   */
+  Standard_EXPORT
+    Standard_Integer Add(const gp_Pnt& thePnt,
+                         const Standard_Real theRadius);
+
+  Standard_EXPORT
+    Standard_Integer NbPoints() const;
+
+  /**
+   * Finds the neighbours of all the points.
+   */
+  Standard_EXPORT
+    void Perform();
+
+  /**
+   * Returns the number of the neighbours of the point theIndex.
+   */
+  Standard_Integer NbNeighbours(const Standard_Integer theIndex) const
+  {
+    return myOffsets[theIndex]-myOffsets[theIndex-1];
+  }
+
+  /**
+   * Returns the neighbour #theK (1..NbNeighbours()) of the point
+   * theIndex.
+   */
+  Standard_Integer Neighbour(const Standard_Integer theIndex,
+                             const Standard_Integer theK) const
+  {
+    return myNeighbours[myOffsets[theIndex-1]+theK-1];
+  }
+
+  /**
+   * Returns the number of the pairs of the points tested.
+   */
+  Standard_EXPORT
+    Standard_Size NbTested() const;
+
+  /**
+   * Returns the number of the pairs of the neighbours.
+   */
+  Standard_EXPORT
+    Standard_Size NbPairs() const;
+
+  /**
+   * Builds the chains of the points coincident by transitivity.
+   * The chains are in the order of their least points. The points
+   * of a chain are collected by the growth of the neighbourhood of
+   * the least point, the order does not depend on the threads.
+   * A point without other neighbours makes a chain of itself
+   * if theWithSingles is true.
+   */
+  Standard_EXPORT
+    void MakeChains(NCollection_Vector<TColStd_ListOfInteger>& theChains,
+                    const Standard_Boolean theWithSingles) const;
+
+ protected:
+  Standard_Real Reach(const Standard_Integer theIndex) const;
+
+  Standard_Boolean IsNeighbour(const Standard_Integer theI,
+                               const Standard_Integer theJ) const;
+
+ protected:
+  Standard_Real myGap;
+  Metric myMetric;
+  Standard_Boolean myRunParallel;
+  std::vector<gp_Pnt> myPoints;
+  std::vector<Standard_Real> myRadii;
+  std::vector<Standard_Integer> myOffsets;
+  std::vector<Standard_Integer> myNeighbours;
+  Standard_Size myNbTested;
+
+  friend class GEOMAlgo_PointClustererFunctor;
+};
+
+#endif
@@ -0,0 +1,274 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_Profile.cxx
+
+#include <GEOMAlgo_Profile.hxx>
+
+//=======================================================================
+//function : JSONString
+//purpose  : writes the string quoted and escaped
+//=======================================================================
+static
+  void JSONString(const TCollection_AsciiString& theS,
+                  Standard_OStream& theOS)
+{
+  Standard_Integer i, aNb;
+  Standard_Character aC;
+  //
+  theOS << '"';
+  aNb=theS.Length();
+  for (i=1; i<=aNb; ++i) {
+    aC=theS.Value(i);
+    if (aC=='"' || aC=='\\') {
+      theOS << '\\';
+    }
+    theOS << aC;
+  }
+  theOS << '"';
+}
+//=======================================================================
+//function : GEOMAlgo_Profile
+//purpose  :
+//=======================================================================
+GEOMAlgo_Profile::GEOMAlgo_Profile()
+:
+  myIsEnabled(Standard_False)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_Profile::~GEOMAlgo_Profile()
+{
+}
+//=======================================================================
+//function : SetEnabled
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::SetEnabled(const Standard_Boolean theFlag)
+{
+  myIsEnabled=theFlag;
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::Clear()
+{
+  myTimes.Clear();
+  myCalls.Clear();
+  myCounters.Clear();
+}
+//=======================================================================
+//function : AddTime
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::AddTime(const Standard_CString theStage,
+                               const Standard_Real theTime)
+{
+  Standard_Integer aIndex;
+  //
+  if (!myIsEnabled) {
+    return;
+  }
+  //
+  TCollection_AsciiString aName(theStage);
+  aIndex=myTimes.FindIndex(aName);
+  if (!aIndex) {
+    myTimes.Add(aName, 0.);
+    aIndex=myCalls.Add(aName, 0);
+  }
+  myTimes.ChangeFromIndex(aIndex)+=theTime;
+  ++myCalls.ChangeFromIndex(aIndex);
+}
+//=======================================================================
+//function : AddCount
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::AddCount(const Standard_CString theCounter,
+                                const Standard_Size theValue)
+{
+  Standard_Integer aIndex;
+  //
+  if (!myIsEnabled) {
+    return;
+  }
+  //
+  TCollection_AsciiString aName(theCounter);
+  aIndex=myCounters.FindIndex(aName);
+  if (!aIndex) {
+    aIndex=myCounters.Add(aName, 0);
+  }
+  myCounters.ChangeFromIndex(aIndex)+=theValue;
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::Add(const GEOMAlgo_Profile& theProfile,
+                           const Standard_CString thePrefix)
+{
+  Standard_Integer i, aNb, aIndex;
+  //
+  if (!myIsEnabled) {
+    return;
+  }
+  //
+  aNb=theProfile.NbStages();
+  for (i=1; i<=aNb; ++i) {
+    TCollection_AsciiString aName(thePrefix);
+    aName+=theProfile.StageName(i);
+    //
+    aIndex=myTimes.FindIndex(aName);
+    if (!aIndex) {
+      myTimes.Add(aName, 0.);
+      aIndex=myCalls.Add(aName, 0);
+    }
+    myTimes.ChangeFromIndex(aIndex)+=theProfile.StageTime(i);
+    myCalls.ChangeFromIndex(aIndex)+=theProfile.StageCalls(i);
+  }
+  //
+  aNb=theProfile.NbCounters();
+  for (i=1; i<=aNb; ++i) {
+    TCollection_AsciiString aName(thePrefix);
+    aName+=theProfile.CounterName(i);
+    //
+    aIndex=myCounters.FindIndex(aName);
+    if (!aIndex) {
+      aIndex=myCounters.Add(aName, 0);
+    }
+    myCounters.ChangeFromIndex(aIndex)+=theProfile.CounterValue(i);
+  }
+}
+//=======================================================================
+//function : NbStages
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_Profile::NbStages() const
+{
+  return myTimes.Extent();
+}
+//=======================================================================
+//function : StageName
+//purpose  :
+//=======================================================================
+const TCollection_AsciiString& GEOMAlgo_Profile::StageName
+  (const Standard_Integer theIndex) const
+{
+  return myTimes.FindKey(theIndex);
+}
+//=======================================================================
+//function : StageTime
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_Profile::StageTime
+  (const Standard_Integer theIndex) const
+{
+  return myTimes.FindFromIndex(theIndex);
+}
+//=======================================================================
+//function : StageCalls
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_Profile::StageCalls
+  (const Standard_Integer theIndex) const
+{
+  return myCalls.FindFromIndex(theIndex);
+}
+//=======================================================================
+//function : Time
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_Profile::Time(const Standard_CString theStage) const
+{
+  const Standard_Real* pTime=myTimes.Seek(TCollection_AsciiString(theStage));
+  return pTime ? *pTime : 0.;
+}
+//=======================================================================
+//function : NbCounters
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_Profile::NbCounters() const
+{
+  return myCounters.Extent();
+}
+//=======================================================================
+//function : CounterName
+//purpose  :
+//=======================================================================
+const TCollection_AsciiString& GEOMAlgo_Profile::CounterName
+  (const Standard_Integer theIndex) const
+{
+  return myCounters.FindKey(theIndex);
+}
+//=======================================================================
+//function : CounterValue
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_Profile::CounterValue
+  (const Standard_Integer theIndex) const
+{
+  return myCounters.FindFromIndex(theIndex);
+}
+//=======================================================================
+//function : Count
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_Profile::Count
+  (const Standard_CString theCounter) const
+{
+  const Standard_Size* pValue=
+    myCounters.Seek(TCollection_AsciiString(theCounter));
+  return pValue ? *pValue : 0;
+}
+//=======================================================================
+//function : DumpJSON
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Profile::DumpJSON(Standard_OStream& theOS) const
+{
+  Standard_Integer i, aNb;
+  //
+  theOS << "{\"stages\": [";
+  aNb=NbStages();
+  for (i=1; i<=aNb; ++i) {
+    if (i>1) {
+      theOS << ", ";
+    }
+    theOS << "{\"name\": ";
+    JSONString(StageName(i), theOS);
+    theOS << ", \"time\": " << StageTime(i);
+    theOS << ", \"calls\": " << StageCalls(i) << "}";
+  }
+  theOS << "], \"counters\": {";
+  aNb=NbCounters();
+  for (i=1; i<=aNb; ++i) {
+    if (i>1) {
+      theOS << ", ";
+    }
+    JSONString(CounterName(i), theOS);
+    theOS << ": " << CounterValue(i);
+  }
+  theOS << "}}";
+}
@@ -0,0 +1,170 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_Profile.hxx
+
+#ifndef _GEOMAlgo_Profile_HeaderFile
+#define _GEOMAlgo_Profile_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_OStream.hxx>
+
+#include <TCollection_AsciiString.hxx>
+#include <NCollection_IndexedDataMap.hxx>
+#include <OSD_Timer.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_Profile
+//purpose  : The wall times of the stages and the counters of
+//           an algorithm (see GEOMAlgo_Algo::SetProfiling()).
+//           The stages and the counters are kept in the order
+//           they are met first.
+//           It is filled by the thread running the algorithm only,
+//           the counters of the parallel tasks are summed up after
+//           the tasks are done.
+//=======================================================================
+class GEOMAlgo_Profile
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_Profile();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_Profile();
+
+  //! Enables or disables the profiling. <br>
+  //!          If it is disabled (default), AddTime() and AddCount()
+  //!          do nothing. <br>
+  Standard_EXPORT
+    void SetEnabled(const Standard_Boolean theFlag) ;
+
+  Standard_Boolean IsEnabled() const
+  {
+    return myIsEnabled;
+  }
+
+  //! Clears the stages and the counters. <br>
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Adds the time theTime (in seconds) of one call of the stage. <br>
+  Standard_EXPORT
+    void AddTime(const Standard_CString theStage,
+                 const Standard_Real theTime) ;
+
+  //! Adds theValue to the counter. <br>
+  //!          The counters are 64-bit (on 64-bit platforms), the
+  //!          numbers of the pairs of large models do not fit into
+  //!          Standard_Integer. <br>
+  Standard_EXPORT
+    void AddCount(const Standard_CString theCounter,
+                  const Standard_Size theValue) ;
+
+  //! Adds the stages and the counters of theProfile with the
+  //!          names prefixed by thePrefix (e.g. the profile of the
+  //!          sub-algorithm). <br>
+  Standard_EXPORT
+    void Add(const GEOMAlgo_Profile& theProfile,
+             const Standard_CString thePrefix) ;
+
+  Standard_EXPORT
+    Standard_Integer NbStages() const;
+
+  Standard_EXPORT
+    const TCollection_AsciiString& StageName(const Standard_Integer theIndex) const;
+
+  //! Returns the total time (in seconds) of the stage. <br>
+  Standard_EXPORT
+    Standard_Real StageTime(const Standard_Integer theIndex) const;
+
+  //! Returns the number of calls of the stage. <br>
+  Standard_EXPORT
+    Standard_Integer StageCalls(const Standard_Integer theIndex) const;
+
+  //! Returns the total time of the stage or 0. if it is not met. <br>
+  Standard_EXPORT
+    Standard_Real Time(const Standard_CString theStage) const;
+
+  Standard_EXPORT
+    Standard_Integer NbCounters() const;
+
+  Standard_EXPORT
+    const TCollection_AsciiString& CounterName(const Standard_Integer theIndex) const;
+
+  Standard_EXPORT
+    Standard_Size CounterValue(const Standard_Integer theIndex) const;
+
+  //! Returns the value of the counter or 0 if it is not met. <br>
+  Standard_EXPORT
+    Standard_Size Count(const Standard_CString theCounter) const;
+
+  //! Writes the profile as JSON object: <br>
+  //!   {"stages": [{"name": ..., "time": ..., "calls": ...}, ...], <br>
+  //!    "counters": {name: value, ...}} <br>
+  Standard_EXPORT
+    void DumpJSON(Standard_OStream& theOS) const;
+
+ protected:
+  Standard_Boolean myIsEnabled;
+  NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Real> myTimes;
+  NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Integer> myCalls;
+  NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Size> myCounters;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_ProfileStage
+//purpose  : Adds the wall time of the scope to the stage of the
+//           profile, if the profile is enabled
+//=======================================================================
+class GEOMAlgo_ProfileStage
+{
+ public:
+  GEOMAlgo_ProfileStage(GEOMAlgo_Profile& theProfile,
+                        const Standard_CString theStage)
+  :
+    myProfile(theProfile.IsEnabled() ? &theProfile : NULL),
+    myStage(theStage)
+  {
+    if (myProfile) {
+      myTimer.Start();
+    }
+  }
+  //
+  ~GEOMAlgo_ProfileStage()
+  {
+    if (myProfile) {
+      myTimer.Stop();
+      myProfile->AddTime(myStage, myTimer.ElapsedTime());
+    }
+  }
+  //
+ protected:
+  GEOMAlgo_Profile* myProfile;
+  Standard_CString myStage;
+  OSD_Timer myTimer;
+};
+
+#endif
@@ -0,0 +1,768 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoCache.cxx
+
+#include <GEOMAlgo_ShapeInfoCache.hxx>
+
+#include <GEOMAlgo_ShapeInfoTable.hxx>
+
+#include <gp_Pnt.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepTools.hxx>
+#include <Geom_Curve.hxx>
+#include <Geom_Surface.hxx>
+#include <GeomAdaptor_Curve.hxx>
+#include <GeomAdaptor_Surface.hxx>
+#include <OSD_OpenFile.hxx>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// File layout:
+//  header  : THE_HEADER_SIZE bytes, see CheckHeader()
+//  index   : per record, sorted by key
+//            key (uint64), offset (uint64), size (uint32), checksum (uint32)
+//  records : per record
+//            type, kind of shape (int32),
+//            lower bound and length of poles, knots, weights and
+//            multiplicities (int32, length -1 for no array),
+//            RF_NbFields values (double), IF_NbFields values (int32),
+//            the arrays (3 doubles per pole)
+static const char THE_MAGIC[8]={'G','E','O','M','S','I','C','1'};
+static const uint32_t THE_VERSION=1;
+static const uint32_t THE_BYTE_ORDER=0x01020304;
+static const Standard_Size THE_HEADER_SIZE=56;
+static const Standard_Size THE_INDEX_ITEM_SIZE=24;
+
+static
+  void HashBytes(uint64_t& aH,
+                 const void* pV,
+                 const Standard_Size aNb);
+static
+  void HashInteger(uint64_t& aH,
+                   const Standard_Integer aI);
+static
+  void HashReal(uint64_t& aH,
+                const Standard_Real aX);
+static
+  void HashPnt(uint64_t& aH,
+               const gp_Pnt& aP);
+static
+  uint32_t Checksum(const char* pV,
+                    const Standard_Size aNb);
+static
+  void WriteInfo(const GEOMAlgo_ShapeInfo& aInfo,
+                 std::vector<char>& aBuf);
+static
+  Standard_Boolean ReadInfo(const char* pV,
+                            const Standard_Size aNb,
+                            GEOMAlgo_ShapeInfo& aInfo);
+
+//=======================================================================
+//function : Put
+//purpose  :
+//=======================================================================
+template <class TheValue>
+static void Put(std::vector<char>& theBuf,
+                const TheValue& theValue)
+{
+  const char* pV=(const char*)&theValue;
+  theBuf.insert(theBuf.end(), pV, pV+sizeof(TheValue));
+}
+//=======================================================================
+//function : Get
+//purpose  : reads theValue at theP and moves theP if [theP, theEnd)
+//           is large enough
+//=======================================================================
+template <class TheValue>
+static Standard_Boolean Get(const char*& theP,
+                            const char* theEnd,
+                            TheValue& theValue)
+{
+  if (theEnd-theP<(std::ptrdiff_t)sizeof(TheValue)) {
+    return Standard_False;
+  }
+  memcpy(&theValue, theP, sizeof(TheValue));
+  theP+=sizeof(TheValue);
+  return Standard_True;
+}
+
+//=======================================================================
+//function :
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoCache::GEOMAlgo_ShapeInfoCache()
+:
+  myData(NULL),
+  mySize(0),
+  myNbRecords(0),
+  myTolerance(0.),
+  myRootKey(0),
+  myIndex(NULL),
+  myRecords(NULL),
+  myRecordsSize(0)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoCache::~GEOMAlgo_ShapeInfoCache()
+{
+  Close();
+}
+//=======================================================================
+//function : Open
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::Open
+  (const TCollection_AsciiString& theFile)
+{
+  Close();
+  //
+#ifdef WIN32
+  HANDLE aHFile, aHMap;
+  LARGE_INTEGER aSize;
+  LPVOID pView;
+  //
+  aHFile=CreateFileA(theFile.ToCString(), GENERIC_READ, FILE_SHARE_READ,
+                     NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (aHFile==INVALID_HANDLE_VALUE) {
+    return Standard_False;
+  }
+  if (!GetFileSizeEx(aHFile, &aSize) ||
+      aSize.QuadPart<(LONGLONG)THE_HEADER_SIZE) {
+    CloseHandle(aHFile);
+    return Standard_False;
+  }
+  aHMap=CreateFileMappingA(aHFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(aHFile);
+  if (aHMap==NULL) {
+    return Standard_False;
+  }
+  // the view keeps the mapping
+  pView=MapViewOfFile(aHMap, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(aHMap);
+  if (pView==NULL) {
+    return Standard_False;
+  }
+  myData=(const char*)pView;
+  mySize=(Standard_Size)aSize.QuadPart;
+#else
+  int aFd;
+  struct stat aStat;
+  void* pView;
+  //
+  aFd=open(theFile.ToCString(), O_RDONLY);
+  if (aFd<0) {
+    return Standard_False;
+  }
+  if (fstat(aFd, &aStat) ||
+      aStat.st_size<(off_t)THE_HEADER_SIZE) {
+    close(aFd);
+    return Standard_False;
+  }
+  pView=mmap(NULL, (size_t)aStat.st_size, PROT_READ, MAP_PRIVATE, aFd, 0);
+  close(aFd);
+  if (pView==MAP_FAILED) {
+    return Standard_False;
+  }
+  myData=(const char*)pView;
+  mySize=(Standard_Size)aStat.st_size;
+#endif
+  //
+  if (!CheckHeader()) {
+    Close();
+    return Standard_False;
+  }
+  return Standard_True;
+}
+//=======================================================================
+//function : Close
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoCache::Close()
+{
+  if (myData) {
+#ifdef WIN32
+    UnmapViewOfFile((LPCVOID)myData);
+#else
+    munmap((void*)myData, mySize);
+#endif
+  }
+  myData=NULL;
+  mySize=0;
+  myNbRecords=0;
+  myTolerance=0.;
+  myRootKey=0;
+  myIndex=NULL;
+  myRecords=NULL;
+  myRecordsSize=0;
+  myChecked.clear();
+}
+//=======================================================================
+//function : CheckHeader
+//purpose  : magic (8 chars), version, byte order, root key,
+//           tolerance, nb of records, nb of real and integer fields,
+//           padding, size of the records
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::CheckHeader()
+{
+  uint32_t aVersion, aByteOrder, aNbRecords, aNbR, aNbI, aPad;
+  uint64_t aRecordsSize;
+  Standard_Size aSizeIndex;
+  const char* pV;
+  const char* pEnd;
+  //
+  pV=myData;
+  pEnd=myData+THE_HEADER_SIZE;
+  if (memcmp(pV, THE_MAGIC, sizeof(THE_MAGIC))) {
+    return Standard_False;
+  }
+  pV+=sizeof(THE_MAGIC);
+  //
+  Get(pV, pEnd, aVersion);
+  Get(pV, pEnd, aByteOrder);
+  Get(pV, pEnd, myRootKey);
+  Get(pV, pEnd, myTolerance);
+  Get(pV, pEnd, aNbRecords);
+  Get(pV, pEnd, aNbR);
+  Get(pV, pEnd, aNbI);
+  Get(pV, pEnd, aPad);
+  Get(pV, pEnd, aRecordsSize);
+  //
+  if (aVersion!=THE_VERSION ||
+      aByteOrder!=THE_BYTE_ORDER ||
+      aNbR!=(uint32_t)GEOMAlgo_ShapeInfoTable::RF_NbFields ||
+      aNbI!=(uint32_t)GEOMAlgo_ShapeInfoTable::IF_NbFields) {
+    return Standard_False;
+  }
+  //
+  aSizeIndex=(Standard_Size)aNbRecords*THE_INDEX_ITEM_SIZE;
+  if (aSizeIndex>mySize-THE_HEADER_SIZE ||
+      aRecordsSize>mySize-THE_HEADER_SIZE-aSizeIndex) {
+    return Standard_False;
+  }
+  //
+  myNbRecords=(Standard_Integer)aNbRecords;
+  myIndex=myData+THE_HEADER_SIZE;
+  myRecords=myIndex+aSizeIndex;
+  myRecordsSize=(Standard_Size)aRecordsSize;
+  std::vector< std::atomic<unsigned char> > aChecked(myNbRecords);
+  myChecked.swap(aChecked);
+  return Standard_True;
+}
+//=======================================================================
+//function : Tolerance
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoCache::Tolerance() const
+{
+  return myTolerance;
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoCache::Extent() const
+{
+  return myNbRecords;
+}
+//=======================================================================
+//function : IsCacheOf
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::IsCacheOf
+  (const TopoDS_Shape& theShape) const
+{
+  GEOMAlgo_DataMapOfShapeFingerprint aMKeys;
+  //
+  if (!IsOpen() || theShape.IsNull()) {
+    return Standard_False;
+  }
+  return (Fingerprint(theShape, aMKeys)==myRootKey);
+}
+//=======================================================================
+//function : RecordKey
+//purpose  :
+//=======================================================================
+uint64_t GEOMAlgo_ShapeInfoCache::RecordKey
+  (const Standard_Integer theIndex) const
+{
+  uint64_t aKey;
+  //
+  memcpy(&aKey, myIndex+theIndex*THE_INDEX_ITEM_SIZE, sizeof(aKey));
+  return aKey;
+}
+//=======================================================================
+//function : CheckRecord
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::CheckRecord
+  (const Standard_Integer theIndex) const
+{
+  unsigned char aState;
+  uint64_t aOffset;
+  uint32_t aSize, aChecksum;
+  const char* pV;
+  const char* pEnd;
+  //
+  // the concurrent checks of the record store the same state
+  aState=myChecked[theIndex].load(std::memory_order_relaxed);
+  if (!aState) {
+    pV=myIndex+theIndex*THE_INDEX_ITEM_SIZE+sizeof(uint64_t);
+    pEnd=pV+THE_INDEX_ITEM_SIZE;
+    Get(pV, pEnd, aOffset);
+    Get(pV, pEnd, aSize);
+    Get(pV, pEnd, aChecksum);
+    //
+    aState=2;
+    if (aOffset<=myRecordsSize && aSize<=myRecordsSize-aOffset) {
+      if (Checksum(myRecords+aOffset, aSize)==aChecksum) {
+        aState=1;
+      }
+    }
+    myChecked[theIndex].store(aState, std::memory_order_relaxed);
+  }
+  return (aState==1);
+}
+//=======================================================================
+//function : Find
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::Find
+  (const TopoDS_Shape& theS,
+   GEOMAlgo_ShapeInfo& theInfo) const
+{
+  GEOMAlgo_DataMapOfShapeFingerprint aMKeys;
+  //
+  if (!IsOpen() || theS.IsNull()) {
+    return Standard_False;
+  }
+  return Find(Fingerprint(theS, aMKeys), theInfo);
+}
+//=======================================================================
+//function : Find
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::Find
+  (const uint64_t theKey,
+   GEOMAlgo_ShapeInfo& theInfo) const
+{
+  Standard_Integer i1, i2, i;
+  uint64_t aKey, aOffset;
+  uint32_t aSize;
+  const char* pV;
+  //
+  i1=0;
+  i2=myNbRecords;
+  while (i1<i2) {
+    i=(i1+i2)/2;
+    if (RecordKey(i)<theKey) {
+      i1=i+1;
+    }
+    else {
+      i2=i;
+    }
+  }
+  if (i1==myNbRecords) {
+    return Standard_False;
+  }
+  aKey=RecordKey(i1);
+  if (aKey!=theKey || !CheckRecord(i1)) {
+    return Standard_False;
+  }
+  //
+  pV=myIndex+i1*THE_INDEX_ITEM_SIZE+sizeof(uint64_t);
+  memcpy(&aOffset, pV, sizeof(aOffset));
+  memcpy(&aSize, pV+sizeof(aOffset), sizeof(aSize));
+  //
+  return ReadInfo(myRecords+aOffset, aSize, theInfo);
+}
+//=======================================================================
+//function : Write
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoCache::Write
+  (const TCollection_AsciiString& theFile,
+   const TopoDS_Shape& theShape,
+   const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& theMSI,
+   const Standard_Real theTol)
+{
+  Standard_Integer i, j, k, aNb;
+  uint32_t aU32;
+  uint64_t aKey, aOffset;
+  Standard_Boolean bSame;
+  GEOMAlgo_DataMapOfShapeFingerprint aMKeys;
+  std::vector<std::pair<uint64_t, Standard_Integer> > aVKI;
+  std::vector<std::vector<char> > aVBuf;
+  std::vector<char> aIndex, aRecords, aHeader;
+  //
+  if (theShape.IsNull()) {
+    return Standard_False;
+  }
+  //
+  aNb=theMSI.Extent();
+  aVKI.reserve(aNb);
+  aVBuf.resize(aNb);
+  for (i=1; i<=aNb; ++i) {
+    aKey=Fingerprint(theMSI.FindKey(i), aMKeys);
+    aVKI.push_back(std::make_pair(aKey, i-1));
+    WriteInfo(theMSI(i), aVBuf[i-1]);
+  }
+  std::sort(aVKI.begin(), aVKI.end());
+  //
+  // the records of a key with different infos are not written
+  for (i=0; i<aNb; i=j) {
+    bSame=Standard_True;
+    const std::vector<char>& aBuf=aVBuf[aVKI[i].second];
+    for (j=i+1; j<aNb && aVKI[j].first==aVKI[i].first; ++j) {
+      bSame=bSame && (aVBuf[aVKI[j].second]==aBuf);
+    }
+    if (!bSame) {
+      continue;
+    }
+    //
+    aOffset=(uint64_t)aRecords.size();
+    Put(aIndex, aVKI[i].first);
+    Put(aIndex, aOffset);
+    Put(aIndex, (uint32_t)aBuf.size());
+    Put(aIndex, Checksum(aBuf.empty() ? NULL : &aBuf[0], aBuf.size()));
+    aRecords.insert(aRecords.end(), aBuf.begin(), aBuf.end());
+  }
+  //
+  aHeader.insert(aHeader.end(), THE_MAGIC, THE_MAGIC+sizeof(THE_MAGIC));
+  Put(aHeader, THE_VERSION);
+  Put(aHeader, THE_BYTE_ORDER);
+  Put(aHeader, Fingerprint(theShape, aMKeys));
+  Put(aHeader, theTol);
+  k=(Standard_Integer)(aIndex.size()/THE_INDEX_ITEM_SIZE);
+  Put(aHeader, (uint32_t)k);
+  Put(aHeader, (uint32_t)GEOMAlgo_ShapeInfoTable::RF_NbFields);
+  Put(aHeader, (uint32_t)GEOMAlgo_ShapeInfoTable::IF_NbFields);
+  aU32=0;
+  Put(aHeader, aU32);
+  Put(aHeader, (uint64_t)aRecords.size());
+  //
+  std::ofstream aStream;
+  OSD_OpenStream(aStream, theFile.ToCString(),
+                 std::ios::out|std::ios::binary|std::ios::trunc);
+  if (!aStream.is_open()) {
+    return Standard_False;
+  }
+  aStream.write(&aHeader[0], aHeader.size());
+  if (!aIndex.empty()) {
+    aStream.write(&aIndex[0], aIndex.size());
+    aStream.write(&aRecords[0], aRecords.size());
+  }
+  aStream.close();
+  return !aStream.fail();
+}
+//=======================================================================
+//function : Fingerprint
+//purpose  : the fingerprint of the shape with FORWARD orientation is
+//           kept in theMKeys, the orientation is added to it
+//=======================================================================
+uint64_t GEOMAlgo_ShapeInfoCache::Fingerprint
+  (const TopoDS_Shape& theS,
+   GEOMAlgo_DataMapOfShapeFingerprint& theMKeys)
+{
+  Standard_Real aT1, aT2, aU1, aU2, aV1, aV2;
+  TopAbs_ShapeEnum aType;
+  TopLoc_Location aLoc;
+  TopoDS_Iterator aIt;
+  uint64_t aH;
+  //
+  TopoDS_Shape aSF=theS.Oriented(TopAbs_FORWARD);
+  //
+  if (!theMKeys.IsBound(aSF)) {
+    aType=aSF.ShapeType();
+    aH=14695981039346656037ULL;
+    HashInteger(aH, (Standard_Integer)aType);
+    //
+    if (aType==TopAbs_VERTEX) {
+      HashPnt(aH, BRep_Tool::Pnt(TopoDS::Vertex(aSF)));
+    }
+    else if (aType==TopAbs_EDGE) {
+      const TopoDS_Edge& aE=TopoDS::Edge(aSF);
+      HashInteger(aH, BRep_Tool::Degenerated(aE) ? 1 : 0);
+      Handle(Geom_Curve) aC3D=BRep_Tool::Curve(aE, aLoc, aT1, aT2);
+      if (!aC3D.IsNull()) {
+        const gp_Trsf& aTrsf=aLoc.Transformation();
+        HashInteger(aH, (Standard_Integer)GeomAdaptor_Curve(aC3D).GetType());
+        HashReal(aH, aT1);
+        HashReal(aH, aT2);
+        HashPnt(aH, aC3D->Value(aT1).Transformed(aTrsf));
+        HashPnt(aH, aC3D->Value(0.5*(aT1+aT2)).Transformed(aTrsf));
+        HashPnt(aH, aC3D->Value(aT2).Transformed(aTrsf));
+      }
+    }
+    else if (aType==TopAbs_FACE) {
+      const TopoDS_Face& aF=TopoDS::Face(aSF);
+      Handle(Geom_Surface) aSurf=BRep_Tool::Surface(aF, aLoc);
+      if (!aSurf.IsNull()) {
+        BRepTools::UVBounds(aF, aU1, aU2, aV1, aV2);
+        HashInteger(aH, (Standard_Integer)GeomAdaptor_Surface(aSurf).GetType());
+        HashReal(aH, aU1);
+        HashReal(aH, aU2);
+        HashReal(aH, aV1);
+        HashReal(aH, aV2);
+        HashPnt(aH, aSurf->Value(0.5*(aU1+aU2), 0.5*(aV1+aV2)).
+                Transformed(aLoc.Transformation()));
+      }
+    }
+    //
+    aIt.Initialize(aSF);
+    for (; aIt.More(); aIt.Next()) {
+      uint64_t aHX=Fingerprint(aIt.Value(), theMKeys);
+      HashBytes(aH, &aHX, sizeof(aHX));
+    }
+    theMKeys.Bind(aSF, aH);
+  }
+  //
+  aH=theMKeys.Find(aSF);
+  HashInteger(aH, (Standard_Integer)theS.Orientation());
+  return aH;
+}
+//=======================================================================
+//function : WriteInfo
+//purpose  :
+//=======================================================================
+void WriteInfo(const GEOMAlgo_ShapeInfo& aInfo,
+               std::vector<char>& aBuf)
+{
+  Standard_Integer i, i1, i2;
+  int32_t aI32;
+  Standard_Real aR[GEOMAlgo_ShapeInfoTable::RF_NbFields];
+  Standard_Integer aI[GEOMAlgo_ShapeInfoTable::IF_NbFields];
+  //
+  Handle(TColgp_HArray1OfPnt) aPoles=aInfo.Poles();
+  Handle(TColStd_HArray1OfReal) aKnots=aInfo.Knots();
+  Handle(TColStd_HArray1OfReal) aWeights=aInfo.Weights();
+  Handle(TColStd_HArray1OfInteger) aMults=aInfo.Multiplicities();
+  //
+  Put(aBuf, (int32_t)aInfo.Type());
+  Put(aBuf, (int32_t)aInfo.KindOfShape());
+  Put(aBuf, (int32_t)(aPoles.IsNull() ? 1 : aPoles->Lower()));
+  Put(aBuf, (int32_t)(aPoles.IsNull() ? -1 : aPoles->Length()));
+  Put(aBuf, (int32_t)(aKnots.IsNull() ? 1 : aKnots->Lower()));
+  Put(aBuf, (int32_t)(aKnots.IsNull() ? -1 : aKnots->Length()));
+  Put(aBuf, (int32_t)(aWeights.IsNull() ? 1 : aWeights->Lower()));
+  Put(aBuf, (int32_t)(aWeights.IsNull() ? -1 : aWeights->Length()));
+  Put(aBuf, (int32_t)(aMults.IsNull() ? 1 : aMults->Lower()));
+  Put(aBuf, (int32_t)(aMults.IsNull() ? -1 : aMults->Length()));
+  //
+  GEOMAlgo_ShapeInfoTable::GetValues(aInfo, aR, aI);
+  for (i=0; i<GEOMAlgo_ShapeInfoTable::RF_NbFields; ++i) {
+    Put(aBuf, aR[i]);
+  }
+  for (i=0; i<GEOMAlgo_ShapeInfoTable::IF_NbFields; ++i) {
+    aI32=(int32_t)aI[i];
+    Put(aBuf, aI32);
+  }
+  //
+  if (!aPoles.IsNull()) {
+    i1=aPoles->Lower();
+    i2=aPoles->Upper();
+    for (i=i1; i<=i2; ++i) {
+      const gp_Pnt& aP=aPoles->Value(i);
+      Put(aBuf, aP.X());
+      Put(aBuf, aP.Y());
+      Put(aBuf, aP.Z());
+    }
+  }
+  if (!aKnots.IsNull()) {
+    for (i=aKnots->Lower(); i<=aKnots->Upper(); ++i) {
+      Put(aBuf, aKnots->Value(i));
+    }
+  }
+  if (!aWeights.IsNull()) {
+    for (i=aWeights->Lower(); i<=aWeights->Upper(); ++i) {
+      Put(aBuf, aWeights->Value(i));
+    }
+  }
+  if (!aMults.IsNull()) {
+    for (i=aMults->Lower(); i<=aMults->Upper(); ++i) {
+      aI32=(int32_t)aMults->Value(i);
+      Put(aBuf, aI32);
+    }
+  }
+}
+//=======================================================================
+//function : ReadInfo
+//purpose  :
+//=======================================================================
+Standard_Boolean ReadInfo(const char* pV,
+                          const Standard_Size aNb,
+                          GEOMAlgo_ShapeInfo& aInfo)
+{
+  Standard_Boolean bOK;
+  Standard_Integer i, j;
+  int32_t aType, aKS, aI32, aLower[4], aLength[4];
+  Standard_Real aX, aY, aZ;
+  Standard_Real aR[GEOMAlgo_ShapeInfoTable::RF_NbFields];
+  Standard_Integer aI[GEOMAlgo_ShapeInfoTable::IF_NbFields];
+  const char* pEnd;
+  //
+  pEnd=pV+aNb;
+  bOK=Get(pV, pEnd, aType) && Get(pV, pEnd, aKS);
+  for (j=0; j<4 && bOK; ++j) {
+    bOK=Get(pV, pEnd, aLower[j]) && Get(pV, pEnd, aLength[j]);
+  }
+  for (i=0; i<GEOMAlgo_ShapeInfoTable::RF_NbFields && bOK; ++i) {
+    bOK=Get(pV, pEnd, aR[i]);
+  }
+  for (i=0; i<GEOMAlgo_ShapeInfoTable::IF_NbFields && bOK; ++i) {
+    bOK=Get(pV, pEnd, aI32);
+    aI[i]=aI32;
+  }
+  if (!bOK) {
+    return Standard_False;
+  }
+  //
+  aInfo.Reset();
+  aInfo.SetType((TopAbs_ShapeEnum)aType);
+  aInfo.SetKindOfShape((GEOMAlgo_KindOfShape)aKS);
+  GEOMAlgo_ShapeInfoTable::SetValues(aR, aI, aInfo);
+  //
+  if (aLength[0]>=0) {
+    Handle(TColgp_HArray1OfPnt) aPoles=
+      new TColgp_HArray1OfPnt(aLower[0], aLower[0]+aLength[0]-1);
+    for (i=aPoles->Lower(); i<=aPoles->Upper() && bOK; ++i) {
+      bOK=Get(pV, pEnd, aX) && Get(pV, pEnd, aY) && Get(pV, pEnd, aZ);
+      aPoles->SetValue(i, gp_Pnt(aX, aY, aZ));
+    }
+    aInfo.SetPoles(aPoles);
+  }
+  for (j=1; j<3 && bOK; ++j) {
+    if (aLength[j]>=0) {
+      Handle(TColStd_HArray1OfReal) aA=
+        new TColStd_HArray1OfReal(aLower[j], aLower[j]+aLength[j]-1);
+      for (i=aA->Lower(); i<=aA->Upper() && bOK; ++i) {
+        bOK=Get(pV, pEnd, aX);
+        aA->SetValue(i, aX);
+      }
+      if (j==1) {
+        aInfo.SetKnots(aA);
+      }
+      else {
+        aInfo.SetWeights(aA);
+      }
+    }
+  }
+  if (aLength[3]>=0 && bOK) {
+    Handle(TColStd_HArray1OfInteger) aMults=
+      new TColStd_HArray1OfInteger(aLower[3], aLower[3]+aLength[3]-1);
+    for (i=aMults->Lower(); i<=aMults->Upper() && bOK; ++i) {
+      bOK=Get(pV, pEnd, aI32);
+      aMults->SetValue(i, aI32);
+    }
+    aInfo.SetMultiplicities(aMults);
+  }
+  return bOK;
+}
+//=======================================================================
+//function : HashBytes
+//purpose  : FNV-1a
+//=======================================================================
+void HashBytes(uint64_t& aH,
+               const void* pV,
+               const Standard_Size aNb)
+{
+  Standard_Size i;
+  const unsigned char* pC=(const unsigned char*)pV;
+  //
+  for (i=0; i<aNb; ++i) {
+    aH^=(uint64_t)pC[i];
+    aH*=1099511628211ULL;
+  }
+}
+//=======================================================================
+//function : HashInteger
+//purpose  :
+//=======================================================================
+void HashInteger(uint64_t& aH,
+                 const Standard_Integer aI)
+{
+  int32_t aI32=(int32_t)aI;
+  //
+  HashBytes(aH, &aI32, sizeof(aI32));
+}
+//=======================================================================
+//function : HashReal
+//purpose  : -0. and 0. give the same value
+//=======================================================================
+void HashReal(uint64_t& aH,
+              const Standard_Real aX)
+{
+  Standard_Real aXX=(aX==0.) ? 0. : aX;
+  //
+  HashBytes(aH, &aXX, sizeof(aXX));
+}
+//=======================================================================
+//function : HashPnt
+//purpose  :
+//=======================================================================
+void HashPnt(uint64_t& aH,
+             const gp_Pnt& aP)
+{
+  HashReal(aH, aP.X());
+  HashReal(aH, aP.Y());
+  HashReal(aH, aP.Z());
+}
+//=======================================================================
+//function : Checksum
+//purpose  : FNV-1a, 32 bits
+//=======================================================================
+uint32_t Checksum(const char* pV,
+                  const Standard_Size aNb)
+{
+  Standard_Size i;
+  uint32_t aH;
+  const unsigned char* pC=(const unsigned char*)pV;
+  //
+  aH=2166136261U;
+  for (i=0; i<aNb; ++i) {
+    aH^=(uint32_t)pC[i];
+    aH*=16777619U;
+  }
+  return aH;
+}
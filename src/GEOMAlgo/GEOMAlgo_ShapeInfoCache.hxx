@@ -0,0 +1,153 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoCache.hxx
+
+#ifndef _GEOMAlgo_ShapeInfoCache_HeaderFile
+#define _GEOMAlgo_ShapeInfoCache_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Boolean.hxx>
+
+#include <TCollection_AsciiString.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <NCollection_DataMap.hxx>
+
+#include <GEOMAlgo_ShapeInfo.hxx>
+#include <GEOMAlgo_IndexedDataMapOfShapeShapeInfo.hxx>
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+typedef NCollection_DataMap<TopoDS_Shape, uint64_t, TopTools_ShapeMapHasher>
+  GEOMAlgo_DataMapOfShapeFingerprint;
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoCache
+//purpose  : Read-only file of infos of shapes.
+//           The infos are keyed by a fingerprint of the geometry of
+//           the shapes, so that the infos of a model loaded again
+//           from the same file are found.
+//           The file is mapped in memory by Open(); only the header
+//           is checked there, a record is checked (bounds, checksum)
+//           the first time it is accessed. The records that are not
+//           valid are not found.
+//           Find() can be called concurrently.
+//           The file is written by Write() in the native byte order;
+//           a file of another byte order is not opened.
+//=======================================================================
+class GEOMAlgo_ShapeInfoCache
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_ShapeInfoCache();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_ShapeInfoCache();
+
+  //! Maps the file theFile in memory and checks its header
+  Standard_EXPORT
+    Standard_Boolean Open(const TCollection_AsciiString& theFile) ;
+
+  //! Unmaps the file
+  Standard_EXPORT
+    void Close() ;
+
+  Standard_Boolean IsOpen() const
+  {
+    return (myData!=NULL);
+  }
+
+  //! Returns the tolerance the infos were computed with
+  Standard_EXPORT
+    Standard_Real Tolerance() const;
+
+  //! Returns the number of records
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns true if the file has been written for theShape
+  Standard_EXPORT
+    Standard_Boolean IsCacheOf(const TopoDS_Shape& theShape) const;
+
+  //! Finds the info of the fingerprint theKey
+  Standard_EXPORT
+    Standard_Boolean Find(const uint64_t theKey,
+                          GEOMAlgo_ShapeInfo& theInfo) const;
+
+  //! Finds the info of theS
+  Standard_EXPORT
+    Standard_Boolean Find(const TopoDS_Shape& theS,
+                          GEOMAlgo_ShapeInfo& theInfo) const;
+
+  //! Writes the infos theMSI of the shape theShape computed with
+  //! the tolerance theTol into theFile.
+  //! The shapes that have the same fingerprint and different infos
+  //! are not written.
+  Standard_EXPORT
+    static Standard_Boolean Write(const TCollection_AsciiString& theFile,
+                                  const TopoDS_Shape& theShape,
+                                  const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& theMSI,
+                                  const Standard_Real theTol) ;
+
+  //! Returns the fingerprint of theS.
+  //! The fingerprint depends on the type, the orientation, the
+  //! location and the geometry of theS and of its sub-shapes.
+  //! theMKeys keeps the fingerprints of the shapes visited; it can
+  //! be shared by the calls for the sub-shapes of one shape.
+  Standard_EXPORT
+    static uint64_t Fingerprint(const TopoDS_Shape& theS,
+                                GEOMAlgo_DataMapOfShapeFingerprint& theMKeys) ;
+
+ protected:
+  Standard_EXPORT
+    Standard_Boolean CheckHeader() ;
+
+  Standard_EXPORT
+    Standard_Boolean CheckRecord(const Standard_Integer theIndex) const;
+
+  Standard_EXPORT
+    uint64_t RecordKey(const Standard_Integer theIndex) const;
+
+ private:
+  GEOMAlgo_ShapeInfoCache(const GEOMAlgo_ShapeInfoCache&);
+  GEOMAlgo_ShapeInfoCache& operator=(const GEOMAlgo_ShapeInfoCache&);
+
+ protected:
+  const char* myData;
+  Standard_Size mySize;
+  Standard_Integer myNbRecords;
+  Standard_Real myTolerance;
+  uint64_t myRootKey;
+  const char* myIndex;
+  const char* myRecords;
+  Standard_Size myRecordsSize;
+  //! 0 - not checked, 1 - valid, 2 - not valid
+  mutable std::vector< std::atomic<unsigned char> > myChecked;
+};
+
+#endif
@@ -57,6 +57,76 @@
 #include <BRepTools.hxx>
 
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_MapOfShape.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+
+#include <BOPTools_Parallel.hxx>
+#include <NCollection_Vector.hxx>
+
+static
+  void NbSubShapes(const TopoDS_Shape& aS,
+                   GEOMAlgo_ShapeInfo& aInfo);
+
+static
+  void MapShapeInfos(const TopoDS_Shape& aS,
+                     GEOMAlgo_IndexedDataMapOfShapeShapeInfo& aMI,
+                     Standard_Boolean& bAdded);
+
+static
+  Standard_Boolean IsChanged(const TopoDS_Shape& aS,
+                             const TopTools_MapOfShape& aMChanged,
+                             TopTools_DataMapOfShapeInteger& aMState);
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoFillerTask
+//purpose  : fills the info of one shape of a level
+//=======================================================================
+class GEOMAlgo_ShapeInfoFillerTask
+{
+ public:
+  GEOMAlgo_ShapeInfoFillerTask()
+  :
+    myFiller(NULL),
+    myIndex(0),
+    myErrorStatus(0)
+  {}
+  //
+  void SetFiller(GEOMAlgo_ShapeInfoFiller* theFiller)
+  {
+    myFiller=theFiller;
+  }
+  //
+  void SetIndex(const Standard_Integer theIndex)
+  {
+    myIndex=theIndex;
+  }
+  //
+  Standard_Integer Index() const
+  {
+    return myIndex;
+  }
+  //
+  Standard_Integer ErrorStatus() const
+  {
+    return myErrorStatus;
+  }
+  //
+  void Perform()
+  {
+    myErrorStatus=myFiller->FillLevelInfo(myIndex);
+  }
+  //
+ protected:
+  GEOMAlgo_ShapeInfoFiller* myFiller;
+  Standard_Integer myIndex;
+  Standard_Integer myErrorStatus;
+};
+//
+typedef NCollection_Vector<GEOMAlgo_ShapeInfoFillerTask>
+  GEOMAlgo_VectorOfShapeInfoFillerTask;
 
 //=======================================================================
 //function :
@@ -131,6 +201,18 @@ const GEOMAlgo_ShapeInfo& GEOMAlgo_ShapeInfoFiller::Info
   return myEmptyInfo;
 }
 
+//=======================================================================
+//function : Infos
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::Infos(GEOMAlgo_ShapeInfoTable& theTable,
+                                     const Standard_Boolean theRelease)
+{
+  theTable.Init(myMapInfo);
+  if (theRelease) {
+    myMapInfo.Clear();
+  }
+}
 //=======================================================================
 //function : CheckData
 //purpose  :
@@ -159,9 +241,250 @@ void GEOMAlgo_ShapeInfoFiller::Perform()
     return;
   }
   //
+  if (myRunParallel) {
+    FillShapeByLevels();
+    return;
+  }
+  //
   FillShape(myShape);
 }
 //=======================================================================
+//function : Update
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::Update(const TopoDS_Shape& theShape,
+                                      GEOMAlgo_BuilderShape& theHistory)
+{
+  Standard_Integer i, aNb;
+  TopTools_ListOfShape aLSChanged;
+  //
+  aNb=myMapInfo.Extent();
+  for (i=1; i<=aNb; ++i) {
+    const TopoDS_Shape& aS=myMapInfo.FindKey(i);
+    if (theHistory.IsDeleted(aS) || !theHistory.Modified(aS).IsEmpty()) {
+      aLSChanged.Append(aS);
+    }
+  }
+  //
+  Update(theShape, aLSChanged);
+}
+//=======================================================================
+//function : Update
+//purpose  : The infos of the shapes that are not changed and have no
+//           changed sub-shapes are taken from the previous result,
+//           the other ones are filled as in FillShapeByLevels()
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::Update(const TopoDS_Shape& theShape,
+                                      const TopTools_ListOfShape& theLSChanged)
+{
+  Standard_Boolean bLastAdded;
+  Standard_Integer i, aNb, iOld;
+  TopTools_MapOfShape aMChanged;
+  TopTools_DataMapOfShapeInteger aMState;
+  TopTools_ListIteratorOfListOfShape aIt;
+  GEOMAlgo_IndexedDataMapOfShapeShapeInfo aMIOld;
+  //
+  myErrorStatus=0;
+  //
+  aMIOld.Exchange(myMapInfo);
+  myShape=theShape;
+  //
+  CheckData();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  aIt.Initialize(theLSChanged);
+  for (; aIt.More(); aIt.Next()) {
+    aMChanged.Add(aIt.Value());
+  }
+  //
+  bLastAdded=Standard_False;
+  MapShapeInfos(myShape, myMapInfo, bLastAdded);
+  //
+  aNb=myMapInfo.Extent();
+  for (i=1; i<=aNb; ++i) {
+    const TopoDS_Shape& aS=myMapInfo.FindKey(i);
+    iOld=aMIOld.FindIndex(aS);
+    if (!iOld || !aMIOld.FindKey(iOld).IsEqual(aS)) {
+      continue;
+    }
+    if (IsChanged(aS, aMChanged, aMState)) {
+      continue;
+    }
+    myMapInfo.ChangeFromIndex(i)=aMIOld(iOld);
+  }
+  //
+  FillLevels(bLastAdded);
+}
+//=======================================================================
+//function : Save
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoFiller::Save
+  (const TCollection_AsciiString& theFile) const
+{
+  return GEOMAlgo_ShapeInfoCache::Write(theFile, myShape, myMapInfo,
+                                        myTolerance);
+}
+//=======================================================================
+//function : Load
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoFiller::Load
+  (const GEOMAlgo_ShapeInfoCache& theCache)
+{
+  Standard_Boolean bLastAdded, bAll;
+  Standard_Integer i, aNb;
+  GEOMAlgo_DataMapOfShapeFingerprint aMKeys;
+  //
+  myErrorStatus=0;
+  //
+  myMapInfo.Clear();
+  //
+  CheckData();
+  if (myErrorStatus) {
+    return Standard_False;
+  }
+  //
+  bLastAdded=Standard_False;
+  MapShapeInfos(myShape, myMapInfo, bLastAdded);
+  //
+  bAll=Standard_False;
+  if (theCache.IsOpen() && theCache.Tolerance()==myTolerance) {
+    bAll=Standard_True;
+    aNb=myMapInfo.Extent();
+    for (i=1; i<=aNb; ++i) {
+      const TopoDS_Shape& aS=myMapInfo.FindKey(i);
+      GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromIndex(i);
+      if (!theCache.Find(GEOMAlgo_ShapeInfoCache::Fingerprint(aS, aMKeys),
+                         aInfo)) {
+        aInfo.Reset();
+        bAll=Standard_False;
+      }
+    }
+  }
+  //
+  FillLevels(bLastAdded);
+  return bAll;
+}
+//=======================================================================
+//function : FillShapeByLevels
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillShapeByLevels()
+{
+  Standard_Boolean bLastAdded;
+  //
+  bLastAdded=Standard_False;
+  MapShapeInfos(myShape, myMapInfo, bLastAdded);
+  //
+  FillLevels(bLastAdded);
+}
+//=======================================================================
+//function : FillLevels
+//purpose  : The shapes are mapped in the order FillShape() would add
+//           them. Then the infos of vertices, edges and containers
+//           are filled in parallel, then the infos of faces (they use
+//           the infos of edges), then the details of solids in order
+//           (they use the infos of faces).
+//           The infos that are filled already (taken from a previous
+//           result or from a cache) are kept.
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillLevels(const Standard_Boolean bLastAdded)
+{
+  Standard_Integer i, j, aNb, aNbT;
+  TopAbs_ShapeEnum aType;
+  TColStd_ListOfInteger aLSd;
+  TColStd_ListIteratorOfListOfInteger aItLI;
+  GEOMAlgo_VectorOfShapeInfoFillerTask aVT[2];
+  //
+  aNb=myMapInfo.Extent();
+  //
+  // the info of the last shape visited is filled again to get
+  // the error status
+  if (bLastAdded && aNb) {
+    if (myMapInfo.FindKey(aNb).ShapeType()==TopAbs_EDGE) {
+      myMapInfo.ChangeFromIndex(aNb).Reset();
+    }
+  }
+  //
+  for (i=1; i<=aNb; ++i) {
+    if (myMapInfo(i).Type()!=TopAbs_SHAPE) {
+      continue;
+    }
+    //
+    aType=myMapInfo.FindKey(i).ShapeType();
+    j=(aType==TopAbs_FACE) ? 1 : 0;
+    //
+    GEOMAlgo_ShapeInfoFillerTask& aTask=aVT[j].Appended();
+    aTask.SetFiller(this);
+    aTask.SetIndex(i);
+    //
+    if (aType==TopAbs_SOLID) {
+      aLSd.Append(i);
+    }
+  }
+  //
+  for (j=0; j<2; ++j) {
+    BOPTools_Parallel::Perform(myRunParallel, aVT[j]);
+  }
+  //
+  aItLI.Initialize(aLSd);
+  for (; aItLI.More(); aItLI.Next()) {
+    const TopoDS_Solid& aSd=TopoDS::Solid(myMapInfo.FindKey(aItLI.Value()));
+    FillDetails(aSd);
+  }
+  //
+  // FillShape() keeps the error status of the last shape visited;
+  // it is not 0 for an edge without vertices only
+  myErrorStatus=0;
+  aNbT=aVT[0].Length();
+  if (bLastAdded && aNbT) {
+    const GEOMAlgo_ShapeInfoFillerTask& aTask=aVT[0](aNbT-1);
+    if (aTask.Index()==aNb) {
+      myErrorStatus=aTask.ErrorStatus();
+    }
+  }
+}
+//=======================================================================
+//function : FillLevelInfo
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillLevelInfo
+  (const Standard_Integer theIndex)
+{
+  Standard_Integer iErr;
+  //
+  iErr=0;
+  const TopoDS_Shape& aS=myMapInfo.FindKey(theIndex);
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromIndex(theIndex);
+  //
+  switch(aS.ShapeType()) {
+    case TopAbs_VERTEX:
+      FillVertexInfo(aS, aInfo);
+      break;
+    //
+    case TopAbs_EDGE:
+      iErr=FillEdgeInfo(aS, aInfo);
+      break;
+    //
+    case TopAbs_FACE:
+      FillFaceInfo(aS, aInfo);
+      break;
+    //
+    case TopAbs_SOLID:
+      aInfo.SetType(TopAbs_SOLID);
+      NbSubShapes(aS, aInfo);
+      break;
+    //
+    default:
+      FillContainerInfo(aS, aInfo);
+      break;
+  }
+  return iErr;
+}
+//=======================================================================
 //function :FillShape
 //purpose  :
 //=======================================================================
@@ -220,12 +543,6 @@ void GEOMAlgo_ShapeInfoFiller::FillSubShapes(const TopoDS_Shape& aS)
 void GEOMAlgo_ShapeInfoFiller::FillContainer(const TopoDS_Shape& aS)
 {
   myErrorStatus=0;
-  //
-  Standard_Boolean bIsClosed;
-  TopAbs_ShapeEnum aType;
-  GEOMAlgo_KindOfClosed aKC;
-  //
-  aType=aS.ShapeType();
   //----------------------------------------------------
   if (myMapInfo.Contains(aS)) {
     return;
@@ -236,8 +553,24 @@ void GEOMAlgo_ShapeInfoFiller::FillContainer(const TopoDS_Shape& aS)
   }
   GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
   //----------------------------------------------------
+  FillContainerInfo(aS, aInfo);
+  //
+  FillSubShapes(aS);
+}
+//=======================================================================
+//function : FillContainerInfo
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillContainerInfo(const TopoDS_Shape& aS,
+                                                 GEOMAlgo_ShapeInfo& aInfo)
+{
+  Standard_Boolean bIsClosed;
+  TopAbs_ShapeEnum aType;
+  GEOMAlgo_KindOfClosed aKC;
+  //
+  aType=aS.ShapeType();
   aInfo.SetType(aType);
-  FillNbSubShapes(aS, aInfo);
+  NbSubShapes(aS, aInfo);
   //
   if (aType==TopAbs_SHELL) {
     bIsClosed=BRep_Tool::IsClosed(aS);
@@ -255,8 +588,6 @@ void GEOMAlgo_ShapeInfoFiller::FillContainer(const TopoDS_Shape& aS)
     aKC=(bIsClosed) ? GEOMAlgo_KC_CLOSED :GEOMAlgo_KC_NOTCLOSED;
     aInfo.SetKindOfClosed(aKC);
   }
-  //
-  FillSubShapes(aS);
 }
 //=======================================================================
 //function : FillSolid
@@ -295,7 +626,23 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
   if (myMapInfo.Contains(aS)) {
     return;
   }
+  //----------------------------------------------------
+  GEOMAlgo_ShapeInfo aInfoX;
+  myMapInfo.Add(aS, aInfoX);
+  //
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
+  //----------------------------------------------------
+  FillSubShapes(aS);
   //
+  FillFaceInfo(aS, aInfo);
+}
+//=======================================================================
+//function : FillFaceInfo
+//purpose  : the infos of the edges of the face must be filled
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillFaceInfo(const TopoDS_Shape& aS,
+                                            GEOMAlgo_ShapeInfo& aInfo)
+{
   Standard_Boolean bIsAllowedType;
   Standard_Boolean bInf, bInfU1, bInfU2, bInfV1, bInfV2;
   Standard_Real aUMin, aUMax, aVMin, aVMax, aR1, aR2, dV;
@@ -305,17 +652,9 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
   GeomAbs_SurfaceType aST;
   Handle(Geom_Surface) aSurf;
   TopoDS_Face aF;
-  //----------------------------------------------------
-  GEOMAlgo_ShapeInfo aInfoX;
-  myMapInfo.Add(aS, aInfoX);
   //
-  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
-  //----------------------------------------------------
   aInfo.SetType(TopAbs_FACE);
-  //
-  FillNbSubShapes(aS, aInfo);
-  //
-  FillSubShapes(aS);
+  NbSubShapes(aS, aInfo);
   //
   aF=TopoDS::Face(aS);
   //
@@ -498,7 +837,31 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
 void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
 {
   myErrorStatus=0;
+  //----------------------------------------------------
+  if (myMapInfo.Contains(aS)) {
+    return;
+  }
+  else {
+    GEOMAlgo_ShapeInfo aInfoX;
+    myMapInfo.Add(aS, aInfoX);
+  }
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
+  //----------------------------------------------------
+  myErrorStatus=FillEdgeInfo(aS, aInfo);
+  if (myErrorStatus) {
+    return;
+  }
   //
+  FillSubShapes(aS);
+}
+//=======================================================================
+//function : FillEdgeInfo
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillEdgeInfo
+  (const TopoDS_Shape& aS,
+   GEOMAlgo_ShapeInfo& aInfo)
+{
   Standard_Boolean bDegenerated, bIsAllowedType;
   Standard_Integer aNbV;
   Standard_Real aR1, aR2;
@@ -509,27 +872,16 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
   GeomAbs_CurveType aCT;
   Handle(Geom_Curve) aC3D;
   TopoDS_Edge aE;
-  //----------------------------------------------------
-  if (myMapInfo.Contains(aS)) {
-    return;
-  }
-  else {
-    GEOMAlgo_ShapeInfo aInfoX;
-    myMapInfo.Add(aS, aInfoX);
-  }
-  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
-  //----------------------------------------------------
   aInfo.SetType(TopAbs_EDGE);
   //
-  FillNbSubShapes(aS, aInfo);
+  NbSubShapes(aS, aInfo);
   //
   aE=TopoDS::Edge(aS);
   //
   bDegenerated=BRep_Tool::Degenerated(aE);
   if (bDegenerated) {
     aInfo.SetKindOfShape(GEOMAlgo_KS_DEGENERATED);
-    FillSubShapes(aS);
-    return;
+    return 0;
   }
   //
   aC3D=BRep_Tool::Curve(aE, aT1, aT2);
@@ -537,8 +889,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
   aCT=aGAC.GetType();
   bIsAllowedType=GEOMAlgo_ShapeInfoFiller::IsAllowedType(aCT);
   if (!bIsAllowedType) {
-    FillSubShapes(aS);
-    return;
+    return 0;
   }
   // BSplineCurve
   if (aCT==GeomAbs_BSplineCurve) {
@@ -720,8 +1071,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     //
     aNbV=aInfo.NbSubShapes(TopAbs_VERTEX);
     if (!aNbV) {
-      myErrorStatus=11; // circle edge without vertices
-      return;
+      return 11; // circle edge without vertices
     }
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
     aGAC.D0(aT1, aP1);
@@ -762,8 +1112,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     //
     aNbV=aInfo.NbSubShapes(TopAbs_VERTEX);
     if (!aNbV) {
-      myErrorStatus=11; // ellipse edge without vertices
-      return;
+      return 11; // ellipse edge without vertices
     }
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
     aGAC.D0(aT1, aP1);
@@ -823,7 +1172,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     //
   }// if (aCT==GeomAbs_Parabola) {
   //
-  FillSubShapes(aS);
+  return 0;
 }
 //=======================================================================
 //function :FillVertex
@@ -833,9 +1182,6 @@ void GEOMAlgo_ShapeInfoFiller::FillVertex(const TopoDS_Shape& aS)
 {
   myErrorStatus=0;
   //
-  gp_Pnt aP;
-  TopoDS_Vertex aV;
-  //
   if (myMapInfo.Contains(aS)) {
     return;
   }
@@ -845,12 +1191,23 @@ void GEOMAlgo_ShapeInfoFiller::FillVertex(const TopoDS_Shape& aS)
   }
   GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
   //
+  FillVertexInfo(aS, aInfo);
+}
+//=======================================================================
+//function : FillVertexInfo
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillVertexInfo(const TopoDS_Shape& aS,
+                                              GEOMAlgo_ShapeInfo& aInfo)
+{
+  gp_Pnt aP;
+  TopoDS_Vertex aV;
+  //
   aV=TopoDS::Vertex(aS);
   aP=BRep_Tool::Pnt(aV);
   //
   aInfo.SetType(TopAbs_VERTEX);
   aInfo.SetLocation(aP);
-  myMapInfo.Add(aS, aInfo);
 }
 //=======================================================================
 //function : FillNbSubshapes
@@ -861,6 +1218,15 @@ void GEOMAlgo_ShapeInfoFiller::FillNbSubShapes(const TopoDS_Shape& aS,
 {
   myErrorStatus=0;
   //
+  NbSubShapes(aS, aInfo);
+}
+//=======================================================================
+//function : NbSubShapes
+//purpose  :
+//=======================================================================
+void NbSubShapes(const TopoDS_Shape& aS,
+                 GEOMAlgo_ShapeInfo& aInfo)
+{
   Standard_Integer i, aNb, aNbS;
   TopTools_IndexedMapOfShape aM;
   TopAbs_ShapeEnum aST;
@@ -890,6 +1256,56 @@ void GEOMAlgo_ShapeInfoFiller::FillNbSubShapes(const TopoDS_Shape& aS,
   }
 }
 //=======================================================================
+//function : MapShapeInfos
+//purpose  : adds the shapes in the order of FillShape();
+//           bAdded - the last shape visited has been added
+//=======================================================================
+void MapShapeInfos(const TopoDS_Shape& aS,
+                   GEOMAlgo_IndexedDataMapOfShapeShapeInfo& aMI,
+                   Standard_Boolean& bAdded)
+{
+  TopoDS_Iterator aIt;
+  //
+  if (aMI.Contains(aS)) {
+    bAdded=Standard_False;
+    return;
+  }
+  //
+  GEOMAlgo_ShapeInfo aInfoX;
+  aMI.Add(aS, aInfoX);
+  bAdded=Standard_True;
+  //
+  aIt.Initialize(aS);
+  for (; aIt.More(); aIt.Next()) {
+    MapShapeInfos(aIt.Value(), aMI, bAdded);
+  }
+}
+//=======================================================================
+//function : IsChanged
+//purpose  : aS is in aMChanged or has a sub-shape in aMChanged;
+//           aMState keeps the answers for the shapes visited
+//=======================================================================
+Standard_Boolean IsChanged(const TopoDS_Shape& aS,
+                           const TopTools_MapOfShape& aMChanged,
+                           TopTools_DataMapOfShapeInteger& aMState)
+{
+  Standard_Boolean bChanged;
+  TopoDS_Iterator aIt;
+  //
+  if (aMState.IsBound(aS)) {
+    return (aMState.Find(aS)!=0);
+  }
+  //
+  bChanged=aMChanged.Contains(aS);
+  aIt.Initialize(aS);
+  for (; aIt.More() && !bChanged; aIt.Next()) {
+    bChanged=IsChanged(aIt.Value(), aMChanged, aMState);
+  }
+  //
+  aMState.Bind(aS, bChanged ? 1 : 0);
+  return bChanged;
+}
+//=======================================================================
 //function :NbShells
 //purpose  :
 //=======================================================================
@@ -36,10 +36,15 @@
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TCollection_AsciiString.hxx>
 
 #include <GEOMAlgo_ShapeInfo.hxx>
 #include <GEOMAlgo_IndexedDataMapOfShapeShapeInfo.hxx>
+#include <GEOMAlgo_ShapeInfoTable.hxx>
+#include <GEOMAlgo_ShapeInfoCache.hxx>
 #include <GEOMAlgo_Algo.hxx>
+#include <GEOMAlgo_BuilderShape.hxx>
 
 //=======================================================================
 //class    : GEOMAlgo_ShapeInfoFiller
@@ -72,9 +77,44 @@ class GEOMAlgo_ShapeInfoFiller  : public GEOMAlgo_Algo
   Standard_EXPORT
     const GEOMAlgo_ShapeInfo& Info(const TopoDS_Shape& aS) const;
 
+  //! Adds the infos of all the shapes to theTable.
+  //! If theRelease is true the infos of the filler are cleared.
+  Standard_EXPORT
+    void Infos(GEOMAlgo_ShapeInfoTable& theTable,
+               const Standard_Boolean theRelease=Standard_False) ;
+
   Standard_EXPORT
     virtual  void Perform() ;
 
+  //! Updates the infos for theShape, the result of a modification
+  //! of Shape(). theLSChanged contains the sub-shapes of Shape()
+  //! that have been modified or deleted, e.g. the lists GetRemoved()
+  //! and GetModified() of GEOMAlgo_Extractor.
+  //! Only the infos of the shapes that are new, changed or have
+  //! changed sub-shapes are filled again.
+  Standard_EXPORT
+    void Update(const TopoDS_Shape& theShape,
+                const TopTools_ListOfShape& theLSChanged) ;
+
+  //! Updates the infos for theShape, the result of theHistory
+  //! (e.g. GEOMAlgo_Gluer2) applied to Shape().
+  //! The sub-shapes that are deleted or modified by theHistory
+  //! are treated as changed.
+  Standard_EXPORT
+    void Update(const TopoDS_Shape& theShape,
+                GEOMAlgo_BuilderShape& theHistory) ;
+
+  //! Writes the infos into the file theFile, see
+  //! GEOMAlgo_ShapeInfoCache
+  Standard_EXPORT
+    Standard_Boolean Save(const TCollection_AsciiString& theFile) const;
+
+  //! Fills the infos taking them from theCache; the infos that are
+  //! not found are computed.
+  //! Returns true if all the infos have been found.
+  Standard_EXPORT
+    Standard_Boolean Load(const GEOMAlgo_ShapeInfoCache& theCache) ;
+
  protected:
   Standard_EXPORT
     virtual  void CheckData() ;
@@ -103,6 +143,36 @@ class GEOMAlgo_ShapeInfoFiller  : public GEOMAlgo_Algo
   Standard_EXPORT
     void FillContainer(const TopoDS_Shape& aS) ;
 
+  //! Fills the infos level by level, see RunParallel()
+  Standard_EXPORT
+    void FillShapeByLevels() ;
+
+  //! Fills the infos of myMapInfo that are not filled yet
+  Standard_EXPORT
+    void FillLevels(const Standard_Boolean bLastAdded) ;
+
+  //! Fills the info of the shape theIndex of myMapInfo without
+  //! visiting its sub-shapes; returns the error status.
+  //! The infos of different shapes can be filled concurrently.
+  Standard_EXPORT
+    Standard_Integer FillLevelInfo(const Standard_Integer theIndex) ;
+
+  Standard_EXPORT
+    void FillVertexInfo(const TopoDS_Shape& aS,
+                        GEOMAlgo_ShapeInfo& aInfo) ;
+
+  Standard_EXPORT
+    Standard_Integer FillEdgeInfo(const TopoDS_Shape& aS,
+                                  GEOMAlgo_ShapeInfo& aInfo) ;
+
+  Standard_EXPORT
+    void FillFaceInfo(const TopoDS_Shape& aS,
+                      GEOMAlgo_ShapeInfo& aInfo) ;
+
+  Standard_EXPORT
+    void FillContainerInfo(const TopoDS_Shape& aS,
+                           GEOMAlgo_ShapeInfo& aInfo) ;
+
   Standard_EXPORT
     void FillDetails(const TopoDS_Face& aF,const gp_Pln& aPln) ;
 
@@ -135,6 +205,8 @@ class GEOMAlgo_ShapeInfoFiller  : public GEOMAlgo_Algo
     Standard_Integer NbShells(const TopoDS_Solid& aS);
   //modified by NIZNHY-PKV Tue Jul 03 13:31:49 2012t
 
+  friend class GEOMAlgo_ShapeInfoFillerTask;
+
   TopoDS_Shape myShape;
   GEOMAlgo_ShapeInfo myEmptyInfo;
   GEOMAlgo_IndexedDataMapOfShapeShapeInfo myMapInfo;
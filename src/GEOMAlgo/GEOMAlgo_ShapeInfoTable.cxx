@@ -0,0 +1,459 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoTable.cxx
+
+#include <GEOMAlgo_ShapeInfoTable.hxx>
+
+#include <gp_Pnt.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Ax3.hxx>
+
+#include <cmath>
+
+//=======================================================================
+//function : AddValue
+//purpose  : appends theValue to theColumn of a group of theNbRows rows;
+//           the column is allocated for the first value that is not
+//           the default one
+//=======================================================================
+template <class TheValue>
+static void AddValue(std::vector<TheValue>& theColumn,
+                     const Standard_Integer theNbRows,
+                     const TheValue& theValue,
+                     const TheValue& theDefault)
+{
+  if (theColumn.empty()) {
+    if (theValue==theDefault) {
+      return;
+    }
+    theColumn.assign(theNbRows, theDefault);
+  }
+  theColumn.push_back(theValue);
+}
+//=======================================================================
+//function : ColumnValue
+//purpose  :
+//=======================================================================
+template <class TheValue>
+static const TheValue& ColumnValue(const std::vector<TheValue>& theColumn,
+                                   const Standard_Integer theIndex,
+                                   const TheValue& theDefault)
+{
+  return theColumn.empty() ? theDefault : theColumn[theIndex];
+}
+
+//=======================================================================
+//function :
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoTable::GEOMAlgo_ShapeInfoTable()
+{
+  GEOMAlgo_ShapeInfo aInfo;
+  //
+  GetValues(aInfo, myDefReals, myDefIntegers);
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoTable::~GEOMAlgo_ShapeInfoTable()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::Clear()
+{
+  Standard_Integer i;
+  //
+  myShapes.Clear();
+  myKinds.clear();
+  myRowsInGroup.clear();
+  for (i=0; i<=GEOMAlgo_KS_PARABOLA; ++i) {
+    myGroups[i]=Group();
+  }
+}
+//=======================================================================
+//function : Init
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::Init
+  (const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& theMSI)
+{
+  Standard_Integer i, aNb;
+  //
+  aNb=theMSI.Extent();
+  myKinds.reserve(myKinds.size()+aNb);
+  myRowsInGroup.reserve(myRowsInGroup.size()+aNb);
+  for (i=1; i<=aNb; ++i) {
+    Add(theMSI.FindKey(i), theMSI(i));
+  }
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoTable::Add
+  (const TopoDS_Shape& theS,
+   const GEOMAlgo_ShapeInfo& theInfo)
+{
+  Standard_Integer i, aRow, aNbR, aKS;
+  Standard_Real aR[RF_NbFields];
+  Standard_Integer aI[IF_NbFields];
+  //
+  aRow=myShapes.FindIndex(theS);
+  if (aRow) {
+    return aRow;
+  }
+  aRow=myShapes.Add(theS);
+  //
+  aKS=(Standard_Integer)theInfo.KindOfShape();
+  Group& aG=myGroups[aKS];
+  aNbR=(Standard_Integer)aG.Rows.size();
+  //
+  myKinds.push_back((unsigned char)aKS);
+  myRowsInGroup.push_back(aNbR);
+  aG.Rows.push_back(aRow);
+  aG.Types.push_back((unsigned char)theInfo.Type());
+  //
+  GetValues(theInfo, aR, aI);
+  for (i=0; i<RF_NbFields; ++i) {
+    AddValue(aG.Reals[i], aNbR, aR[i], myDefReals[i]);
+  }
+  for (i=0; i<IF_NbFields; ++i) {
+    AddValue(aG.Integers[i], aNbR, aI[i], myDefIntegers[i]);
+  }
+  //
+  AddValue(aG.Poles, aNbR, theInfo.Poles(),
+           Handle(TColgp_HArray1OfPnt)());
+  AddValue(aG.Knots, aNbR, theInfo.Knots(),
+           Handle(TColStd_HArray1OfReal)());
+  AddValue(aG.Weights, aNbR, theInfo.Weights(),
+           Handle(TColStd_HArray1OfReal)());
+  AddValue(aG.Multiplicities, aNbR, theInfo.Multiplicities(),
+           Handle(TColStd_HArray1OfInteger)());
+  //
+  return aRow;
+}
+//=======================================================================
+//function : View
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoView GEOMAlgo_ShapeInfoTable::View
+  (const TopoDS_Shape& theS) const
+{
+  return GEOMAlgo_ShapeInfoView(this, myShapes.FindIndex(theS));
+}
+//=======================================================================
+//function : RealValue
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoTable::RealValue
+  (const Standard_Integer theRow,
+   const RealField theField) const
+{
+  return ColumnValue(RowGroup(theRow).Reals[theField],
+                     RowInGroup(theRow),
+                     myDefReals[theField]);
+}
+//=======================================================================
+//function : IntegerValue
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoTable::IntegerValue
+  (const Standard_Integer theRow,
+   const IntegerField theField) const
+{
+  return ColumnValue(RowGroup(theRow).Integers[theField],
+                     RowInGroup(theRow),
+                     myDefIntegers[theField]);
+}
+//=======================================================================
+//function : Info
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::Info(const Standard_Integer theRow,
+                                   GEOMAlgo_ShapeInfo& theInfo) const
+{
+  Standard_Integer i;
+  Standard_Real aR[RF_NbFields];
+  Standard_Integer aI[IF_NbFields];
+  //
+  if (theRow<1 || theRow>Extent()) {
+    theInfo.Reset();
+    return;
+  }
+  //
+  for (i=0; i<RF_NbFields; ++i) {
+    aR[i]=RealValue(theRow, (RealField)i);
+  }
+  for (i=0; i<IF_NbFields; ++i) {
+    aI[i]=IntegerValue(theRow, (IntegerField)i);
+  }
+  //
+  GEOMAlgo_ShapeInfoView aView(this, theRow);
+  //
+  theInfo.Reset();
+  theInfo.SetType(aView.Type());
+  theInfo.SetKindOfShape(aView.KindOfShape());
+  SetValues(aR, aI, theInfo);
+  theInfo.SetPoles(aView.Poles());
+  theInfo.SetKnots(aView.Knots());
+  theInfo.SetWeights(aView.Weights());
+  theInfo.SetMultiplicities(aView.Multiplicities());
+}
+//=======================================================================
+//function : NbRows
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoTable::NbRows
+  (const GEOMAlgo_KindOfShape theKS) const
+{
+  return (Standard_Integer)myGroups[theKS].Rows.size();
+}
+//=======================================================================
+//function : Rows
+//purpose  :
+//=======================================================================
+const Standard_Integer* GEOMAlgo_ShapeInfoTable::Rows
+  (const GEOMAlgo_KindOfShape theKS) const
+{
+  const std::vector<Standard_Integer>& aC=myGroups[theKS].Rows;
+  return aC.empty() ? NULL : &aC[0];
+}
+//=======================================================================
+//function : TypeColumn
+//purpose  :
+//=======================================================================
+const unsigned char* GEOMAlgo_ShapeInfoTable::TypeColumn
+  (const GEOMAlgo_KindOfShape theKS) const
+{
+  const std::vector<unsigned char>& aC=myGroups[theKS].Types;
+  return aC.empty() ? NULL : &aC[0];
+}
+//=======================================================================
+//function : Column
+//purpose  :
+//=======================================================================
+const Standard_Real* GEOMAlgo_ShapeInfoTable::Column
+  (const GEOMAlgo_KindOfShape theKS,
+   const RealField theField) const
+{
+  const std::vector<Standard_Real>& aC=myGroups[theKS].Reals[theField];
+  return aC.empty() ? NULL : &aC[0];
+}
+//=======================================================================
+//function : Column
+//purpose  :
+//=======================================================================
+const Standard_Integer* GEOMAlgo_ShapeInfoTable::Column
+  (const GEOMAlgo_KindOfShape theKS,
+   const IntegerField theField) const
+{
+  const std::vector<Standard_Integer>& aC=myGroups[theKS].Integers[theField];
+  return aC.empty() ? NULL : &aC[0];
+}
+//=======================================================================
+//function : Select
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::Select(const GEOMAlgo_KindOfShape theKS,
+                                     const TopAbs_ShapeEnum theType,
+                                     TColStd_ListOfInteger& theLRows) const
+{
+  Standard_Integer i, aNb;
+  //
+  const Group& aG=myGroups[theKS];
+  aNb=(Standard_Integer)aG.Rows.size();
+  for (i=0; i<aNb; ++i) {
+    if (theType==TopAbs_SHAPE || aG.Types[i]==theType) {
+      theLRows.Append(aG.Rows[i]);
+    }
+  }
+}
+//=======================================================================
+//function : Select
+//purpose  : the mask is computed in a loop without branches over the
+//           columns, the rows are collected afterwards
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::Select(const GEOMAlgo_KindOfShape theKS,
+                                     const TopAbs_ShapeEnum theType,
+                                     const RealField theField,
+                                     const Standard_Real theValue,
+                                     const Standard_Real theTol,
+                                     TColStd_ListOfInteger& theLRows) const
+{
+  Standard_Integer i, aNb;
+  //
+  const Group& aG=myGroups[theKS];
+  const std::vector<Standard_Real>& aC=aG.Reals[theField];
+  if (aC.empty()) {
+    if (fabs(myDefReals[theField]-theValue)<=theTol) {
+      Select(theKS, theType, theLRows);
+    }
+    return;
+  }
+  //
+  aNb=(Standard_Integer)aG.Rows.size();
+  std::vector<unsigned char> aMask(aNb);
+  const Standard_Real* pC=&aC[0];
+  const unsigned char* pT=&aG.Types[0];
+  unsigned char* pM=&aMask[0];
+  const unsigned char aType=(unsigned char)theType;
+  const unsigned char bAnyType=(theType==TopAbs_SHAPE);
+  for (i=0; i<aNb; ++i) {
+    pM[i]=(unsigned char)
+      ((fabs(pC[i]-theValue)<=theTol) & (bAnyType | (pT[i]==aType)));
+  }
+  //
+  for (i=0; i<aNb; ++i) {
+    if (pM[i]) {
+      theLRows.Append(aG.Rows[i]);
+    }
+  }
+}
+//=======================================================================
+//function : GetValues
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::GetValues(const GEOMAlgo_ShapeInfo& aInfo,
+                                        Standard_Real* aR,
+                                        Standard_Integer* aI)
+{
+  Standard_Integer i;
+  typedef GEOMAlgo_ShapeInfoTable Table;
+  //
+  const gp_Pnt& aPL=aInfo.Location();
+  aR[Table::RF_LocationX]=aPL.X();
+  aR[Table::RF_LocationY]=aPL.Y();
+  aR[Table::RF_LocationZ]=aPL.Z();
+  //
+  const gp_Dir& aD=aInfo.Direction();
+  aR[Table::RF_DirectionX]=aD.X();
+  aR[Table::RF_DirectionY]=aD.Y();
+  aR[Table::RF_DirectionZ]=aD.Z();
+  //
+  const gp_Ax3& aAx3=aInfo.Position();
+  const gp_Pnt& aP0=aAx3.Location();
+  const gp_Dir& aDN=aAx3.Direction();
+  const gp_Dir& aDX=aAx3.XDirection();
+  aR[Table::RF_PositionX]=aP0.X();
+  aR[Table::RF_PositionY]=aP0.Y();
+  aR[Table::RF_PositionZ]=aP0.Z();
+  aR[Table::RF_PositionDX]=aDN.X();
+  aR[Table::RF_PositionDY]=aDN.Y();
+  aR[Table::RF_PositionDZ]=aDN.Z();
+  aR[Table::RF_PositionXDX]=aDX.X();
+  aR[Table::RF_PositionXDY]=aDX.Y();
+  aR[Table::RF_PositionXDZ]=aDX.Z();
+  //
+  const gp_Pnt& aP1=aInfo.Pnt1();
+  aR[Table::RF_Pnt1X]=aP1.X();
+  aR[Table::RF_Pnt1Y]=aP1.Y();
+  aR[Table::RF_Pnt1Z]=aP1.Z();
+  //
+  const gp_Pnt& aP2=aInfo.Pnt2();
+  aR[Table::RF_Pnt2X]=aP2.X();
+  aR[Table::RF_Pnt2Y]=aP2.Y();
+  aR[Table::RF_Pnt2Z]=aP2.Z();
+  //
+  aR[Table::RF_Radius1]=aInfo.Radius1();
+  aR[Table::RF_Radius2]=aInfo.Radius2();
+  aR[Table::RF_Length]=aInfo.Length();
+  aR[Table::RF_Width]=aInfo.Width();
+  aR[Table::RF_Height]=aInfo.Height();
+  //
+  for (i=TopAbs_COMPOUND; i<=TopAbs_SHAPE; ++i) {
+    aI[Table::IF_NbSubShapes+i]=aInfo.NbSubShapes((TopAbs_ShapeEnum)i);
+  }
+  aI[Table::IF_KindOfName]=(Standard_Integer)aInfo.KindOfName();
+  aI[Table::IF_KindOfBounds]=(Standard_Integer)aInfo.KindOfBounds();
+  aI[Table::IF_KindOfClosed]=(Standard_Integer)aInfo.KindOfClosed();
+  aI[Table::IF_KindOfDef]=(Standard_Integer)aInfo.KindOfDef();
+  aI[Table::IF_KindOfPeriod]=(Standard_Integer)aInfo.KindOfPeriod();
+  aI[Table::IF_PositionDirect]=aAx3.Direct() ? 1 : 0;
+  aI[Table::IF_Degree]=aInfo.Degree();
+  aI[Table::IF_NbPoles]=aInfo.NbPoles();
+  aI[Table::IF_NbKnots]=aInfo.NbKnots();
+  aI[Table::IF_NbWeights]=aInfo.NbWeights();
+  aI[Table::IF_NbMultiplicities]=aInfo.NbMultiplicities();
+}
+//=======================================================================
+//function : SetValues
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoTable::SetValues(const Standard_Real* aR,
+                                        const Standard_Integer* aI,
+                                        GEOMAlgo_ShapeInfo& aInfo)
+{
+  Standard_Integer i;
+  typedef GEOMAlgo_ShapeInfoTable Table;
+  //
+  aInfo.SetLocation(gp_Pnt(aR[Table::RF_LocationX],
+                           aR[Table::RF_LocationY],
+                           aR[Table::RF_LocationZ]));
+  aInfo.SetDirection(gp_Dir(aR[Table::RF_DirectionX],
+                            aR[Table::RF_DirectionY],
+                            aR[Table::RF_DirectionZ]));
+  //
+  gp_Ax3 aAx3(gp_Pnt(aR[Table::RF_PositionX],
+                     aR[Table::RF_PositionY],
+                     aR[Table::RF_PositionZ]),
+              gp_Dir(aR[Table::RF_PositionDX],
+                     aR[Table::RF_PositionDY],
+                     aR[Table::RF_PositionDZ]),
+              gp_Dir(aR[Table::RF_PositionXDX],
+                     aR[Table::RF_PositionXDY],
+                     aR[Table::RF_PositionXDZ]));
+  if (!aI[Table::IF_PositionDirect]) {
+    aAx3.YReverse();
+  }
+  aInfo.SetPosition(aAx3);
+  //
+  aInfo.SetPnt1(gp_Pnt(aR[Table::RF_Pnt1X],
+                       aR[Table::RF_Pnt1Y],
+                       aR[Table::RF_Pnt1Z]));
+  aInfo.SetPnt2(gp_Pnt(aR[Table::RF_Pnt2X],
+                       aR[Table::RF_Pnt2Y],
+                       aR[Table::RF_Pnt2Z]));
+  aInfo.SetRadius1(aR[Table::RF_Radius1]);
+  aInfo.SetRadius2(aR[Table::RF_Radius2]);
+  aInfo.SetLength(aR[Table::RF_Length]);
+  aInfo.SetWidth(aR[Table::RF_Width]);
+  aInfo.SetHeight(aR[Table::RF_Height]);
+  //
+  for (i=TopAbs_COMPOUND; i<=TopAbs_SHAPE; ++i) {
+    aInfo.SetNbSubShapes((TopAbs_ShapeEnum)i, aI[Table::IF_NbSubShapes+i]);
+  }
+  aInfo.SetKindOfName((GEOMAlgo_KindOfName)aI[Table::IF_KindOfName]);
+  aInfo.SetKindOfBounds((GEOMAlgo_KindOfBounds)aI[Table::IF_KindOfBounds]);
+  aInfo.SetKindOfClosed((GEOMAlgo_KindOfClosed)aI[Table::IF_KindOfClosed]);
+  aInfo.SetKindOfDef((GEOMAlgo_KindOfDef)aI[Table::IF_KindOfDef]);
+  aInfo.SetKindOfPeriod((GEOMAlgo_KindOfPeriod)aI[Table::IF_KindOfPeriod]);
+  aInfo.SetDegree(aI[Table::IF_Degree]);
+  aInfo.SetNbPoles(aI[Table::IF_NbPoles]);
+  aInfo.SetNbKnots(aI[Table::IF_NbKnots]);
+  aInfo.SetNbWeights(aI[Table::IF_NbWeights]);
+  aInfo.SetNbMultiplicities(aI[Table::IF_NbMultiplicities]);
+}
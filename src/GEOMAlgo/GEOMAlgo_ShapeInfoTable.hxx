@@ -0,0 +1,266 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoTable.hxx
+
+#ifndef _GEOMAlgo_ShapeInfoTable_HeaderFile
+#define _GEOMAlgo_ShapeInfoTable_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TColgp_HArray1OfPnt.hxx>
+#include <TColStd_HArray1OfReal.hxx>
+#include <TColStd_HArray1OfInteger.hxx>
+
+#include <GEOMAlgo_KindOfShape.hxx>
+#include <GEOMAlgo_ShapeInfo.hxx>
+#include <GEOMAlgo_ShapeInfoView.hxx>
+#include <GEOMAlgo_IndexedDataMapOfShapeShapeInfo.hxx>
+
+#include <vector>
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoTable
+//purpose  : Compact storage of the infos of shapes.
+//           The rows are grouped by the kind of shape; each group
+//           stores the fields of GEOMAlgo_ShapeInfo as columns.
+//           A column is allocated only when one of the rows of the
+//           group has a value that differs from the default one of
+//           GEOMAlgo_ShapeInfo, so e.g. the planes do not store
+//           radii and only the splines store poles and knots.
+//           The rows are accessed through GEOMAlgo_ShapeInfoView;
+//           the columns can be scanned directly.
+//=======================================================================
+class GEOMAlgo_ShapeInfoTable
+{
+ public:
+  //! Real fields
+  enum RealField {
+    RF_LocationX, RF_LocationY, RF_LocationZ,
+    RF_DirectionX, RF_DirectionY, RF_DirectionZ,
+    RF_PositionX, RF_PositionY, RF_PositionZ,
+    RF_PositionDX, RF_PositionDY, RF_PositionDZ,
+    RF_PositionXDX, RF_PositionXDY, RF_PositionXDZ,
+    RF_Pnt1X, RF_Pnt1Y, RF_Pnt1Z,
+    RF_Pnt2X, RF_Pnt2Y, RF_Pnt2Z,
+    RF_Radius1, RF_Radius2,
+    RF_Length, RF_Width, RF_Height,
+    RF_NbFields
+  };
+  //
+  //! Integer fields.
+  //! The numbers of sub-shapes are IF_NbSubShapes+TopAbs_ShapeEnum.
+  enum IntegerField {
+    IF_NbSubShapes,
+    IF_KindOfName=IF_NbSubShapes+9,
+    IF_KindOfBounds,
+    IF_KindOfClosed,
+    IF_KindOfDef,
+    IF_KindOfPeriod,
+    IF_PositionDirect,
+    IF_Degree,
+    IF_NbPoles,
+    IF_NbKnots,
+    IF_NbWeights,
+    IF_NbMultiplicities,
+    IF_NbFields
+  };
+
+  Standard_EXPORT
+    GEOMAlgo_ShapeInfoTable();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_ShapeInfoTable();
+
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Adds the rows of the map theMSI in its order
+  Standard_EXPORT
+    void Init(const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& theMSI) ;
+
+  //! Adds the row of the shape theS and returns its index.
+  //! If theS is already in the table its row is not changed.
+  Standard_EXPORT
+    Standard_Integer Add(const TopoDS_Shape& theS,
+                         const GEOMAlgo_ShapeInfo& theInfo) ;
+
+  //! Returns the number of rows
+  Standard_Integer Extent() const
+  {
+    return myShapes.Extent();
+  }
+
+  //! Returns the index of the row of theS, 0 if there is no one
+  Standard_Integer FindIndex(const TopoDS_Shape& theS) const
+  {
+    return myShapes.FindIndex(theS);
+  }
+
+  //! Returns the shape of the row theRow
+  const TopoDS_Shape& Shape(const Standard_Integer theRow) const
+  {
+    return myShapes.FindKey(theRow);
+  }
+
+  //! Returns the view of the row theRow, the null view if there is
+  //! no such row
+  GEOMAlgo_ShapeInfoView View(const Standard_Integer theRow) const
+  {
+    return GEOMAlgo_ShapeInfoView
+      (this, (theRow>=1 && theRow<=Extent()) ? theRow : 0);
+  }
+
+  //! Returns the view of the row of theS, the null view (with the
+  //! values of the default GEOMAlgo_ShapeInfo) if theS is not in the
+  //! table
+  Standard_EXPORT
+    GEOMAlgo_ShapeInfoView View(const TopoDS_Shape& theS) const;
+
+  //! Copies the row theRow into theInfo, resets theInfo if there is
+  //! no such row
+  Standard_EXPORT
+    void Info(const Standard_Integer theRow,
+              GEOMAlgo_ShapeInfo& theInfo) const;
+
+  //! Returns the number of rows of the kind theKS
+  Standard_EXPORT
+    Standard_Integer NbRows(const GEOMAlgo_KindOfShape theKS) const;
+
+  //! Returns the indices of the rows of the kind theKS,
+  //! NbRows(theKS) values in increasing order
+  Standard_EXPORT
+    const Standard_Integer* Rows(const GEOMAlgo_KindOfShape theKS) const;
+
+  //! Returns the types of shapes of the rows of the kind theKS
+  Standard_EXPORT
+    const unsigned char* TypeColumn(const GEOMAlgo_KindOfShape theKS) const;
+
+  //! Returns the column theField of the rows of the kind theKS,
+  //! NULL if the field has the default value in all these rows
+  Standard_EXPORT
+    const Standard_Real* Column(const GEOMAlgo_KindOfShape theKS,
+                                const RealField theField) const;
+
+  //! Returns the column theField of the rows of the kind theKS,
+  //! NULL if the field has the default value in all these rows
+  Standard_EXPORT
+    const Standard_Integer* Column(const GEOMAlgo_KindOfShape theKS,
+                                   const IntegerField theField) const;
+
+  //! Appends to theLRows the rows of the kind theKS and of the type
+  //! theType (TopAbs_SHAPE - any type) whose value of theField
+  //! is in [theValue-theTol, theValue+theTol]
+  Standard_EXPORT
+    void Select(const GEOMAlgo_KindOfShape theKS,
+                const TopAbs_ShapeEnum theType,
+                const RealField theField,
+                const Standard_Real theValue,
+                const Standard_Real theTol,
+                TColStd_ListOfInteger& theLRows) const;
+
+  //! Appends to theLRows the rows of the kind theKS and of the type
+  //! theType (TopAbs_SHAPE - any type)
+  Standard_EXPORT
+    void Select(const GEOMAlgo_KindOfShape theKS,
+                const TopAbs_ShapeEnum theType,
+                TColStd_ListOfInteger& theLRows) const;
+
+  //! Gets the values of the fields of theInfo in the order of the
+  //! enumerations; theR and theI have RF_NbFields and IF_NbFields
+  //! items
+  Standard_EXPORT
+    static void GetValues(const GEOMAlgo_ShapeInfo& theInfo,
+                          Standard_Real* theR,
+                          Standard_Integer* theI) ;
+
+  //! Sets the fields of theInfo from the values theR and theI.
+  //! The type, the kind of shape and the arrays of splines are not
+  //! set.
+  Standard_EXPORT
+    static void SetValues(const Standard_Real* theR,
+                          const Standard_Integer* theI,
+                          GEOMAlgo_ShapeInfo& theInfo) ;
+
+  //! Returns the default value of the field theField,
+  //! i.e. the value of a reset GEOMAlgo_ShapeInfo
+  Standard_Real DefaultValue(const RealField theField) const
+  {
+    return myDefReals[theField];
+  }
+
+  //! Returns the default value of the field theField,
+  //! i.e. the value of a reset GEOMAlgo_ShapeInfo
+  Standard_Integer DefaultValue(const IntegerField theField) const
+  {
+    return myDefIntegers[theField];
+  }
+
+ protected:
+  //! Rows of one kind of shape
+  struct Group {
+    std::vector<Standard_Integer> Rows;
+    std::vector<unsigned char> Types;
+    std::vector<Standard_Real> Reals[RF_NbFields];
+    std::vector<Standard_Integer> Integers[IF_NbFields];
+    std::vector<Handle(TColgp_HArray1OfPnt)> Poles;
+    std::vector<Handle(TColStd_HArray1OfReal)> Knots;
+    std::vector<Handle(TColStd_HArray1OfReal)> Weights;
+    std::vector<Handle(TColStd_HArray1OfInteger)> Multiplicities;
+  };
+
+  Standard_EXPORT
+    Standard_Real RealValue(const Standard_Integer theRow,
+                            const RealField theField) const;
+
+  Standard_EXPORT
+    Standard_Integer IntegerValue(const Standard_Integer theRow,
+                                  const IntegerField theField) const;
+
+  const Group& RowGroup(const Standard_Integer theRow) const
+  {
+    return myGroups[myKinds[theRow-1]];
+  }
+
+  Standard_Integer RowInGroup(const Standard_Integer theRow) const
+  {
+    return myRowsInGroup[theRow-1];
+  }
+
+  friend class GEOMAlgo_ShapeInfoView;
+
+  TopTools_IndexedMapOfShape myShapes;
+  std::vector<unsigned char> myKinds;
+  std::vector<Standard_Integer> myRowsInGroup;
+  Group myGroups[GEOMAlgo_KS_PARABOLA+1];
+  Standard_Real myDefReals[RF_NbFields];
+  Standard_Integer myDefIntegers[IF_NbFields];
+};
+
+#endif
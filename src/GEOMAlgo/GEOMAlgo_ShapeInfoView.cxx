@@ -0,0 +1,417 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoView.cxx
+
+#include <GEOMAlgo_ShapeInfoView.hxx>
+
+#include <GEOMAlgo_ShapeInfoTable.hxx>
+#include <GEOMAlgo_ShapeInfo.hxx>
+
+#include <TopoDS_Shape.hxx>
+
+typedef GEOMAlgo_ShapeInfoTable GEOMAlgo_Table;
+
+//=======================================================================
+//function : DefaultInfo
+//purpose  : the values returned by the null view
+//=======================================================================
+static const GEOMAlgo_ShapeInfo& DefaultInfo()
+{
+  static const GEOMAlgo_ShapeInfo aInfo;
+  return aInfo;
+}
+
+//=======================================================================
+//function : Shape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_ShapeInfoView::Shape() const
+{
+  if (IsNull()) {
+    static const TopoDS_Shape aS;
+    return aS;
+  }
+  return myTable->Shape(myRow);
+}
+//=======================================================================
+//function : Info
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoView::Info(GEOMAlgo_ShapeInfo& theInfo) const
+{
+  if (IsNull()) {
+    theInfo.Reset();
+    return;
+  }
+  myTable->Info(myRow, theInfo);
+}
+//=======================================================================
+//function : Type
+//purpose  :
+//=======================================================================
+TopAbs_ShapeEnum GEOMAlgo_ShapeInfoView::Type() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Type();
+  }
+  return (TopAbs_ShapeEnum)
+    myTable->RowGroup(myRow).Types[myTable->RowInGroup(myRow)];
+}
+//=======================================================================
+//function : NbSubShapes
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::NbSubShapes
+  (const TopAbs_ShapeEnum aType) const
+{
+  Standard_Integer iN;
+  //
+  if (IsNull()) {
+    return DefaultInfo().NbSubShapes(aType);
+  }
+  //
+  iN=(Standard_Integer)aType;
+  if (iN<TopAbs_COMPOUND || iN>TopAbs_SHAPE) {
+    return 0;
+  }
+  return myTable->IntegerValue
+    (myRow, (GEOMAlgo_Table::IntegerField)(GEOMAlgo_Table::IF_NbSubShapes+iN));
+}
+//=======================================================================
+//function : KindOfShape
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfShape GEOMAlgo_ShapeInfoView::KindOfShape() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfShape();
+  }
+  return (GEOMAlgo_KindOfShape)myTable->myKinds[myRow-1];
+}
+//=======================================================================
+//function : KindOfName
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfName GEOMAlgo_ShapeInfoView::KindOfName() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfName();
+  }
+  return (GEOMAlgo_KindOfName)
+    myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_KindOfName);
+}
+//=======================================================================
+//function : KindOfBounds
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfBounds GEOMAlgo_ShapeInfoView::KindOfBounds() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfBounds();
+  }
+  return (GEOMAlgo_KindOfBounds)
+    myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_KindOfBounds);
+}
+//=======================================================================
+//function : KindOfClosed
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfClosed GEOMAlgo_ShapeInfoView::KindOfClosed() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfClosed();
+  }
+  return (GEOMAlgo_KindOfClosed)
+    myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_KindOfClosed);
+}
+//=======================================================================
+//function : KindOfDef
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfDef GEOMAlgo_ShapeInfoView::KindOfDef() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfDef();
+  }
+  return (GEOMAlgo_KindOfDef)
+    myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_KindOfDef);
+}
+//=======================================================================
+//function : KindOfPeriod
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfPeriod GEOMAlgo_ShapeInfoView::KindOfPeriod() const
+{
+  if (IsNull()) {
+    return DefaultInfo().KindOfPeriod();
+  }
+  return (GEOMAlgo_KindOfPeriod)
+    myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_KindOfPeriod);
+}
+//=======================================================================
+//function : Location
+//purpose  :
+//=======================================================================
+gp_Pnt GEOMAlgo_ShapeInfoView::Location() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Location();
+  }
+  return gp_Pnt(myTable->RealValue(myRow, GEOMAlgo_Table::RF_LocationX),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_LocationY),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_LocationZ));
+}
+//=======================================================================
+//function : Direction
+//purpose  :
+//=======================================================================
+gp_Dir GEOMAlgo_ShapeInfoView::Direction() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Direction();
+  }
+  return gp_Dir(myTable->RealValue(myRow, GEOMAlgo_Table::RF_DirectionX),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_DirectionY),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_DirectionZ));
+}
+//=======================================================================
+//function : Position
+//purpose  :
+//=======================================================================
+gp_Ax3 GEOMAlgo_ShapeInfoView::Position() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Position();
+  }
+  gp_Pnt aP(myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionX),
+            myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionY),
+            myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionZ));
+  gp_Dir aDN(myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionDX),
+             myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionDY),
+             myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionDZ));
+  gp_Dir aDX(myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionXDX),
+             myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionXDY),
+             myTable->RealValue(myRow, GEOMAlgo_Table::RF_PositionXDZ));
+  gp_Ax3 aAx3(aP, aDN, aDX);
+  //
+  if (!myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_PositionDirect)) {
+    aAx3.YReverse();
+  }
+  return aAx3;
+}
+//=======================================================================
+//function : Pnt1
+//purpose  :
+//=======================================================================
+gp_Pnt GEOMAlgo_ShapeInfoView::Pnt1() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Pnt1();
+  }
+  return gp_Pnt(myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt1X),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt1Y),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt1Z));
+}
+//=======================================================================
+//function : Pnt2
+//purpose  :
+//=======================================================================
+gp_Pnt GEOMAlgo_ShapeInfoView::Pnt2() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Pnt2();
+  }
+  return gp_Pnt(myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt2X),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt2Y),
+                myTable->RealValue(myRow, GEOMAlgo_Table::RF_Pnt2Z));
+}
+//=======================================================================
+//function : Radius1
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoView::Radius1() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Radius1();
+  }
+  return myTable->RealValue(myRow, GEOMAlgo_Table::RF_Radius1);
+}
+//=======================================================================
+//function : Radius2
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoView::Radius2() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Radius2();
+  }
+  return myTable->RealValue(myRow, GEOMAlgo_Table::RF_Radius2);
+}
+//=======================================================================
+//function : Length
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoView::Length() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Length();
+  }
+  return myTable->RealValue(myRow, GEOMAlgo_Table::RF_Length);
+}
+//=======================================================================
+//function : Width
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoView::Width() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Width();
+  }
+  return myTable->RealValue(myRow, GEOMAlgo_Table::RF_Width);
+}
+//=======================================================================
+//function : Height
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoView::Height() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Height();
+  }
+  return myTable->RealValue(myRow, GEOMAlgo_Table::RF_Height);
+}
+//=======================================================================
+//function : Degree
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::Degree() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Degree();
+  }
+  return myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_Degree);
+}
+//=======================================================================
+//function : NbPoles
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::NbPoles() const
+{
+  if (IsNull()) {
+    return DefaultInfo().NbPoles();
+  }
+  return myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_NbPoles);
+}
+//=======================================================================
+//function : NbKnots
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::NbKnots() const
+{
+  if (IsNull()) {
+    return DefaultInfo().NbKnots();
+  }
+  return myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_NbKnots);
+}
+//=======================================================================
+//function : NbWeights
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::NbWeights() const
+{
+  if (IsNull()) {
+    return DefaultInfo().NbWeights();
+  }
+  return myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_NbWeights);
+}
+//=======================================================================
+//function : NbMultiplicities
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoView::NbMultiplicities() const
+{
+  if (IsNull()) {
+    return DefaultInfo().NbMultiplicities();
+  }
+  return myTable->IntegerValue(myRow, GEOMAlgo_Table::IF_NbMultiplicities);
+}
+//=======================================================================
+//function : Poles
+//purpose  :
+//=======================================================================
+Handle(TColgp_HArray1OfPnt) GEOMAlgo_ShapeInfoView::Poles() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Poles();
+  }
+  const std::vector<Handle(TColgp_HArray1OfPnt)>& aC=
+    myTable->RowGroup(myRow).Poles;
+  //
+  return aC.empty() ? Handle(TColgp_HArray1OfPnt)() :
+    aC[myTable->RowInGroup(myRow)];
+}
+//=======================================================================
+//function : Knots
+//purpose  :
+//=======================================================================
+Handle(TColStd_HArray1OfReal) GEOMAlgo_ShapeInfoView::Knots() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Knots();
+  }
+  const std::vector<Handle(TColStd_HArray1OfReal)>& aC=
+    myTable->RowGroup(myRow).Knots;
+  //
+  return aC.empty() ? Handle(TColStd_HArray1OfReal)() :
+    aC[myTable->RowInGroup(myRow)];
+}
+//=======================================================================
+//function : Weights
+//purpose  :
+//=======================================================================
+Handle(TColStd_HArray1OfReal) GEOMAlgo_ShapeInfoView::Weights() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Weights();
+  }
+  const std::vector<Handle(TColStd_HArray1OfReal)>& aC=
+    myTable->RowGroup(myRow).Weights;
+  //
+  return aC.empty() ? Handle(TColStd_HArray1OfReal)() :
+    aC[myTable->RowInGroup(myRow)];
+}
+//=======================================================================
+//function : Multiplicities
+//purpose  :
+//=======================================================================
+Handle(TColStd_HArray1OfInteger) GEOMAlgo_ShapeInfoView::Multiplicities() const
+{
+  if (IsNull()) {
+    return DefaultInfo().Multiplicities();
+  }
+  const std::vector<Handle(TColStd_HArray1OfInteger)>& aC=
+    myTable->RowGroup(myRow).Multiplicities;
+  //
+  return aC.empty() ? Handle(TColStd_HArray1OfInteger)() :
+    aC[myTable->RowInGroup(myRow)];
+}
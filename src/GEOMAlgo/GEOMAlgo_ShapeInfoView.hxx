@@ -0,0 +1,182 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_ShapeInfoView.hxx
+
+#ifndef _GEOMAlgo_ShapeInfoView_HeaderFile
+#define _GEOMAlgo_ShapeInfoView_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+#include <gp_Pnt.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Ax3.hxx>
+
+#include <GEOMAlgo_KindOfShape.hxx>
+#include <GEOMAlgo_KindOfName.hxx>
+#include <GEOMAlgo_KindOfBounds.hxx>
+#include <GEOMAlgo_KindOfClosed.hxx>
+#include <GEOMAlgo_KindOfDef.hxx>
+#include <GEOMAlgo_KindOfPeriod.hxx>
+
+#include <TColgp_HArray1OfPnt.hxx>
+#include <TColStd_HArray1OfReal.hxx>
+#include <TColStd_HArray1OfInteger.hxx>
+
+class TopoDS_Shape;
+class GEOMAlgo_ShapeInfo;
+class GEOMAlgo_ShapeInfoTable;
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoView
+//purpose  : Read access to one row of GEOMAlgo_ShapeInfoTable
+//           with the getters of GEOMAlgo_ShapeInfo.
+//           The view refers to the table, it must not outlive it.
+//           The getters of the null view return the values of the
+//           default GEOMAlgo_ShapeInfo.
+//=======================================================================
+class GEOMAlgo_ShapeInfoView
+{
+ public:
+  GEOMAlgo_ShapeInfoView()
+  :
+    myTable(NULL),
+    myRow(0)
+  {}
+
+  GEOMAlgo_ShapeInfoView(const GEOMAlgo_ShapeInfoTable* theTable,
+                         const Standard_Integer theRow)
+  :
+    myTable(theTable),
+    myRow(theRow)
+  {}
+
+  //! Returns true if the view does not refer to a row
+  Standard_Boolean IsNull() const
+  {
+    return (myTable==NULL || myRow<1);
+  }
+
+  //! Returns the index of the row in the table
+  Standard_Integer Row() const
+  {
+    return myRow;
+  }
+
+  Standard_EXPORT
+    const TopoDS_Shape& Shape() const;
+
+  //! Copies the row into theInfo
+  Standard_EXPORT
+    void Info(GEOMAlgo_ShapeInfo& theInfo) const;
+
+  Standard_EXPORT
+    TopAbs_ShapeEnum Type() const;
+
+  Standard_EXPORT
+    Standard_Integer NbSubShapes(const TopAbs_ShapeEnum aType) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfShape KindOfShape() const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfName KindOfName() const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfBounds KindOfBounds() const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfClosed KindOfClosed() const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfDef KindOfDef() const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfPeriod KindOfPeriod() const;
+
+  Standard_EXPORT
+    gp_Pnt Location() const;
+
+  Standard_EXPORT
+    gp_Dir Direction() const;
+
+  Standard_EXPORT
+    gp_Ax3 Position() const;
+
+  Standard_EXPORT
+    gp_Pnt Pnt1() const;
+
+  Standard_EXPORT
+    gp_Pnt Pnt2() const;
+
+  Standard_EXPORT
+    Standard_Real Radius1() const;
+
+  Standard_EXPORT
+    Standard_Real Radius2() const;
+
+  Standard_EXPORT
+    Standard_Real Length() const;
+
+  Standard_EXPORT
+    Standard_Real Width() const;
+
+  Standard_EXPORT
+    Standard_Real Height() const;
+
+  Standard_EXPORT
+    Standard_Integer Degree() const;
+
+  Standard_EXPORT
+    Standard_Integer NbPoles() const;
+
+  Standard_EXPORT
+    Standard_Integer NbKnots() const;
+
+  Standard_EXPORT
+    Standard_Integer NbWeights() const;
+
+  Standard_EXPORT
+    Standard_Integer NbMultiplicities() const;
+
+  Standard_EXPORT
+    Handle(TColgp_HArray1OfPnt) Poles() const;
+
+  Standard_EXPORT
+    Handle(TColStd_HArray1OfReal) Knots() const;
+
+  Standard_EXPORT
+    Handle(TColStd_HArray1OfReal) Weights() const;
+
+  Standard_EXPORT
+    Handle(TColStd_HArray1OfInteger) Multiplicities() const;
+
+ protected:
+  const GEOMAlgo_ShapeInfoTable* myTable;
+  Standard_Integer myRow;
+};
+
+#endif
@@ -45,20 +45,15 @@
 
 
 //=======================================================================
-//function : GetState
+//function : MakeQuadric
 //purpose  :
 //=======================================================================
- Standard_Integer GEOMAlgo_SurfaceTools::GetState
-  (const gp_Pnt& aP,
-   const GeomAdaptor_Surface& aGAS,
-   const Standard_Real aTol,
-   TopAbs_State& aState)
+static
+  Standard_Integer MakeQuadric(const GeomAdaptor_Surface& aGAS,
+                               IntSurf_Quadric& aQuad)
 {
   Standard_Integer    iErr  = 0;
   GeomAbs_SurfaceType aType = aGAS.GetType();
-  IntSurf_Quadric     aQuad;
-  //
-  aState = TopAbs_UNKNOWN;
   //
   switch (aType) {
   case GeomAbs_Plane:
@@ -78,16 +73,67 @@
     break;
   }
   //
+  return iErr;
+}
+//=======================================================================
+//function : StateOfDistance
+//purpose  :
+//=======================================================================
+static inline
+  TopAbs_State StateOfDistance(const Standard_Real aDp,
+                               const Standard_Real aTol)
+{
+  if (aDp > aTol) {
+    return TopAbs_OUT;
+  }
+  if (aDp < -aTol) {
+    return TopAbs_IN;
+  }
+  return TopAbs_ON;
+}
+//=======================================================================
+//function : GetState
+//purpose  :
+//=======================================================================
+ Standard_Integer GEOMAlgo_SurfaceTools::GetState
+  (const gp_Pnt& aP,
+   const GeomAdaptor_Surface& aGAS,
+   const Standard_Real aTol,
+   TopAbs_State& aState)
+{
+  Standard_Integer iErr;
+  IntSurf_Quadric  aQuad;
+  //
+  aState = TopAbs_UNKNOWN;
+  //
+  iErr=MakeQuadric(aGAS, aQuad);
   if (!iErr) {
-    const Standard_Real aDp = aQuad.Distance(aP);
-    //
-    aState = TopAbs_ON;
-    //
-    if (aDp > aTol) {
-      aState = TopAbs_OUT;
-    } else if (aDp < -aTol) {
-      aState = TopAbs_IN;
-    }
+    aState=StateOfDistance(aQuad.Distance(aP), aTol);
+  }
+  //
+  return iErr;
+}
+//=======================================================================
+//function : GetState
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_SurfaceTools::GetState
+  (const TColgp_Array1OfPnt& aP,
+   const GeomAdaptor_Surface& aGAS,
+   const Standard_Real aTol,
+   GEOMAlgo_Array1OfState& aState)
+{
+  Standard_Integer i, iErr;
+  IntSurf_Quadric  aQuad;
+  //
+  iErr=MakeQuadric(aGAS, aQuad);
+  if (iErr) {
+    aState.Init(TopAbs_UNKNOWN);
+    return iErr;
+  }
+  //
+  for (i=aP.Lower(); i<=aP.Upper(); ++i) {
+    aState(i)=StateOfDistance(aQuad.Distance(aP(i)), aTol);
   }
   //
   return iErr;
@@ -41,6 +41,8 @@
 #include <GeomAdaptor_Surface.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Sphere.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <GEOMAlgo_Array1OfState.hxx>
 
 
 //=======================================================================
@@ -74,6 +76,15 @@ class GEOMAlgo_SurfaceTools
                                       const Standard_Real aTol,
                                       TopAbs_State& aSt) ;
 
+  //! Computes the states of the points aP(i) relative to the
+  //! surface aS into aSt(i); aSt must have the bounds of aP.
+  //! The quadric of the surface is built once for all points.
+  Standard_EXPORT
+    static  Standard_Integer GetState(const TColgp_Array1OfPnt& aP,
+                                      const GeomAdaptor_Surface& aS,
+                                      const Standard_Real aTol,
+                                      GEOMAlgo_Array1OfState& aSt) ;
+
   Standard_EXPORT
     static  TopAbs_State ReverseState(const TopAbs_State aSt) ;
 
@@ -0,0 +1,227 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_TopologyIndex.cxx
+
+#include <GEOMAlgo_TopologyIndex.hxx>
+
+#include <TopAbs_Orientation.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_TopologyIndex, Standard_Transient)
+
+static
+  void Invert(const std::vector<Standard_Integer>& aOffsets,
+              const std::vector<Standard_Integer>& aIds,
+              const Standard_Integer aNbTargets,
+              std::vector<Standard_Integer>& aOffsetsInv,
+              std::vector<Standard_Integer>& aIdsInv);
+
+//=======================================================================
+//function : GEOMAlgo_TopologyIndex
+//purpose  :
+//=======================================================================
+GEOMAlgo_TopologyIndex::GEOMAlgo_TopologyIndex()
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_TopologyIndex::~GEOMAlgo_TopologyIndex()
+{
+}
+//=======================================================================
+//function : Shape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_TopologyIndex::Shape() const
+{
+  return myShape;
+}
+//=======================================================================
+//function : Shapes
+//purpose  :
+//=======================================================================
+const TopTools_IndexedMapOfShape& GEOMAlgo_TopologyIndex::Shapes
+  (const TopAbs_ShapeEnum theType) const
+{
+  return myShapes[theType];
+}
+//=======================================================================
+//function : Init
+//purpose  :
+//=======================================================================
+void GEOMAlgo_TopologyIndex::Init(const TopoDS_Shape& theShape)
+{
+  Standard_Integer i, k, aNbV, aNbE, aNbF, aNbS, iV, iE, iF;
+  TopAbs_Orientation aOr;
+  TopoDS_Iterator aIt;
+  TopExp_Explorer aExp;
+  //
+  myShape=theShape;
+  for (i=0; i<TopAbs_SHAPE; ++i) {
+    myShapes[i].Clear();
+  }
+  for (i=0; i<T_NbTables; ++i) {
+    myOffsets[i].assign(1, 0);
+    myIds[i].clear();
+  }
+  //
+  if (myShape.IsNull()) {
+    return;
+  }
+  //
+  // 1. The sub-shapes
+  for (i=TopAbs_COMPOUND; i<TopAbs_SHAPE; ++i) {
+    TopExp::MapShapes(myShape, (TopAbs_ShapeEnum)i, myShapes[i]);
+  }
+  //
+  const TopTools_IndexedMapOfShape& aMV=myShapes[TopAbs_VERTEX];
+  const TopTools_IndexedMapOfShape& aME=myShapes[TopAbs_EDGE];
+  const TopTools_IndexedMapOfShape& aMF=myShapes[TopAbs_FACE];
+  const TopTools_IndexedMapOfShape& aMS=myShapes[TopAbs_SOLID];
+  aNbV=aMV.Extent();
+  aNbE=aME.Extent();
+  aNbF=aMF.Extent();
+  aNbS=aMS.Extent();
+  //
+  // 2. Edge -> vertices
+  std::vector<Standard_Integer>& aOffEV=myOffsets[T_EdgeVertices];
+  std::vector<Standard_Integer>& aIdsEV=myIds[T_EdgeVertices];
+  std::vector<Standard_Integer>& aOffEB=myOffsets[T_EdgeBounds];
+  std::vector<Standard_Integer>& aIdsEB=myIds[T_EdgeBounds];
+  aOffEV.reserve(aNbE+1);
+  aOffEB.reserve(aNbE+1);
+  aIdsEV.reserve(2*aNbE);
+  aIdsEB.reserve(2*aNbE);
+  for (i=1; i<=aNbE; ++i) {
+    aIt.Initialize(aME(i));
+    for (; aIt.More(); aIt.Next()) {
+      const TopoDS_Shape& aV=aIt.Value();
+      iV=aMV.FindIndex(aV);
+      aOr=aV.Orientation();
+      //
+      // an edge has few vertices
+      for (k=aOffEV.back(); k<(Standard_Integer)aIdsEV.size(); ++k) {
+        if (aIdsEV[k]==iV) {
+          break;
+        }
+      }
+      if (k==(Standard_Integer)aIdsEV.size()) {
+        aIdsEV.push_back(iV);
+      }
+      //
+      if (aOr==TopAbs_FORWARD || aOr==TopAbs_REVERSED) {
+        for (k=aOffEB.back(); k<(Standard_Integer)aIdsEB.size(); ++k) {
+          if (aIdsEB[k]==iV) {
+            break;
+          }
+        }
+        if (k==(Standard_Integer)aIdsEB.size()) {
+          aIdsEB.push_back(iV);
+        }
+      }
+    }
+    aOffEV.push_back((Standard_Integer)aIdsEV.size());
+    aOffEB.push_back((Standard_Integer)aIdsEB.size());
+  }
+  //
+  // 3. Face -> edges, in the order of the exploration of the face
+  std::vector<Standard_Integer>& aOffFE=myOffsets[T_FaceEdges];
+  std::vector<Standard_Integer>& aIdsFE=myIds[T_FaceEdges];
+  std::vector<Standard_Integer> aStamp(aNbE+1, 0);
+  aOffFE.reserve(aNbF+1);
+  for (i=1; i<=aNbF; ++i) {
+    aExp.Init(aMF(i), TopAbs_EDGE);
+    for (; aExp.More(); aExp.Next()) {
+      iE=aME.FindIndex(aExp.Current());
+      if (aStamp[iE]!=i) {
+        aStamp[iE]=i;
+        aIdsFE.push_back(iE);
+      }
+    }
+    aOffFE.push_back((Standard_Integer)aIdsFE.size());
+  }
+  //
+  // 4. Solid -> faces
+  std::vector<Standard_Integer>& aOffSF=myOffsets[T_SolidFaces];
+  std::vector<Standard_Integer>& aIdsSF=myIds[T_SolidFaces];
+  std::vector<Standard_Integer> aStampF(aNbF+1, 0);
+  aOffSF.reserve(aNbS+1);
+  for (i=1; i<=aNbS; ++i) {
+    aExp.Init(aMS(i), TopAbs_FACE);
+    for (; aExp.More(); aExp.Next()) {
+      iF=aMF.FindIndex(aExp.Current());
+      if (aStampF[iF]!=i) {
+        aStampF[iF]=i;
+        aIdsSF.push_back(iF);
+      }
+    }
+    aOffSF.push_back((Standard_Integer)aIdsSF.size());
+  }
+  //
+  // 5. The ancestors, in the order of the ancestors
+  Invert(aOffEV, aIdsEV, aNbV,
+         myOffsets[T_VertexEdges], myIds[T_VertexEdges]);
+  Invert(aOffFE, aIdsFE, aNbE,
+         myOffsets[T_EdgeFaces], myIds[T_EdgeFaces]);
+  Invert(aOffSF, aIdsSF, aNbF,
+         myOffsets[T_FaceSolids], myIds[T_FaceSolids]);
+}
+//=======================================================================
+//function : Invert
+//purpose  : builds the table target -> sources from the table
+//           source -> targets; the sources of each target are sorted
+//=======================================================================
+void Invert(const std::vector<Standard_Integer>& aOffsets,
+            const std::vector<Standard_Integer>& aIds,
+            const Standard_Integer aNbTargets,
+            std::vector<Standard_Integer>& aOffsetsInv,
+            std::vector<Standard_Integer>& aIdsInv)
+{
+  Standard_Integer i, k, aNbSources;
+  //
+  aNbSources=(Standard_Integer)aOffsets.size()-1;
+  //
+  aOffsetsInv.assign(aNbTargets+1, 0);
+  for (k=0; k<(Standard_Integer)aIds.size(); ++k) {
+    ++aOffsetsInv[aIds[k]];
+  }
+  // aOffsetsInv[t] is the end of the sources of the target t
+  for (i=1; i<=aNbTargets; ++i) {
+    aOffsetsInv[i]+=aOffsetsInv[i-1];
+  }
+  //
+  // fill forwards from the starts, so that the sources are in the
+  // ascending order
+  std::vector<Standard_Integer> aPos(aOffsetsInv.begin(),
+                                     aOffsetsInv.end()-1);
+  aIdsInv.resize(aIds.size());
+  for (i=1; i<=aNbSources; ++i) {
+    for (k=aOffsets[i-1]; k<aOffsets[i]; ++k) {
+      aIdsInv[aPos[aIds[k]-1]++]=i;
+    }
+  }
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMAlgo_TopologyIndex.hxx
+
+#ifndef _GEOMAlgo_TopologyIndex_HeaderFile
+#define _GEOMAlgo_TopologyIndex_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_TopologyIndex, Standard_Transient)
+
+//=======================================================================
+/**
+ * The topology of a shape explored once: the sub-shapes of each type
+ * and the incidence tables between the vertices, the edges, the
+ * faces and the solids, so that the stages of an algorithm (e.g. the gluing) do not
+ * explore the shape again and again.
+ * The sub-shapes of each type are indexed in the order of
+ * TopExp::MapShapes(). The tables are kept as the flat arrays (CSR):
+ * the ids of the sub-shapes of the shape #i are
+ * Id(theTable, i, 1) .. Id(theTable, i, NbIds(theTable, i)).
+ * The index is not changed after Init(), so it can be shared by
+ * the algorithms and the threads.
+ */
+//=======================================================================
+//class    : GEOMAlgo_TopologyIndex
+//purpose  :
+//=======================================================================
+class GEOMAlgo_TopologyIndex : public Standard_Transient
+{
+ public:
+  /**
+   * The incidence tables.
+   */
+  enum Table {
+    T_EdgeVertices,   //!< the vertices of the edge
+    T_EdgeBounds,     //!< the FORWARD and REVERSED vertices of the edge
+    T_FaceEdges,      //!< the edges of the face
+    T_VertexEdges,    //!< the edges of the vertex
+    T_EdgeFaces,      //!< the faces of the edge
+    T_SolidFaces,     //!< the faces of the solid
+    T_FaceSolids,     //!< the solids of the face
+    T_NbTables
+  };
+
+  /**
+   * Constructor.
+   */
+  Standard_EXPORT
+    GEOMAlgo_TopologyIndex();
+
+  /**
+   * Destructor.
+   */
+  Standard_EXPORT
+    virtual ~GEOMAlgo_TopologyIndex();
+
+  /**
+   * Builds the index of the shape theShape.
+   */
+  Standard_EXPORT
+    void Init(const TopoDS_Shape& theShape);
+
+  /**
+   * Returns the shape the index is built for.
+   */
+  Standard_EXPORT
+    const TopoDS_Shape& Shape() const;
+
+  /**
+   * Returns the sub-shapes of the type theType in the order of
+   * TopExp::MapShapes().
+   */
+  Standard_EXPORT
+    const TopTools_IndexedMapOfShape& Shapes(const TopAbs_ShapeEnum theType) const;
+
+  /**
+   * Returns the number of the ids of the shape theIndex
+   * in the table theTable.
+   */
+  Standard_Integer NbIds(const Table theTable,
+                         const Standard_Integer theIndex) const
+  {
+    const std::vector<Standard_Integer>& aOffsets=myOffsets[theTable];
+    return aOffsets[theIndex]-aOffsets[theIndex-1];
+  }
+
+  /**
+   * Returns the id #theK (1..NbIds()) of the shape theIndex
+   * in the table theTable.
+   */
+  Standard_Integer Id(const Table theTable,
+                      const Standard_Integer theIndex,
+                      const Standard_Integer theK) const
+  {
+    return myIds[theTable][myOffsets[theTable][theIndex-1]+theK-1];
+  }
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_TopologyIndex, Standard_Transient)
+
+ protected:
+  TopoDS_Shape myShape;
+  TopTools_IndexedMapOfShape myShapes[TopAbs_SHAPE];
+  std::vector<Standard_Integer> myOffsets[T_NbTables];
+  std::vector<Standard_Integer> myIds[T_NbTables];
+};
+
+#endif
@@ -0,0 +1,1119 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMBench.cxx
+//
+// The benchmarks of the GEOMAlgo and BlockFix algorithms on the
+// synthetic models of growing size (see GEOMBench_Models).
+// Each line of the output is one run: the algorithm, the model,
+// the size parameter, the number of faces of the model and the wall
+// time, so that the scaling curve of each algorithm can be plotted.
+// Some runs add their own figures (e.g. the throughput or the number
+// of the pruned candidates) as name=value pairs in the last column.
+//
+// Usage: GEOMBench [-max N] [-parallel] [-obb] [-tile S] [-json] [algo ...]
+//   -max N      the largest size parameter (default 8), the sizes
+//               are 1, 2, 4, ... N
+//   -parallel   runs the algorithms in parallel mode
+//   -obb        prunes the candidates by the oriented boxes
+//               (GlueDetectorOBB and GetInPlaceOBB run both modes)
+//   -tile S     glues by the tiles of the size S (Gluer2); Gluer2Tiled
+//               compares the numbers of the sub-shapes of the tiled
+//               and the full gluing (the error is -1 if they differ);
+//               Gluer2Incremental checks the incremental gluing by
+//               the full one in the same way
+//   -json       writes the runs with the profiles of the algorithms
+//               (see GEOMAlgo_Algo::Profile()) as JSON lines
+//   algo        the algorithms to run (default all): Gluer2,
+//               Gluer2Tiled, Gluer2Incremental, GlueDetector, GetInPlace,
+//               FinderShapeOn2, Splitter, ShapeInfoFiller, Extractor,
+//               BlockFix, PassKey, GlueDetectorOBB, GetInPlaceOBB,
+//               TopologyIndex
+
+#include <GEOMBench_Models.hxx>
+
+#include <Basics_OCCTVersion.hxx>
+
+#include <Standard.hxx>
+#include <Standard_OStream.hxx>
+#include <OSD_Timer.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <NCollection_IndexedDataMap.hxx>
+
+#include <gp_Pnt.hxx>
+#include <Bnd_Box.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
+
+#include <GEOMAlgo_Algo.hxx>
+#include <GEOMAlgo_ClsfBox.hxx>
+#include <GEOMAlgo_Extractor.hxx>
+#include <GEOMAlgo_FinderShapeOn2.hxx>
+#include <GEOMAlgo_GetInPlace.hxx>
+#include <GEOMAlgo_GlueDetector.hxx>
+#include <GEOMAlgo_Gluer2.hxx>
+#include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
+#include <GEOMAlgo_PassKeyShape.hxx>
+#include <GEOMAlgo_Profile.hxx>
+#include <GEOMAlgo_ShapeInfoFiller.hxx>
+#include <GEOMAlgo_Splitter.hxx>
+#include <GEOMAlgo_State.hxx>
+#include <GEOMAlgo_TopologyIndex.hxx>
+
+#include <BlockFix_BlockFixAPI.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//! The own figures of a run: name -> value
+typedef NCollection_IndexedDataMap<TCollection_AsciiString, Standard_Real>
+  GEOMBench_Figures;
+
+//=======================================================================
+//class    : GEOMBench_Options
+//purpose  : the options of the run
+//=======================================================================
+class GEOMBench_Options
+{
+ public:
+  GEOMBench_Options()
+  :
+    myMax(8),
+    myRunParallel(Standard_False),
+    myUseOBB(Standard_False),
+    myTileSize(0.),
+    myJSON(Standard_False),
+    myNbAlgos(0),
+    myAlgos(NULL)
+  {}
+  //
+  // Returns true if the algorithm is to run
+  Standard_Boolean IsToRun(const Standard_CString theAlgo) const
+  {
+    Standard_Integer i;
+    //
+    if (!myNbAlgos) {
+      return Standard_True;
+    }
+    for (i=0; i<myNbAlgos; ++i) {
+      if (!strcmp(myAlgos[i], theAlgo)) {
+        return Standard_True;
+      }
+    }
+    return Standard_False;
+  }
+  //
+  Standard_Integer myMax;
+  Standard_Boolean myRunParallel;
+  Standard_Boolean myUseOBB;
+  Standard_Real myTileSize;
+  Standard_Boolean myJSON;
+  Standard_Integer myNbAlgos;
+  char** myAlgos;
+};
+
+static
+  void Report(const GEOMBench_Options& theOptions,
+              const Standard_CString theAlgo,
+              const Standard_CString theModel,
+              const Standard_Integer theSize,
+              const TopoDS_Shape& theShape,
+              const Standard_Real theTime,
+              const Standard_Integer theErr,
+              const GEOMAlgo_Profile* theProfile,
+              const GEOMBench_Figures* theFigures=NULL);
+static
+  void BenchGluer2(const GEOMBench_Options& theOptions,
+                   const Standard_CString theModel,
+                   const Standard_Integer theSize,
+                   const TopoDS_Shape& theShape);
+static
+  void BenchGluer2Tiled(const GEOMBench_Options& theOptions,
+                        const Standard_CString theModel,
+                        const Standard_Integer theSize,
+                        const TopoDS_Shape& theShape);
+static
+  void BenchGluer2Incremental(const GEOMBench_Options& theOptions,
+                              const Standard_CString theModel,
+                              const Standard_Integer theSize,
+                              const TopoDS_Shape& theShape);
+static
+  void BenchExtractor(const GEOMBench_Options& theOptions,
+                      const Standard_CString theModel,
+                      const Standard_Integer theSize,
+                      const TopoDS_Shape& theShape);
+static
+  void BenchGlueDetector(const GEOMBench_Options& theOptions,
+                         const Standard_CString theModel,
+                         const Standard_Integer theSize,
+                         const TopoDS_Shape& theShape);
+static
+  void BenchGetInPlace(const GEOMBench_Options& theOptions,
+                       const Standard_CString theModel,
+                       const Standard_Integer theSize,
+                       const TopoDS_Shape& theShape);
+static
+  void BenchGlueDetectorOBB(const GEOMBench_Options& theOptions,
+                            const Standard_CString theModel,
+                            const Standard_Integer theSize,
+                            const TopoDS_Shape& theShape);
+static
+  void BenchGetInPlaceOBB(const GEOMBench_Options& theOptions,
+                          const Standard_CString theModel,
+                          const Standard_Integer theSize,
+                          const TopoDS_Shape& theShape);
+static
+  void BenchFinderShapeOn2(const GEOMBench_Options& theOptions,
+                           const Standard_CString theModel,
+                           const Standard_Integer theSize,
+                           const TopoDS_Shape& theShape);
+static
+  void BenchSplitter(const GEOMBench_Options& theOptions,
+                     const Standard_CString theModel,
+                     const Standard_Integer theSize,
+                     const TopoDS_Shape& theShape);
+static
+  void BenchShapeInfoFiller(const GEOMBench_Options& theOptions,
+                            const Standard_CString theModel,
+                            const Standard_Integer theSize,
+                            const TopoDS_Shape& theShape);
+static
+  void BenchPassKey(const GEOMBench_Options& theOptions,
+                    const Standard_CString theModel,
+                    const Standard_Integer theSize,
+                    const TopoDS_Shape& theShape);
+static
+  void BenchBlockFix(const GEOMBench_Options& theOptions,
+                     const Standard_CString theModel,
+                     const Standard_Integer theSize,
+                     const TopoDS_Shape& theShape);
+static
+  void BenchTopologyIndex(const GEOMBench_Options& theOptions,
+                          const Standard_CString theModel,
+                          const Standard_Integer theN,
+                          const TopoDS_Shape& theS);
+static
+  Standard_Integer CheckTopologyTable(const Handle(GEOMAlgo_TopologyIndex)& theTI,
+                                      const GEOMAlgo_TopologyIndex::Table theTable,
+                                      const TopAbs_ShapeEnum theType,
+                                      const TopAbs_ShapeEnum theTypeA);
+static
+  void BenchModel(const GEOMBench_Options& theOptions,
+                  const Standard_CString theModel,
+                  const Standard_Integer theSize,
+                  const TopoDS_Shape& theShape);
+
+//! The tolerance of the algorithms
+static const Standard_Real THE_TOLERANCE=1.e-4;
+
+//=======================================================================
+//function : main
+//purpose  :
+//=======================================================================
+int main(int argc, char** argv)
+{
+  Standard_Integer i, aN;
+  GEOMBench_Options aOptions;
+  //
+  for (i=1; i<argc; ++i) {
+    if (!strcmp(argv[i], "-max") && i+1<argc) {
+      aOptions.myMax=atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "-parallel")) {
+      aOptions.myRunParallel=Standard_True;
+    }
+    else if (!strcmp(argv[i], "-obb")) {
+      aOptions.myUseOBB=Standard_True;
+    }
+    else if (!strcmp(argv[i], "-tile") && i+1<argc) {
+      aOptions.myTileSize=atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "-json")) {
+      aOptions.myJSON=Standard_True;
+    }
+    else if (argv[i][0]=='-') {
+      std::cerr << "Usage: " << argv[0]
+                << " [-max N] [-parallel] [-obb] [-tile S] [-json] [algo ...]"
+                << std::endl;
+      return 1;
+    }
+    else {
+      // the rest are the names of the algorithms
+      aOptions.myNbAlgos=argc-i;
+      aOptions.myAlgos=argv+i;
+      break;
+    }
+  }
+  //
+  if (!aOptions.myJSON) {
+    std::cout << "algo,model,size,faces,time,error,figures" << std::endl;
+  }
+  //
+  for (aN=1; aN<=aOptions.myMax; aN*=2) {
+    BenchModel(aOptions, "BoxGrid", aN,
+               GEOMBench_Models::BoxGrid(aN, aN, aN, 10.));
+    BenchModel(aOptions, "CylinderArray", aN,
+               GEOMBench_Models::CylinderArray(aN, aN, 5., 20.));
+    BenchModel(aOptions, "SpherePack", aN,
+               GEOMBench_Models::SpherePack(aN, 5.));
+    // the plates: the scenario of the pruning by the oriented boxes
+    BenchModel(aOptions, "RotatedPlates", aN,
+               GEOMBench_Models::RotatedPlates(4*aN, 100., 0.5));
+  }
+  return 0;
+}
+//=======================================================================
+//function : BenchModel
+//purpose  : runs the algorithms on one model
+//=======================================================================
+void BenchModel(const GEOMBench_Options& aOptions,
+                const Standard_CString aModel,
+                const Standard_Integer aN,
+                const TopoDS_Shape& aS)
+{
+  if (aOptions.IsToRun("GlueDetector")) {
+    BenchGlueDetector(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("Gluer2")) {
+    BenchGluer2(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("Gluer2Tiled")) {
+    BenchGluer2Tiled(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("Gluer2Incremental")) {
+    BenchGluer2Incremental(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("GetInPlace")) {
+    BenchGetInPlace(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("GlueDetectorOBB")) {
+    BenchGlueDetectorOBB(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("GetInPlaceOBB")) {
+    BenchGetInPlaceOBB(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("FinderShapeOn2")) {
+    BenchFinderShapeOn2(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("ShapeInfoFiller")) {
+    BenchShapeInfoFiller(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("Splitter")) {
+    BenchSplitter(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("Extractor")) {
+    BenchExtractor(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("BlockFix")) {
+    BenchBlockFix(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("PassKey")) {
+    BenchPassKey(aOptions, aModel, aN, aS);
+  }
+  if (aOptions.IsToRun("TopologyIndex")) {
+    BenchTopologyIndex(aOptions, aModel, aN, aS);
+  }
+}
+//=======================================================================
+//function : BenchGlueDetector
+//purpose  :
+//=======================================================================
+void BenchGlueDetector(const GEOMBench_Options& aOptions,
+                       const Standard_CString aModel,
+                       const Standard_Integer aN,
+                       const TopoDS_Shape& aS)
+{
+  OSD_Timer aTimer;
+  GEOMAlgo_GlueDetector aGD;
+  //
+  aGD.SetArgument(aS);
+  aGD.SetTolerance(THE_TOLERANCE);
+  aGD.SetRunParallel(aOptions.myRunParallel);
+  aGD.SetUseOBB(aOptions.myUseOBB);
+  aGD.SetProfiling(aOptions.myJSON);
+  //
+  aTimer.Start();
+  aGD.Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "GlueDetector", aModel, aN, aS, aTimer.ElapsedTime(),
+         aGD.ErrorStatus(), &aGD.Profile());
+}
+//=======================================================================
+//function : BenchGluer2
+//purpose  :
+//=======================================================================
+void BenchGluer2(const GEOMBench_Options& aOptions,
+                 const Standard_CString aModel,
+                 const Standard_Integer aN,
+                 const TopoDS_Shape& aS)
+{
+  OSD_Timer aTimer;
+  GEOMAlgo_Gluer2 aGluer;
+  //
+  aGluer.SetArgument(aS);
+  aGluer.SetTolerance(THE_TOLERANCE);
+  aGluer.SetKeepNonSolids(Standard_True);
+  aGluer.SetRunParallel(aOptions.myRunParallel);
+  aGluer.SetUseOBB(aOptions.myUseOBB);
+  aGluer.SetProfiling(aOptions.myJSON);
+  aGluer.SetTileSize(aOptions.myTileSize);
+  //
+  aTimer.Start();
+  if (aOptions.myTileSize<=0.) {
+    aGluer.Detect();
+  }
+  if (!aGluer.ErrorStatus()) {
+    aGluer.Perform();
+  }
+  aTimer.Stop();
+  //
+  Report(aOptions, "Gluer2", aModel, aN, aS, aTimer.ElapsedTime(),
+         aGluer.ErrorStatus(), &aGluer.Profile());
+}
+//=======================================================================
+//function : BenchGluer2Tiled
+//purpose  : glues the model at full and by the tiles (of the size of
+//           -tile or of the quarter of the model) and compares the
+//           numbers of the sub-shapes of the results; only the tiled
+//           gluing is timed for the row, the error is -1 if the
+//           numbers differ
+//=======================================================================
+void BenchGluer2Tiled(const GEOMBench_Options& aOptions,
+                      const Standard_CString aModel,
+                      const Standard_Integer aN,
+                      const TopoDS_Shape& aS)
+{
+  Standard_Integer i, j, iErr, aNbMismatches, aNb[2];
+  Standard_Real aTimes[2], aTileSize, aX[6];
+  OSD_Timer aTimer;
+  Bnd_Box aBox;
+  TopoDS_Shape aR[2];
+  GEOMBench_Figures aFigures;
+  const TopAbs_ShapeEnum aTypes[6]={
+    TopAbs_VERTEX, TopAbs_EDGE, TopAbs_WIRE,
+    TopAbs_FACE, TopAbs_SHELL, TopAbs_SOLID
+  };
+  //
+  aTileSize=aOptions.myTileSize;
+  if (aTileSize<=0.) {
+    BRepBndLib::Add(aS, aBox);
+    if (aBox.IsVoid()) {
+      return;
+    }
+    aBox.Get(aX[0], aX[1], aX[2], aX[3], aX[4], aX[5]);
+    aTileSize=0.25*Max(aX[3]-aX[0], Max(aX[4]-aX[1], aX[5]-aX[2]));
+  }
+  //
+  iErr=0;
+  for (i=0; i<2; ++i) {
+    GEOMAlgo_Gluer2 aGluer;
+    //
+    aGluer.SetArgument(aS);
+    aGluer.SetTolerance(THE_TOLERANCE);
+    aGluer.SetKeepNonSolids(Standard_True);
+    aGluer.SetRunParallel(aOptions.myRunParallel);
+    aGluer.SetUseOBB(aOptions.myUseOBB);
+    aGluer.SetTileSize(i ? aTileSize : 0.);
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    if (!i) {
+      aGluer.Detect();
+    }
+    if (!aGluer.ErrorStatus()) {
+      aGluer.Perform();
+    }
+    aTimer.Stop();
+    aTimes[i]=aTimer.ElapsedTime();
+    //
+    iErr=Max(iErr, aGluer.ErrorStatus());
+    aR[i]=aGluer.Shape();
+  }
+  //
+  aNbMismatches=0;
+  if (!iErr) {
+    for (j=0; j<6; ++j) {
+      for (i=0; i<2; ++i) {
+        aNb[i]=GEOMBench_Models::NbShapes(aR[i], aTypes[j]);
+      }
+      if (aNb[0]!=aNb[1]) {
+        ++aNbMismatches;
+        std::cerr << "Gluer2Tiled: " << aModel << " " << aN
+                  << ": the numbers of the sub-shapes of the type "
+                  << (Standard_Integer)aTypes[j] << " differ: "
+                  << aNb[0] << " (full), " << aNb[1] << " (tiled)"
+                  << std::endl;
+      }
+    }
+    if (aNbMismatches) {
+      iErr=-1;
+    }
+  }
+  //
+  aFigures.Add("tile", aTileSize);
+  aFigures.Add("time_full", aTimes[0]);
+  aFigures.Add("time_tiled", aTimes[1]);
+  aFigures.Add("mismatches", (Standard_Real)aNbMismatches);
+  //
+  Report(aOptions, "Gluer2Tiled", aModel, aN, aS, aTimes[1], iErr,
+         NULL, &aFigures);
+}
+//=======================================================================
+//function : BenchGluer2Incremental
+//purpose  : glues the model, then replaces its first part by the copy
+//           and glues it incrementally; only the second step is timed.
+//           The incremental result is checked by the full gluing (see
+//           GEOMAlgo_Gluer2::SetCheckIncremental()), the error is -1
+//           if they differ
+//=======================================================================
+void BenchGluer2Incremental(const GEOMBench_Options& aOptions,
+                            const Standard_CString aModel,
+                            const Standard_Integer aN,
+                            const TopoDS_Shape& aS)
+{
+  Standard_Integer iErr, aNbMismatches;
+  Standard_Real aTime;
+  OSD_Timer aTimer;
+  GEOMBench_Figures aFigures;
+  TopoDS_Iterator aIt;
+  TopTools_ListOfShape aLRemoved, aLAdded;
+  GEOMAlgo_Gluer2 aGluer;
+  //
+  aIt.Initialize(aS);
+  if (!aIt.More()) {
+    return;
+  }
+  aLRemoved.Append(aIt.Value());
+  aLAdded.Append(BRepBuilderAPI_Copy(aIt.Value()).Shape());
+  //
+  aGluer.SetArgument(aS);
+  aGluer.SetTolerance(THE_TOLERANCE);
+  aGluer.SetKeepNonSolids(Standard_True);
+  aGluer.SetRunParallel(aOptions.myRunParallel);
+  aGluer.SetUseOBB(aOptions.myUseOBB);
+  // the time of the check is taken from the profile
+  aGluer.SetProfiling(Standard_True);
+  aGluer.SetTileSize(aOptions.myTileSize);
+  aGluer.SetCheckIncremental(Standard_True);
+  if (aOptions.myTileSize<=0.) {
+    aGluer.Detect();
+  }
+  if (!aGluer.ErrorStatus()) {
+    aGluer.Perform();
+  }
+  //
+  aTimer.Start();
+  if (!aGluer.ErrorStatus()) {
+    aGluer.PerformIncremental(aLRemoved, aLAdded);
+  }
+  aTimer.Stop();
+  aTime=aTimer.ElapsedTime()-aGluer.Profile().Time("CheckIncremental");
+  //
+  iErr=aGluer.ErrorStatus();
+  aNbMismatches=0;
+  if (!iErr && aGluer.WarningStatus()==3) {
+    ++aNbMismatches;
+    std::cerr << "Gluer2Incremental: " << aModel << " " << aN
+              << ": the incremental and the full gluing differ"
+              << std::endl;
+    iErr=-1;
+  }
+  //
+  aFigures.Add("time_check", aGluer.Profile().Time("CheckIncremental"));
+  aFigures.Add("mismatches", aNbMismatches);
+  //
+  Report(aOptions, "Gluer2Incremental", aModel, aN, aS, aTime, iErr,
+         aOptions.myJSON ? &aGluer.Profile() : NULL, &aFigures);
+}
+//=======================================================================
+//function : BenchGetInPlace
+//purpose  : searches each solid of the model in the model
+//=======================================================================
+void BenchGetInPlace(const GEOMBench_Options& aOptions,
+                     const Standard_CString aModel,
+                     const Standard_Integer aN,
+                     const TopoDS_Shape& aS)
+{
+  Standard_Integer aNbNotFound;
+  OSD_Timer aTimer;
+  TopoDS_Iterator aIt;
+  TopTools_ListOfShape aLWhat, aLResults;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  GEOMAlgo_GetInPlace aGIP;
+  //
+  aIt.Initialize(aS);
+  for (; aIt.More(); aIt.Next()) {
+    aLWhat.Append(aIt.Value());
+  }
+  //
+  aGIP.SetShapeWhere(aS);
+  aGIP.SetTolerance(THE_TOLERANCE);
+  aGIP.SetRunParallel(aOptions.myRunParallel);
+  aGIP.SetUseOBB(aOptions.myUseOBB);
+  aGIP.SetProfiling(aOptions.myJSON);
+  //
+  aTimer.Start();
+  aGIP.PerformList(aLWhat, aLResults);
+  aTimer.Stop();
+  //
+  aNbNotFound=0;
+  aItLS.Initialize(aLResults);
+  for (; aItLS.More(); aItLS.Next()) {
+    if (aItLS.Value().IsNull()) {
+      ++aNbNotFound;
+    }
+  }
+  //
+  Report(aOptions, "GetInPlace", aModel, aN, aS, aTimer.ElapsedTime(),
+         aGIP.ErrorStatus() ? aGIP.ErrorStatus() : aNbNotFound,
+         &aGIP.Profile());
+}
+//=======================================================================
+//function : BenchGlueDetectorOBB
+//purpose  : detects the coincident shapes without and with the
+//           oriented boxes; the figures are the candidate pairs of
+//           edges and faces left by the axis-aligned boxes, the ones
+//           left by the oriented boxes (i.e. tested), the times of
+//           both modes and the speedup
+//=======================================================================
+void BenchGlueDetectorOBB(const GEOMBench_Options& aOptions,
+                          const Standard_CString aModel,
+                          const Standard_Integer aN,
+                          const TopoDS_Shape& aS)
+{
+  Standard_Boolean bUseOBB;
+  Standard_Integer i, iErr;
+  Standard_Real aTimes[2];
+  Standard_Size aNbCandidates, aNbTested;
+  OSD_Timer aTimer;
+  GEOMBench_Figures aFigures;
+  //
+  iErr=0;
+  aNbCandidates=0;
+  aNbTested=0;
+  for (i=0; i<2; ++i) {
+    GEOMAlgo_GlueDetector aGD;
+    //
+    bUseOBB=(i==1);
+    aGD.SetArgument(aS);
+    aGD.SetTolerance(THE_TOLERANCE);
+    aGD.SetRunParallel(aOptions.myRunParallel);
+    aGD.SetUseOBB(bUseOBB);
+    aGD.SetProfiling(Standard_True);
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    aGD.Perform();
+    aTimer.Stop();
+    aTimes[i]=aTimer.ElapsedTime();
+    //
+    iErr=Max(iErr, aGD.ErrorStatus());
+    if (bUseOBB) {
+      const GEOMAlgo_Profile& aProfile=aGD.Profile();
+      aNbCandidates=aProfile.Count("EdgeSDCandidates")+
+        aProfile.Count("FaceSDCandidates");
+      aNbTested=aProfile.Count("EdgeSDTested")+
+        aProfile.Count("FaceSDTested");
+    }
+  }
+  //
+  aFigures.Add("aabb_candidates", (Standard_Real)aNbCandidates);
+  aFigures.Add("obb_survivors", (Standard_Real)aNbTested);
+  aFigures.Add("time_aabb", aTimes[0]);
+  aFigures.Add("time_obb", aTimes[1]);
+  aFigures.Add("speedup", (aTimes[1]>0.) ? aTimes[0]/aTimes[1] : 0.);
+  //
+  Report(aOptions, "GlueDetectorOBB", aModel, aN, aS, aTimes[1], iErr,
+         NULL, &aFigures);
+}
+//=======================================================================
+//function : BenchGetInPlaceOBB
+//purpose  : searches each solid of the model in the model without
+//           and with the oriented boxes; the figures are the same as
+//           the ones of BenchGlueDetectorOBB
+//=======================================================================
+void BenchGetInPlaceOBB(const GEOMBench_Options& aOptions,
+                        const Standard_CString aModel,
+                        const Standard_Integer aN,
+                        const TopoDS_Shape& aS)
+{
+  Standard_Boolean bUseOBB;
+  Standard_Integer i, iErr;
+  Standard_Real aTimes[2];
+  Standard_Size aNbCandidates, aNbPairs;
+  OSD_Timer aTimer;
+  TopoDS_Iterator aIt;
+  TopTools_ListOfShape aLWhat;
+  GEOMBench_Figures aFigures;
+  //
+  aIt.Initialize(aS);
+  for (; aIt.More(); aIt.Next()) {
+    aLWhat.Append(aIt.Value());
+  }
+  //
+  iErr=0;
+  aNbCandidates=0;
+  aNbPairs=0;
+  for (i=0; i<2; ++i) {
+    TopTools_ListOfShape aLResults;
+    GEOMAlgo_GetInPlace aGIP;
+    //
+    bUseOBB=(i==1);
+    aGIP.SetShapeWhere(aS);
+    aGIP.SetTolerance(THE_TOLERANCE);
+    aGIP.SetRunParallel(aOptions.myRunParallel);
+    aGIP.SetUseOBB(bUseOBB);
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    aGIP.PerformList(aLWhat, aLResults);
+    aTimer.Stop();
+    aTimes[i]=aTimer.ElapsedTime();
+    //
+    iErr=Max(iErr, aGIP.ErrorStatus());
+    if (bUseOBB) {
+      aNbCandidates=aGIP.NbCandidates();
+      aNbPairs=aGIP.NbPairs();
+    }
+  }
+  //
+  aFigures.Add("aabb_candidates", (Standard_Real)aNbCandidates);
+  aFigures.Add("obb_survivors", (Standard_Real)aNbPairs);
+  aFigures.Add("time_aabb", aTimes[0]);
+  aFigures.Add("time_obb", aTimes[1]);
+  aFigures.Add("speedup", (aTimes[1]>0.) ? aTimes[0]/aTimes[1] : 0.);
+  //
+  Report(aOptions, "GetInPlaceOBB", aModel, aN, aS, aTimes[1], iErr,
+         NULL, &aFigures);
+}
+//=======================================================================
+//function : BenchFinderShapeOn2
+//purpose  : finds the faces of the model inside the box of its half
+//=======================================================================
+void BenchFinderShapeOn2(const GEOMBench_Options& aOptions,
+                         const Standard_CString aModel,
+                         const Standard_Integer aN,
+                         const TopoDS_Shape& aS)
+{
+  Standard_Real aXMin, aYMin, aZMin, aXMax, aYMax, aZMax;
+  OSD_Timer aTimer;
+  Bnd_Box aBox;
+  GEOMAlgo_FinderShapeOn2 aFinder;
+  Handle(GEOMAlgo_ClsfBox) aClsf=new GEOMAlgo_ClsfBox;
+  //
+  BRepBndLib::Add(aS, aBox);
+  aBox.Get(aXMin, aYMin, aZMin, aXMax, aYMax, aZMax);
+  BRepPrimAPI_MakeBox aMB(gp_Pnt(aXMin-1., aYMin-1., aZMin-1.),
+                          gp_Pnt(0.5*(aXMin+aXMax), aYMax+1., aZMax+1.));
+  aClsf->SetBox(aMB.Shape());
+  //
+  aFinder.SetShape(aS);
+  aFinder.SetTolerance(THE_TOLERANCE);
+  aFinder.SetClsf(aClsf);
+  aFinder.SetShapeType(TopAbs_FACE);
+  aFinder.SetState(GEOMAlgo_ST_IN);
+  aFinder.SetNbPntsMin(3);
+  aFinder.SetNbPntsMax(100);
+  aFinder.SetRunParallel(aOptions.myRunParallel);
+  aFinder.SetProfiling(aOptions.myJSON);
+  //
+  aTimer.Start();
+  aFinder.Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "FinderShapeOn2", aModel, aN, aS, aTimer.ElapsedTime(),
+         aFinder.ErrorStatus(), &aFinder.Profile());
+}
+//=======================================================================
+//function : BenchShapeInfoFiller
+//purpose  :
+//=======================================================================
+void BenchShapeInfoFiller(const GEOMBench_Options& aOptions,
+                          const Standard_CString aModel,
+                          const Standard_Integer aN,
+                          const TopoDS_Shape& aS)
+{
+  OSD_Timer aTimer;
+  GEOMAlgo_ShapeInfoFiller aSIF;
+  //
+  aSIF.SetShape(aS);
+  aSIF.SetTolerance(THE_TOLERANCE);
+  aSIF.SetRunParallel(aOptions.myRunParallel);
+  aSIF.SetProfiling(aOptions.myJSON);
+  //
+  aTimer.Start();
+  aSIF.Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "ShapeInfoFiller", aModel, aN, aS, aTimer.ElapsedTime(),
+         aSIF.ErrorStatus(), &aSIF.Profile());
+}
+//=======================================================================
+//function : BenchExtractor
+//purpose  : removes the first face of each solid of the model
+//=======================================================================
+void BenchExtractor(const GEOMBench_Options& aOptions,
+                    const Standard_CString aModel,
+                    const Standard_Integer aN,
+                    const TopoDS_Shape& aS)
+{
+  OSD_Timer aTimer;
+  TopExp_Explorer aExp, aExpF;
+  TopTools_ListOfShape aLS;
+  GEOMAlgo_Extractor aExtractor;
+  //
+  aExp.Init(aS, TopAbs_SOLID);
+  for (; aExp.More(); aExp.Next()) {
+    aExpF.Init(aExp.Current(), TopAbs_FACE);
+    if (aExpF.More()) {
+      aLS.Append(aExpF.Current());
+    }
+  }
+  //
+  aExtractor.SetShape(aS);
+  aExtractor.SetShapesToRemove(aLS);
+  aExtractor.SetRunParallel(aOptions.myRunParallel);
+  //
+  aTimer.Start();
+  aExtractor.Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "Extractor", aModel, aN, aS, aTimer.ElapsedTime(),
+         aExtractor.ErrorStatus(), NULL);
+}
+//=======================================================================
+//function : BenchSplitter
+//purpose  : splits the model by the box crossing its middle
+//=======================================================================
+void BenchSplitter(const GEOMBench_Options& aOptions,
+                   const Standard_CString aModel,
+                   const Standard_Integer aN,
+                   const TopoDS_Shape& aS)
+{
+  Standard_Real aXMin, aYMin, aZMin, aXMax, aYMax, aZMax;
+  OSD_Timer aTimer;
+  Bnd_Box aBox;
+  GEOMAlgo_Splitter aSplitter;
+  //
+  BRepBndLib::Add(aS, aBox);
+  aBox.Get(aXMin, aYMin, aZMin, aXMax, aYMax, aZMax);
+  BRepPrimAPI_MakeBox aMB(gp_Pnt(0.3*aXMin+0.7*aXMax, aYMin-1., aZMin-1.),
+                          gp_Pnt(aXMax+1., aYMax+1., aZMax+1.));
+  //
+  aSplitter.AddArgument(aS);
+  aSplitter.AddTool(aMB.Shape());
+  aSplitter.SetLimit(TopAbs_SOLID);
+  aSplitter.SetRunParallel(aOptions.myRunParallel);
+  //
+  aTimer.Start();
+  aSplitter.Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "Splitter", aModel, aN, aS, aTimer.ElapsedTime(),
+         aSplitter.HasErrors() ? 1 : 0, NULL);
+}
+//=======================================================================
+//function : BenchBlockFix
+//purpose  :
+//=======================================================================
+void BenchBlockFix(const GEOMBench_Options& aOptions,
+                   const Standard_CString aModel,
+                   const Standard_Integer aN,
+                   const TopoDS_Shape& aS)
+{
+  OSD_Timer aTimer;
+  Handle(BlockFix_BlockFixAPI) aTool=new BlockFix_BlockFixAPI;
+  //
+  aTool->SetShape(aS);
+  aTool->Tolerance()=THE_TOLERANCE;
+  aTool->RunParallel()=aOptions.myRunParallel;
+  //
+  aTimer.Start();
+  aTool->Perform();
+  aTimer.Stop();
+  //
+  Report(aOptions, "BlockFix", aModel, aN, aS, aTimer.ElapsedTime(),
+         aTool->Shape().IsNull() ? 1 : 0, NULL);
+}
+//=======================================================================
+//function : BenchPassKey
+//purpose  : fills the map by the pass keys of the edges (by their
+//           vertices) and of the faces (by their edges) of the model
+//           and looks all the keys up; the lookups are timed.
+//           The figures are the lookup throughput, the number of the
+//           keys sharing the full hash code with another key and the
+//           lengths of the chains of the buckets of the map
+//=======================================================================
+void BenchPassKey(const GEOMBench_Options& aOptions,
+                  const Standard_CString aModel,
+                  const Standard_Integer aN,
+                  const TopoDS_Shape& aS)
+{
+  Standard_Integer i, j, aNbE, aNbF, aNbK, aNbRepeat, aNbFound, aNbB;
+  Standard_Integer aIB, aNbChains, aMaxChain, aNbCollisions;
+  Standard_Real aTime;
+  OSD_Timer aTimer;
+  TopoDS_Vertex aV1, aV2;
+  TopExp_Explorer aExp;
+  TopTools_IndexedMapOfShape aME, aMF;
+  TopTools_ListOfShape aLE;
+  std::vector<GEOMAlgo_PassKeyShape> aVK;
+  std::vector<size_t> aVH;
+  std::vector<Standard_Integer> aVChain;
+  GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape aMPKLS;
+  GEOMBench_Figures aFigures;
+  //
+  TopExp::MapShapes(aS, TopAbs_EDGE, aME);
+  TopExp::MapShapes(aS, TopAbs_FACE, aMF);
+  aNbE=aME.Extent();
+  aNbF=aMF.Extent();
+  //
+  aVK.resize(aNbE+aNbF);
+  for (i=1; i<=aNbE; ++i) {
+    const TopoDS_Edge& aE=TopoDS::Edge(aME(i));
+    TopExp::Vertices(aE, aV1, aV2);
+    aVK[i-1].SetShapes(aV1, aV2);
+  }
+  for (i=1; i<=aNbF; ++i) {
+    aLE.Clear();
+    aExp.Init(aMF(i), TopAbs_EDGE);
+    for (; aExp.More(); aExp.Next()) {
+      aLE.Append(aExp.Current());
+    }
+    aVK[aNbE+i-1].SetShapes(aLE);
+  }
+  //
+  aNbK=aNbE+aNbF;
+  for (i=0; i<aNbK; ++i) {
+    const TopoDS_Shape& aSK=(i<aNbE) ? aME(i+1) : aMF(i-aNbE+1);
+    j=aMPKLS.FindIndex(aVK[i]);
+    if (!j) {
+      j=aMPKLS.Add(aVK[i], TopTools_ListOfShape());
+    }
+    aMPKLS.ChangeFromIndex(j).Append(aSK);
+  }
+  //
+  // about one million lookups for each model
+  aNbRepeat=Max(1, 1000000/Max(1, aNbK));
+  aNbFound=0;
+  aTimer.Start();
+  for (j=0; j<aNbRepeat; ++j) {
+    for (i=0; i<aNbK; ++i) {
+      if (aMPKLS.FindIndex(aVK[i])) {
+        ++aNbFound;
+      }
+    }
+  }
+  aTimer.Stop();
+  aTime=aTimer.ElapsedTime();
+  //
+  // the keys with the same full hash code
+  aVH.resize(aMPKLS.Extent());
+  for (i=1; i<=aMPKLS.Extent(); ++i) {
+    aVH[i-1]=aMPKLS.FindKey(i).GetSum();
+  }
+  std::sort(aVH.begin(), aVH.end());
+  aNbCollisions=
+    (Standard_Integer)(aVH.end()-std::unique(aVH.begin(), aVH.end()));
+  //
+  // the chains of the buckets of the map
+  aNbB=aMPKLS.NbBuckets();
+  aVChain.assign(aNbB+1, 0);
+  for (i=1; i<=aMPKLS.Extent(); ++i) {
+#if OCC_VERSION_LARGE < 0x07080000
+    aIB=GEOMAlgo_PassKeyShapeMapHasher::HashCode(aMPKLS.FindKey(i), aNbB);
+#else
+    aIB=(Standard_Integer)
+      (GEOMAlgo_PassKeyShapeMapHasher()(aMPKLS.FindKey(i))%aNbB);
+#endif
+    ++aVChain[aIB];
+  }
+  aNbChains=0;
+  aMaxChain=0;
+  for (i=0; i<=aNbB; ++i) {
+    if (aVChain[i]) {
+      ++aNbChains;
+      aMaxChain=Max(aMaxChain, aVChain[i]);
+    }
+  }
+  //
+  aFigures.Add("keys", aMPKLS.Extent());
+  aFigures.Add("lookups", (Standard_Real)aNbRepeat*aNbK);
+  aFigures.Add("lookups_per_s",
+               (aTime>0.) ? (Standard_Real)aNbRepeat*aNbK/aTime : 0.);
+  aFigures.Add("hash_collisions", aNbCollisions);
+  aFigures.Add("buckets", aNbB);
+  aFigures.Add("mean_chain",
+               aNbChains ? (Standard_Real)aMPKLS.Extent()/aNbChains : 0.);
+  aFigures.Add("max_chain", aMaxChain);
+  //
+  Report(aOptions, "PassKey", aModel, aN, aS, aTime,
+         (aNbFound==aNbRepeat*aNbK) ? 0 : 1, NULL, &aFigures);
+}
+//=======================================================================
+//function : BenchTopologyIndex
+//purpose  : builds the topology index of the model and checks its
+//           tables of the ancestors against
+//           TopExp::MapShapesAndAncestors(); only the building is
+//           timed, the error is -1 if a table differs
+//=======================================================================
+void BenchTopologyIndex(const GEOMBench_Options& aOptions,
+                        const Standard_CString aModel,
+                        const Standard_Integer aN,
+                        const TopoDS_Shape& aS)
+{
+  Standard_Integer aNbMismatches;
+  OSD_Timer aTimer;
+  GEOMBench_Figures aFigures;
+  Handle(GEOMAlgo_TopologyIndex) aTI=new GEOMAlgo_TopologyIndex;
+  //
+  aTimer.Start();
+  aTI->Init(aS);
+  aTimer.Stop();
+  //
+  aNbMismatches=
+    CheckTopologyTable(aTI, GEOMAlgo_TopologyIndex::T_VertexEdges,
+                       TopAbs_VERTEX, TopAbs_EDGE)+
+    CheckTopologyTable(aTI, GEOMAlgo_TopologyIndex::T_EdgeFaces,
+                       TopAbs_EDGE, TopAbs_FACE)+
+    CheckTopologyTable(aTI, GEOMAlgo_TopologyIndex::T_FaceSolids,
+                       TopAbs_FACE, TopAbs_SOLID);
+  if (aNbMismatches) {
+    std::cerr << "TopologyIndex: " << aModel << " " << aN << ": "
+              << aNbMismatches << " shapes have the wrong ancestors"
+              << std::endl;
+  }
+  //
+  aFigures.Add("mismatches", aNbMismatches);
+  //
+  Report(aOptions, "TopologyIndex", aModel, aN, aS, aTimer.ElapsedTime(),
+         aNbMismatches ? -1 : 0, NULL, &aFigures);
+}
+//=======================================================================
+//function : CheckTopologyTable
+//purpose  : returns the number of the sub-shapes of the type theType
+//           which ancestors of the type theTypeA in the table theTable
+//           differ from the ones of TopExp::MapShapesAndAncestors()
+//           (taken once each and in the ascending order)
+//=======================================================================
+Standard_Integer CheckTopologyTable(const Handle(GEOMAlgo_TopologyIndex)& aTI,
+                                    const GEOMAlgo_TopologyIndex::Table aTable,
+                                    const TopAbs_ShapeEnum aType,
+                                    const TopAbs_ShapeEnum aTypeA)
+{
+  Standard_Integer i, k, aNb, aNbMismatches;
+  TopTools_IndexedDataMapOfShapeListOfShape aMSA;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  //
+  const TopTools_IndexedMapOfShape& aMS=aTI->Shapes(aType);
+  const TopTools_IndexedMapOfShape& aMA=aTI->Shapes(aTypeA);
+  TopExp::MapShapesAndAncestors(aTI->Shape(), aType, aTypeA, aMSA);
+  //
+  aNbMismatches=0;
+  aNb=aMS.Extent();
+  for (i=1; i<=aNb; ++i) {
+    std::vector<Standard_Integer> aV1, aV2;
+    //
+    const TopTools_ListOfShape* pLA=aMSA.Seek(aMS(i));
+    if (pLA) {
+      aItLS.Initialize(*pLA);
+      for (; aItLS.More(); aItLS.Next()) {
+        aV1.push_back(aMA.FindIndex(aItLS.Value()));
+      }
+      std::sort(aV1.begin(), aV1.end());
+      aV1.erase(std::unique(aV1.begin(), aV1.end()), aV1.end());
+    }
+    //
+    for (k=1; k<=aTI->NbIds(aTable, i); ++k) {
+      aV2.push_back(aTI->Id(aTable, i, k));
+    }
+    if (aV1!=aV2) {
+      ++aNbMismatches;
+    }
+  }
+  return aNbMismatches;
+}
+//=======================================================================
+//function : Report
+//purpose  :
+//=======================================================================
+void Report(const GEOMBench_Options& aOptions,
+            const Standard_CString aAlgo,
+            const Standard_CString aModel,
+            const Standard_Integer aN,
+            const TopoDS_Shape& aS,
+            const Standard_Real aTime,
+            const Standard_Integer iErr,
+            const GEOMAlgo_Profile* pProfile,
+            const GEOMBench_Figures* pFigures)
+{
+  Standard_Integer i, aNbF;
+  //
+  aNbF=GEOMBench_Models::NbShapes(aS, TopAbs_FACE);
+  if (!aOptions.myJSON) {
+    std::cout << aAlgo << "," << aModel << "," << aN << "," << aNbF << ","
+              << aTime << "," << iErr << ",";
+    if (pFigures) {
+      for (i=1; i<=pFigures->Extent(); ++i) {
+        std::cout << (i>1 ? ";" : "") << pFigures->FindKey(i).ToCString()
+                  << "=" << pFigures->FindFromIndex(i);
+      }
+    }
+    std::cout << std::endl;
+    return;
+  }
+  //
+  std::cout << "{\"algo\": \"" << aAlgo << "\", \"model\": \"" << aModel
+            << "\", \"size\": " << aN << ", \"faces\": " << aNbF
+            << ", \"time\": " << aTime << ", \"error\": " << iErr;
+  if (pFigures) {
+    std::cout << ", \"figures\": {";
+    for (i=1; i<=pFigures->Extent(); ++i) {
+      std::cout << (i>1 ? ", " : "") << "\""
+                << pFigures->FindKey(i).ToCString() << "\": "
+                << pFigures->FindFromIndex(i);
+    }
+    std::cout << "}";
+  }
+  if (pProfile) {
+    std::cout << ", \"profile\": ";
+    pProfile->DumpJSON(std::cout);
+  }
+  std::cout << "}" << std::endl;
+}
@@ -0,0 +1,170 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMBench_Models.cxx
+
+#include <GEOMBench_Models.hxx>
+
+#include <gp_Ax1.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <BRep_Builder.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+
+//=======================================================================
+//function : Translated
+//purpose  : returns the shape moved by the vector, the shapes of
+//           a model share the geometry of one primitive
+//=======================================================================
+static
+  TopoDS_Shape Translated(const TopoDS_Shape& aS,
+                          const gp_Vec& aV)
+{
+  gp_Trsf aTrsf;
+  //
+  aTrsf.SetTranslation(aV);
+  return aS.Moved(TopLoc_Location(aTrsf));
+}
+//=======================================================================
+//function : BoxGrid
+//purpose  :
+//=======================================================================
+TopoDS_Shape GEOMBench_Models::BoxGrid(const Standard_Integer aNX,
+                                       const Standard_Integer aNY,
+                                       const Standard_Integer aNZ,
+                                       const Standard_Real aSize)
+{
+  Standard_Integer i, j, k;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  //
+  // each box is built separately: the boxes share nothing
+  for (i=0; i<aNX; ++i) {
+    for (j=0; j<aNY; ++j) {
+      for (k=0; k<aNZ; ++k) {
+        gp_Pnt aP(i*aSize, j*aSize, k*aSize);
+        BRepPrimAPI_MakeBox aMB(aP, aSize, aSize, aSize);
+        aBB.Add(aC, aMB.Shape());
+      }
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : CylinderArray
+//purpose  :
+//=======================================================================
+TopoDS_Shape GEOMBench_Models::CylinderArray(const Standard_Integer aNX,
+                                             const Standard_Integer aNY,
+                                             const Standard_Real aR,
+                                             const Standard_Real aH)
+{
+  Standard_Integer i, j;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  //
+  for (i=0; i<aNX; ++i) {
+    for (j=0; j<aNY; ++j) {
+      gp_Ax2 aAx(gp_Pnt(2.*i*aR, 2.*j*aR, 0.), gp_Dir(0., 0., 1.));
+      BRepPrimAPI_MakeCylinder aMC(aAx, aR, aH);
+      aBB.Add(aC, aMC.Shape());
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : SpherePack
+//purpose  :
+//=======================================================================
+TopoDS_Shape GEOMBench_Models::SpherePack(const Standard_Integer aN,
+                                          const Standard_Real aR)
+{
+  Standard_Integer i, j, k;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  //
+  BRepPrimAPI_MakeSphere aMS(gp_Pnt(0., 0., 0.), aR);
+  const TopoDS_Shape& aS=aMS.Shape();
+  for (i=0; i<aN; ++i) {
+    for (j=0; j<aN; ++j) {
+      for (k=0; k<aN; ++k) {
+        aBB.Add(aC, Translated(aS, gp_Vec(2.*i*aR, 2.*j*aR, 2.*k*aR)));
+      }
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : RotatedPlates
+//purpose  :
+//=======================================================================
+TopoDS_Shape GEOMBench_Models::RotatedPlates(const Standard_Integer aN,
+                                             const Standard_Real aSize,
+                                             const Standard_Real aT)
+{
+  Standard_Integer i;
+  gp_Trsf aTrsf;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  //
+  aTrsf.SetRotation(gp_Ax1(gp_Pnt(0., 0., 0.), gp_Dir(0., 0., 1.)),
+                    M_PI/4.);
+  TopLoc_Location aLoc(aTrsf);
+  //
+  for (i=0; i<aN; ++i) {
+    BRepPrimAPI_MakeBox aMB(gp_Pnt(0., 2.*i*aT, 0.), aSize, aT, aSize);
+    aBB.Add(aC, aMB.Shape().Moved(aLoc));
+  }
+  return aC;
+}
+//=======================================================================
+//function : NbShapes
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMBench_Models::NbShapes(const TopoDS_Shape& aS,
+                                            const TopAbs_ShapeEnum aType)
+{
+  TopTools_IndexedMapOfShape aM;
+  //
+  TopExp::MapShapes(aS, aType, aM);
+  return aM.Extent();
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// File:        GEOMBench_Models.hxx
+
+#ifndef _GEOMBench_Models_HeaderFile
+#define _GEOMBench_Models_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+
+#include <TopoDS_Shape.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+//=======================================================================
+//namespace : GEOMBench_Models
+//purpose   : Parametrised synthetic models built of OCCT primitives
+//            for the benchmarks. The models are compounds of separate
+//            solids, so that they are not glued yet.
+//=======================================================================
+namespace GEOMBench_Models
+{
+  //! Returns theNX x theNY x theNZ boxes of the size theSize
+  //!          touching each other by the faces. <br>
+  TopoDS_Shape BoxGrid(const Standard_Integer theNX,
+                       const Standard_Integer theNY,
+                       const Standard_Integer theNZ,
+                       const Standard_Real theSize);
+
+  //! Returns theNX x theNY vertical cylinders of the radius
+  //!          theRadius and the height theHeight, each one tangent
+  //!          to its neighbours. <br>
+  TopoDS_Shape CylinderArray(const Standard_Integer theNX,
+                             const Standard_Integer theNY,
+                             const Standard_Real theRadius,
+                             const Standard_Real theHeight);
+
+  //! Returns theN x theN x theN spheres of the radius theRadius
+  //!          in the cubic packing, each one tangent to its
+  //!          neighbours. <br>
+  TopoDS_Shape SpherePack(const Standard_Integer theN,
+                          const Standard_Real theRadius);
+
+  //! Returns theN parallel thin plates (theSize x theThickness x
+  //!          theSize) separated by theThickness and rotated by 45
+  //!          degrees around Z. <br>
+  //!          The axis-aligned boxes of the plates overlap much,
+  //!          their oriented boxes do not (see
+  //!          GEOMAlgo_GluerAlgo::SetUseOBB()). <br>
+  TopoDS_Shape RotatedPlates(const Standard_Integer theN,
+                             const Standard_Real theSize,
+                             const Standard_Real theThickness);
+
+  //! Returns the number of the sub-shapes of the type theType. <br>
+  Standard_Integer NbShapes(const TopoDS_Shape& theShape,
+                            const TopAbs_ShapeEnum theType);
+}
+
+#endif